@@ -0,0 +1,136 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "memory-pool.hpp"
+
+#include <algorithm>
+
+namespace nfd {
+
+/** \brief rounds a requested size up to a block size suitably aligned for any object type
+ */
+static inline size_t
+computeBlockSize(size_t size, size_t minSize)
+{
+  union MaxAlign
+  {
+    long double ld;
+    long long ll;
+    void* p;
+    void (*fp)();
+  };
+  const size_t align = alignof(MaxAlign);
+  return (std::max(size, minSize) + align - 1) / align * align;
+}
+
+MemoryPool::MemoryPool(size_t nBlocksPerChunk)
+  : m_nBlocksPerChunk(nBlocksPerChunk)
+  , m_blockSize(0)
+  , m_nInUse(0)
+  , m_nFree(0)
+  , m_freeList(nullptr)
+{
+  BOOST_ASSERT(m_nBlocksPerChunk > 0);
+}
+
+MemoryPool::~MemoryPool()
+{
+  BOOST_ASSERT(m_nInUse == 0);
+  for (char* chunk : m_chunks) {
+    ::operator delete(chunk);
+  }
+}
+
+bool
+MemoryPool::canAllocate(size_t size) const
+{
+  if (m_blockSize == 0) {
+    return true;
+  }
+
+  // blocks are rounded up for alignment, so compare against the rounded size
+  return computeBlockSize(size, sizeof(FreeBlock)) == m_blockSize;
+}
+
+void*
+MemoryPool::allocate(size_t size)
+{
+  BOOST_ASSERT(this->canAllocate(size));
+
+  if (m_blockSize == 0) {
+    m_blockSize = computeBlockSize(size, sizeof(FreeBlock));
+  }
+
+  if (m_freeList == nullptr) {
+    this->allocateChunk();
+  }
+
+  FreeBlock* block = m_freeList;
+  m_freeList = block->next;
+  --m_nFree;
+  ++m_nInUse;
+  return block;
+}
+
+void
+MemoryPool::deallocate(void* block)
+{
+  BOOST_ASSERT(block != nullptr);
+  BOOST_ASSERT(m_nInUse > 0);
+
+  FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+  freeBlock->next = m_freeList;
+  m_freeList = freeBlock;
+  ++m_nFree;
+  --m_nInUse;
+}
+
+MemoryPool::Occupancy
+MemoryPool::getOccupancy() const
+{
+  Occupancy occupancy;
+  occupancy.blockSize = m_blockSize;
+  occupancy.nInUse = m_nInUse;
+  occupancy.nFree = m_nFree;
+  occupancy.nChunks = m_chunks.size();
+  return occupancy;
+}
+
+void
+MemoryPool::allocateChunk()
+{
+  char* chunk = static_cast<char*>(::operator new(m_blockSize * m_nBlocksPerChunk));
+  m_chunks.push_back(chunk);
+
+  // thread blocks into the free list in address order
+  for (size_t i = m_nBlocksPerChunk; i > 0; --i) {
+    FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * m_blockSize);
+    block->next = m_freeList;
+    m_freeList = block;
+  }
+  m_nFree += m_nBlocksPerChunk;
+}
+
+} // namespace nfd
@@ -0,0 +1,183 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_MEMORY_POOL_HPP
+#define NFD_CORE_MEMORY_POOL_HPP
+
+#include "common.hpp"
+
+namespace nfd {
+
+/** \brief a pool of fixed-size memory blocks
+ *
+ *  Blocks are carved from chunks, each holding a number of blocks. Released blocks are kept
+ *  in a free list and reused by later allocations; chunks are returned to the system only
+ *  when the pool is destroyed.
+ *
+ *  The block size is determined by the first allocation. Later requests of a different size
+ *  are not served by the pool, and the caller must fall back to the global allocator.
+ */
+class MemoryPool : noncopyable
+{
+public:
+  /** \brief occupancy of a pool
+   */
+  struct Occupancy
+  {
+    /// size of each block, or 0 if the pool has not been used
+    size_t blockSize;
+    /// number of blocks handed out and not yet released
+    size_t nInUse;
+    /// number of blocks available for reuse without allocating a new chunk
+    size_t nFree;
+    /// number of chunks obtained from the system
+    size_t nChunks;
+  };
+
+  explicit
+  MemoryPool(size_t nBlocksPerChunk = 256);
+
+  ~MemoryPool();
+
+  /** \return whether a request of \p size bytes can be served by this pool
+   *  \note This returns true for any size before the first allocation.
+   */
+  bool
+  canAllocate(size_t size) const;
+
+  /** \brief allocate one block of \p size bytes
+   *  \pre canAllocate(size)
+   */
+  void*
+  allocate(size_t size);
+
+  /** \brief release a block obtained from allocate()
+   */
+  void
+  deallocate(void* block);
+
+  Occupancy
+  getOccupancy() const;
+
+private:
+  void
+  allocateChunk();
+
+private:
+  struct FreeBlock
+  {
+    FreeBlock* next;
+  };
+
+  size_t m_nBlocksPerChunk;
+  size_t m_blockSize;
+  size_t m_nInUse;
+  size_t m_nFree;
+  FreeBlock* m_freeList;
+  std::vector<char*> m_chunks;
+};
+
+/** \brief a stateful allocator that obtains single objects from a MemoryPool
+ *
+ *  PoolAllocator is intended to be passed to std::allocate_shared, so that the object
+ *  and its control block occupy one pool block. The allocator shares ownership of the pool,
+ *  so that objects may safely outlive the table that created them.
+ *
+ *  Array allocations and requests that do not match the pool block size are forwarded
+ *  to the global operator new.
+ */
+template<typename T>
+class PoolAllocator
+{
+public:
+  typedef T value_type;
+
+  explicit
+  PoolAllocator(shared_ptr<MemoryPool> pool)
+    : m_pool(std::move(pool))
+  {
+    BOOST_ASSERT(m_pool != nullptr);
+  }
+
+  template<typename U>
+  PoolAllocator(const PoolAllocator<U>& other)
+    : m_pool(other.getPool())
+  {
+  }
+
+  T*
+  allocate(size_t n)
+  {
+    if (n == 1 && m_pool->canAllocate(sizeof(T))) {
+      return static_cast<T*>(m_pool->allocate(sizeof(T)));
+    }
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+
+  void
+  deallocate(T* p, size_t n)
+  {
+    // block size is fixed after the first allocation, so this reproduces the decision in allocate
+    if (n == 1 && m_pool->canAllocate(sizeof(T))) {
+      m_pool->deallocate(p);
+    }
+    else {
+      ::operator delete(p);
+    }
+  }
+
+  const shared_ptr<MemoryPool>&
+  getPool() const
+  {
+    return m_pool;
+  }
+
+  template<typename U>
+  struct rebind
+  {
+    typedef PoolAllocator<U> other;
+  };
+
+private:
+  shared_ptr<MemoryPool> m_pool;
+};
+
+template<typename T, typename U>
+inline bool
+operator==(const PoolAllocator<T>& a, const PoolAllocator<U>& b)
+{
+  return a.getPool() == b.getPool();
+}
+
+template<typename T, typename U>
+inline bool
+operator!=(const PoolAllocator<T>& a, const PoolAllocator<U>& b)
+{
+  return a.getPool() != b.getPool();
+}
+
+} // namespace nfd
+
+#endif // NFD_CORE_MEMORY_POOL_HPP
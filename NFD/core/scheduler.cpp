@@ -46,19 +46,44 @@ struct EventMemberImplObjTraits<std::function<void()>> {
 namespace nfd {
 namespace scheduler {
 
+EventInfo::~EventInfo()
+{
+}
+
+/** \brief an event scheduled directly in ns-3 event queue
+ */
+class Ns3EventInfo : public EventInfo
+{
+public:
+  explicit
+  Ns3EventInfo(const ns3::EventId& id)
+    : m_id(id)
+  {
+  }
+
+  virtual void
+  cancel() DECL_OVERRIDE
+  {
+    ns3::Simulator::Remove(m_id);
+  }
+
+private:
+  ns3::EventId m_id;
+};
+
 EventId
 schedule(const time::nanoseconds& after, const std::function<void()>& event)
 {
   ns3::EventId id = ns3::Simulator::Schedule(ns3::NanoSeconds(after.count()),
                                              &std::function<void()>::operator(), event);
-  return std::make_shared<ns3::EventId>(id);
+  return std::make_shared<Ns3EventInfo>(id);
 }
 
 void
 cancel(const EventId& eventId)
 {
   if (eventId != nullptr) {
-    ns3::Simulator::Remove(*eventId);
+    eventId->cancel();
     const_cast<EventId&>(eventId).reset();
   }
 }
@@ -33,12 +33,29 @@
 namespace nfd {
 namespace scheduler {
 
+/** \brief base class of the state kept for a scheduled event
+ *
+ *  An event may be scheduled directly as an ns-3 event, or on a TimerWheel.
+ *  Each kind of event knows how to cancel itself.
+ */
+class EventInfo : noncopyable
+{
+public:
+  virtual
+  ~EventInfo();
+
+  /** \brief cancel the event, if it has not been executed or cancelled
+   */
+  virtual void
+  cancel() = 0;
+};
+
 /** \class EventId
  *  \brief Opaque type (shared_ptr) representing ID of a scheduled event
  */
-typedef std::shared_ptr<ns3::EventId> EventId;
+typedef std::shared_ptr<EventInfo> EventId;
 
-/** \brief schedule an event
+/** \brief schedule an event as an ns-3 event
  */
 EventId
 schedule(const time::nanoseconds& after, const std::function<void()>& event);
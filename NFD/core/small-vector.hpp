@@ -0,0 +1,389 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_SMALL_VECTOR_HPP
+#define NFD_CORE_SMALL_VECTOR_HPP
+
+#include "common.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+namespace nfd {
+
+/** \brief a sequence container that stores up to N elements inline
+ *
+ *  SmallVector behaves like a std::vector, except that the first N elements are stored
+ *  within the container object itself. Heap storage is only allocated when the container
+ *  grows beyond N elements.
+ *
+ *  \note As with std::vector, insertion and erasure invalidate iterators and references.
+ *  \tparam T element type, must be MoveConstructible
+ *  \tparam N number of inline elements
+ */
+template<typename T, size_t N>
+class SmallVector
+{
+public:
+  static_assert(N > 0, "SmallVector requires inline capacity of at least one element");
+
+  typedef T value_type;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T* iterator;
+  typedef const T* const_iterator;
+  typedef std::reverse_iterator<iterator> reverse_iterator;
+  typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+  typedef size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  SmallVector()
+    : m_begin(inlineBegin())
+    , m_size(0)
+    , m_capacity(N)
+  {
+  }
+
+  SmallVector(const SmallVector& other)
+    : SmallVector()
+  {
+    reserve(other.size());
+    for (const T& item : other) {
+      new (m_begin + m_size) T(item);
+      ++m_size;
+    }
+  }
+
+  SmallVector(SmallVector&& other)
+    : SmallVector()
+  {
+    this->moveFrom(other);
+  }
+
+  ~SmallVector()
+  {
+    clear();
+    releaseHeap();
+  }
+
+  SmallVector&
+  operator=(const SmallVector& other)
+  {
+    if (this != &other) {
+      clear();
+      reserve(other.size());
+      for (const T& item : other) {
+        new (m_begin + m_size) T(item);
+        ++m_size;
+      }
+    }
+    return *this;
+  }
+
+  SmallVector&
+  operator=(SmallVector&& other)
+  {
+    if (this != &other) {
+      clear();
+      releaseHeap();
+      this->moveFrom(other);
+    }
+    return *this;
+  }
+
+public: // iterators
+  iterator
+  begin()
+  {
+    return m_begin;
+  }
+
+  const_iterator
+  begin() const
+  {
+    return m_begin;
+  }
+
+  iterator
+  end()
+  {
+    return m_begin + m_size;
+  }
+
+  const_iterator
+  end() const
+  {
+    return m_begin + m_size;
+  }
+
+  reverse_iterator
+  rbegin()
+  {
+    return reverse_iterator(end());
+  }
+
+  const_reverse_iterator
+  rbegin() const
+  {
+    return const_reverse_iterator(end());
+  }
+
+  reverse_iterator
+  rend()
+  {
+    return reverse_iterator(begin());
+  }
+
+  const_reverse_iterator
+  rend() const
+  {
+    return const_reverse_iterator(begin());
+  }
+
+public: // capacity
+  size_type
+  size() const
+  {
+    return m_size;
+  }
+
+  bool
+  empty() const
+  {
+    return m_size == 0;
+  }
+
+  size_type
+  capacity() const
+  {
+    return m_capacity;
+  }
+
+  /** \return true if elements are currently stored inline
+   */
+  bool
+  isInline() const
+  {
+    return m_begin == inlineBegin();
+  }
+
+  void
+  reserve(size_type newCapacity)
+  {
+    if (newCapacity <= m_capacity) {
+      return;
+    }
+
+    T* newBegin = static_cast<T*>(::operator new(newCapacity * sizeof(T)));
+    for (size_type i = 0; i < m_size; ++i) {
+      new (newBegin + i) T(std::move(m_begin[i]));
+      m_begin[i].~T();
+    }
+    releaseHeap();
+    m_begin = newBegin;
+    m_capacity = newCapacity;
+  }
+
+public: // element access
+  reference
+  operator[](size_type i)
+  {
+    BOOST_ASSERT(i < m_size);
+    return m_begin[i];
+  }
+
+  const_reference
+  operator[](size_type i) const
+  {
+    BOOST_ASSERT(i < m_size);
+    return m_begin[i];
+  }
+
+  reference
+  at(size_type i)
+  {
+    if (i >= m_size) {
+      throw std::out_of_range("SmallVector::at");
+    }
+    return m_begin[i];
+  }
+
+  const_reference
+  at(size_type i) const
+  {
+    if (i >= m_size) {
+      throw std::out_of_range("SmallVector::at");
+    }
+    return m_begin[i];
+  }
+
+  reference
+  front()
+  {
+    BOOST_ASSERT(m_size > 0);
+    return m_begin[0];
+  }
+
+  const_reference
+  front() const
+  {
+    BOOST_ASSERT(m_size > 0);
+    return m_begin[0];
+  }
+
+  reference
+  back()
+  {
+    BOOST_ASSERT(m_size > 0);
+    return m_begin[m_size - 1];
+  }
+
+  const_reference
+  back() const
+  {
+    BOOST_ASSERT(m_size > 0);
+    return m_begin[m_size - 1];
+  }
+
+public: // modifiers
+  void
+  push_back(const T& item)
+  {
+    this->emplace_back(item);
+  }
+
+  void
+  push_back(T&& item)
+  {
+    this->emplace_back(std::move(item));
+  }
+
+  template<typename ...A>
+  reference
+  emplace_back(A&&... args)
+  {
+    if (m_size == m_capacity) {
+      // construct first, because args may refer to an existing element
+      T item(std::forward<A>(args)...);
+      reserve(m_capacity * 2);
+      new (m_begin + m_size) T(std::move(item));
+    }
+    else {
+      new (m_begin + m_size) T(std::forward<A>(args)...);
+    }
+    ++m_size;
+    return this->back();
+  }
+
+  void
+  pop_back()
+  {
+    BOOST_ASSERT(m_size > 0);
+    --m_size;
+    m_begin[m_size].~T();
+  }
+
+  /** \brief erase one element, preserving the order of remaining elements
+   *  \return iterator following the erased element
+   */
+  iterator
+  erase(const_iterator pos)
+  {
+    BOOST_ASSERT(pos >= begin() && pos < end());
+    iterator it = m_begin + (pos - m_begin);
+    std::move(it + 1, end(), it);
+    this->pop_back();
+    return it;
+  }
+
+  void
+  clear()
+  {
+    for (size_type i = 0; i < m_size; ++i) {
+      m_begin[i].~T();
+    }
+    m_size = 0;
+  }
+
+private:
+  T*
+  inlineBegin()
+  {
+    return reinterpret_cast<T*>(&m_inline);
+  }
+
+  const T*
+  inlineBegin() const
+  {
+    return reinterpret_cast<const T*>(&m_inline);
+  }
+
+  void
+  releaseHeap()
+  {
+    if (!isInline()) {
+      ::operator delete(m_begin);
+      m_begin = inlineBegin();
+      m_capacity = N;
+    }
+  }
+
+  /** \pre this container is empty and uses inline storage
+   */
+  void
+  moveFrom(SmallVector& other)
+  {
+    if (other.isInline()) {
+      for (size_type i = 0; i < other.m_size; ++i) {
+        new (m_begin + i) T(std::move(other.m_begin[i]));
+      }
+      m_size = other.m_size;
+      other.clear();
+    }
+    else {
+      m_begin = other.m_begin;
+      m_size = other.m_size;
+      m_capacity = other.m_capacity;
+      other.m_begin = other.inlineBegin();
+      other.m_size = 0;
+      other.m_capacity = N;
+    }
+  }
+
+private:
+  T* m_begin;
+  size_type m_size;
+  size_type m_capacity;
+  typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type m_inline;
+};
+
+} // namespace nfd
+
+#endif // NFD_CORE_SMALL_VECTOR_HPP
@@ -0,0 +1,403 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "timer-wheel.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+namespace nfd {
+namespace scheduler {
+
+const size_t TimerWheel::N_LEVELS;
+const size_t TimerWheel::SLOT_BITS;
+const size_t TimerWheel::N_SLOTS;
+
+static const uint64_t SLOT_MASK = TimerWheel::N_SLOTS - 1;
+static const uint64_t NO_WAKE_UP = std::numeric_limits<uint64_t>::max();
+
+/** \brief a timer on the wheel
+ *
+ *  While pending, a Timer is linked into one slot and keeps itself alive through m_self,
+ *  so that the caller is free to discard the EventId.
+ */
+class TimerWheel::Timer : public EventInfo, public TimerWheel::ListNode
+{
+public:
+  Timer(TimerWheel& wheel, uint64_t expiry, const std::function<void()>& callback)
+    : m_wheel(&wheel)
+    , m_expiry(expiry)
+    , m_callback(callback)
+    , m_level(N_LEVELS)
+    , m_isPending(true)
+  {
+  }
+
+  virtual void
+  cancel() DECL_OVERRIDE
+  {
+    if (m_wheel != nullptr && m_isPending) {
+      m_wheel->cancel(*this);
+    }
+  }
+
+public:
+  TimerWheel* m_wheel;
+  uint64_t m_expiry;
+  std::function<void()> m_callback;
+  size_t m_level; // N_LEVELS if not linked into a slot
+  size_t m_slot;
+  bool m_isPending;
+  shared_ptr<Timer> m_self;
+};
+
+TimerWheel::TimerWheel(const time::nanoseconds& tick)
+  : m_tickNs(0)
+  , m_tick(0)
+  , m_currentTick(0)
+  , m_nPending(0)
+  , m_wakeUpTick(NO_WAKE_UP)
+  , m_isAdvancing(false)
+  , m_timerPool(make_shared<MemoryPool>())
+{
+  for (size_t level = 0; level < N_LEVELS; ++level) {
+    for (size_t slot = 0; slot < N_SLOTS; ++slot) {
+      initList(m_slots[level][slot]);
+    }
+    std::fill(m_occupied[level], m_occupied[level] + N_SLOTS / 64, 0);
+  }
+
+  this->setTickInterval(tick);
+}
+
+TimerWheel::~TimerWheel()
+{
+  if (m_wakeUpTick != NO_WAKE_UP) {
+    ns3::Simulator::Cancel(m_wakeUpEvent);
+  }
+
+  // detach pending timers, so that cancelling them later is a no-op
+  for (size_t level = 0; level < N_LEVELS; ++level) {
+    for (size_t slot = 0; slot < N_SLOTS; ++slot) {
+      ListNode& head = m_slots[level][slot];
+      while (!isListEmpty(head)) {
+        Timer& timer = static_cast<Timer&>(*head.next);
+        this->unlink(timer);
+        timer.m_wheel = nullptr;
+        timer.m_isPending = false;
+        timer.m_callback = nullptr;
+        shared_ptr<Timer> self = std::move(timer.m_self);
+      }
+    }
+  }
+}
+
+void
+TimerWheel::setTickInterval(const time::nanoseconds& tick)
+{
+  if (m_nPending > 0) {
+    throw std::logic_error("cannot change tick interval while timers are pending");
+  }
+
+  if (m_wakeUpTick != NO_WAKE_UP) {
+    ns3::Simulator::Cancel(m_wakeUpEvent);
+    m_wakeUpTick = NO_WAKE_UP;
+  }
+
+  m_tick = std::max(tick, time::nanoseconds::zero());
+  m_tickNs = m_tick.count();
+  m_currentTick = this->isEnabled() ? this->getNowTick() : 0;
+}
+
+EventId
+TimerWheel::schedule(const time::nanoseconds& after, const std::function<void()>& event)
+{
+  if (!this->isEnabled()) {
+    return scheduler::schedule(after, event);
+  }
+
+  if (m_nPending == 0) {
+    // wheel was idle, skip the ticks that have passed since
+    m_currentTick = std::max(m_currentTick, this->getNowTick());
+  }
+
+  int64_t expiryNs = ns3::Simulator::Now().GetNanoSeconds() +
+                     std::max<int64_t>(after.count(), 0);
+  uint64_t expiry = static_cast<uint64_t>((expiryNs + m_tickNs - 1) / m_tickNs);
+
+  shared_ptr<Timer> timer = std::allocate_shared<Timer>(PoolAllocator<Timer>(m_timerPool),
+                                                        std::ref(*this), expiry, event);
+  timer->m_self = timer;
+  ++m_nPending;
+  this->insert(*timer);
+
+  if (!m_isAdvancing) {
+    this->scheduleWakeUp();
+  }
+  return timer;
+}
+
+void
+TimerWheel::insert(Timer& timer)
+{
+  uint64_t expiry = std::max(timer.m_expiry, m_currentTick);
+
+  size_t level = 0;
+  size_t slot = 0;
+  if (expiry - m_currentTick < N_SLOTS) {
+    slot = expiry & SLOT_MASK;
+  }
+  else {
+    for (level = 1; level < N_LEVELS; ++level) {
+      size_t shift = level * SLOT_BITS;
+      if ((expiry >> shift) - (m_currentTick >> shift) < N_SLOTS) {
+        slot = (expiry >> shift) & SLOT_MASK;
+        break;
+      }
+    }
+
+    if (level == N_LEVELS) {
+      // beyond the range of the wheel: park in the farthest slot of the top level,
+      // the timer is placed again when that slot is cascaded
+      level = N_LEVELS - 1;
+      slot = ((m_currentTick >> (level * SLOT_BITS)) + N_SLOTS - 1) & SLOT_MASK;
+    }
+  }
+
+  ListNode& head = m_slots[level][slot];
+  timer.prev = head.prev;
+  timer.next = &head;
+  head.prev->next = &timer;
+  head.prev = &timer;
+  timer.m_level = level;
+  timer.m_slot = slot;
+  m_occupied[level][slot / 64] |= uint64_t(1) << (slot % 64);
+}
+
+void
+TimerWheel::unlink(Timer& timer)
+{
+  timer.prev->next = timer.next;
+  timer.next->prev = timer.prev;
+  timer.prev = timer.next = nullptr;
+
+  if (timer.m_level < N_LEVELS) {
+    if (isListEmpty(m_slots[timer.m_level][timer.m_slot])) {
+      m_occupied[timer.m_level][timer.m_slot / 64] &= ~(uint64_t(1) << (timer.m_slot % 64));
+    }
+    timer.m_level = N_LEVELS;
+  }
+}
+
+void
+TimerWheel::cancel(Timer& timer)
+{
+  BOOST_ASSERT(timer.m_isPending);
+
+  this->unlink(timer);
+  timer.m_isPending = false;
+  timer.m_callback = nullptr;
+  --m_nPending;
+
+  shared_ptr<Timer> self = std::move(timer.m_self);
+}
+
+void
+TimerWheel::cascade(size_t level)
+{
+  size_t slot = (m_currentTick >> (level * SLOT_BITS)) & SLOT_MASK;
+  ListNode& head = m_slots[level][slot];
+  if (isListEmpty(head)) {
+    return;
+  }
+
+  ListNode pending;
+  spliceList(head, pending);
+  m_occupied[level][slot / 64] &= ~(uint64_t(1) << (slot % 64));
+
+  while (!isListEmpty(pending)) {
+    Timer& timer = static_cast<Timer&>(*pending.next);
+    timer.m_level = N_LEVELS;
+    this->unlink(timer);
+    this->insert(timer);
+  }
+}
+
+void
+TimerWheel::executeCurrentTick()
+{
+  if ((m_currentTick & SLOT_MASK) == 0) {
+    // higher levels first, so that their timers can be cascaded further down
+    for (size_t level = N_LEVELS - 1; level > 0; --level) {
+      uint64_t levelMask = (uint64_t(1) << (level * SLOT_BITS)) - 1;
+      if ((m_currentTick & levelMask) == 0) {
+        this->cascade(level);
+      }
+    }
+  }
+
+  size_t slot = m_currentTick & SLOT_MASK;
+  ListNode& head = m_slots[0][slot];
+  ++m_currentTick;
+  if (isListEmpty(head)) {
+    return;
+  }
+
+  // timers scheduled by callbacks may be placed into the same slot,
+  // so detach the timers of this tick before executing them
+  ListNode due;
+  spliceList(head, due);
+  m_occupied[0][slot / 64] &= ~(uint64_t(1) << (slot % 64));
+  for (ListNode* node = due.next; node != &due; node = node->next) {
+    static_cast<Timer*>(node)->m_level = N_LEVELS;
+  }
+
+  while (!isListEmpty(due)) {
+    Timer& timer = static_cast<Timer&>(*due.next);
+    this->unlink(timer);
+    timer.m_isPending = false;
+    --m_nPending;
+
+    shared_ptr<Timer> self = std::move(timer.m_self);
+    std::function<void()> callback = std::move(timer.m_callback);
+    timer.m_callback = nullptr;
+    callback();
+  }
+}
+
+void
+TimerWheel::advance(uint64_t targetTick)
+{
+  m_isAdvancing = true;
+  while (m_currentTick <= targetTick) {
+    if (m_nPending == 0) {
+      m_currentTick = targetTick + 1;
+      break;
+    }
+
+    if ((m_currentTick & SLOT_MASK) != 0 && this->isLevelZeroEmpty()) {
+      // nothing is due before the next cascade
+      uint64_t nextCascade = (m_currentTick | SLOT_MASK) + 1;
+      if (nextCascade > targetTick) {
+        m_currentTick = targetTick + 1;
+        break;
+      }
+      m_currentTick = nextCascade;
+    }
+
+    this->executeCurrentTick();
+  }
+  m_isAdvancing = false;
+}
+
+void
+TimerWheel::scheduleWakeUp()
+{
+  if (m_nPending == 0) {
+    return;
+  }
+
+  // a cascade is due at the start of each rotation; otherwise wake up at the first occupied
+  // level 0 slot in the current rotation, or else at the start of the next rotation
+  uint64_t wakeUpTick = m_currentTick;
+  size_t slot = m_currentTick & SLOT_MASK;
+  if (slot != 0) {
+    wakeUpTick = (m_currentTick | SLOT_MASK) + 1;
+    for (size_t word = slot / 64; word < N_SLOTS / 64; ++word) {
+      uint64_t bits = m_occupied[0][word];
+      if (word == slot / 64) {
+        bits &= ~uint64_t(0) << (slot % 64);
+      }
+      if (bits != 0) {
+        wakeUpTick = (m_currentTick & ~SLOT_MASK) + word * 64 + __builtin_ctzll(bits);
+        break;
+      }
+    }
+  }
+
+  if (m_wakeUpTick != NO_WAKE_UP) {
+    if (m_wakeUpTick <= wakeUpTick) {
+      return;
+    }
+    ns3::Simulator::Cancel(m_wakeUpEvent);
+  }
+
+  int64_t delay = std::max<int64_t>(static_cast<int64_t>(wakeUpTick) * m_tickNs -
+                                    ns3::Simulator::Now().GetNanoSeconds(), 0);
+  m_wakeUpTick = wakeUpTick;
+  m_wakeUpEvent = ns3::Simulator::Schedule(ns3::NanoSeconds(delay), &TimerWheel::onWakeUp, this);
+}
+
+void
+TimerWheel::onWakeUp()
+{
+  m_wakeUpTick = NO_WAKE_UP;
+  this->advance(this->getNowTick());
+  this->scheduleWakeUp();
+}
+
+uint64_t
+TimerWheel::getNowTick() const
+{
+  return static_cast<uint64_t>(ns3::Simulator::Now().GetNanoSeconds() / m_tickNs);
+}
+
+bool
+TimerWheel::isLevelZeroEmpty() const
+{
+  for (size_t word = 0; word < N_SLOTS / 64; ++word) {
+    if (m_occupied[0][word] != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void
+TimerWheel::initList(ListNode& head)
+{
+  head.prev = head.next = &head;
+}
+
+bool
+TimerWheel::isListEmpty(const ListNode& head)
+{
+  return head.next == &head;
+}
+
+void
+TimerWheel::spliceList(ListNode& from, ListNode& to)
+{
+  to.next = from.next;
+  to.prev = from.prev;
+  to.next->prev = &to;
+  to.prev->next = &to;
+  initList(from);
+}
+
+} // namespace scheduler
+} // namespace nfd
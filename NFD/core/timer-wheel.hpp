@@ -0,0 +1,182 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_TIMER_WHEEL_HPP
+#define NFD_CORE_TIMER_WHEEL_HPP
+
+#include "scheduler.hpp"
+#include "memory-pool.hpp"
+
+namespace nfd {
+namespace scheduler {
+
+/** \brief a hierarchical timer wheel that batches timers behind one ns-3 event
+ *
+ *  Time is divided into ticks of a configurable interval. Timers are kept in four levels
+ *  of 256 slots each, so that scheduling and cancellation are O(1). The wheel keeps at most
+ *  one ns-3 event, which wakes it up at the next tick that has timers to execute.
+ *
+ *  A timer is executed at the first tick boundary not earlier than its requested time,
+ *  that is, up to one tick interval late. Timers due at the same tick are executed in
+ *  unspecified order.
+ *
+ *  When the tick interval is zero (the default), the wheel is disabled and every timer
+ *  is scheduled as a separate ns-3 event through scheduler::schedule.
+ */
+class TimerWheel : noncopyable
+{
+public:
+  /** \param tick tick interval; zero disables the wheel
+   */
+  explicit
+  TimerWheel(const time::nanoseconds& tick = time::nanoseconds::zero());
+
+  ~TimerWheel();
+
+  /** \brief set tick interval
+   *  \param tick tick interval; zero disables the wheel
+   *  \throw std::logic_error timers are pending on the wheel
+   */
+  void
+  setTickInterval(const time::nanoseconds& tick);
+
+  const time::nanoseconds&
+  getTickInterval() const;
+
+  bool
+  isEnabled() const;
+
+  /** \brief schedule an event
+   *
+   *  The returned EventId can be cancelled with scheduler::cancel.
+   */
+  EventId
+  schedule(const time::nanoseconds& after, const std::function<void()>& event);
+
+  /** \return number of timers pending on the wheel
+   */
+  size_t
+  size() const;
+
+public:
+  static const size_t N_LEVELS = 4;
+  static const size_t SLOT_BITS = 8;
+  static const size_t N_SLOTS = 1 << SLOT_BITS;
+
+private:
+  struct ListNode
+  {
+    ListNode* prev;
+    ListNode* next;
+  };
+
+  class Timer;
+
+  void
+  insert(Timer& timer);
+
+  void
+  unlink(Timer& timer);
+
+  void
+  cancel(Timer& timer);
+
+  void
+  cascade(size_t level);
+
+  void
+  executeCurrentTick();
+
+  void
+  advance(uint64_t targetTick);
+
+  void
+  scheduleWakeUp();
+
+  void
+  onWakeUp();
+
+  uint64_t
+  getNowTick() const;
+
+  bool
+  isLevelZeroEmpty() const;
+
+  static void
+  initList(ListNode& head);
+
+  static bool
+  isListEmpty(const ListNode& head);
+
+  /** \brief move all nodes of \p from into the empty list \p to
+   */
+  static void
+  spliceList(ListNode& from, ListNode& to);
+
+private:
+  int64_t m_tickNs;
+  time::nanoseconds m_tick;
+
+  /// next tick to be executed; all earlier ticks have been executed
+  uint64_t m_currentTick;
+  size_t m_nPending;
+
+  ListNode m_slots[N_LEVELS][N_SLOTS];
+  uint64_t m_occupied[N_LEVELS][N_SLOTS / 64];
+
+  ns3::EventId m_wakeUpEvent;
+  uint64_t m_wakeUpTick;
+  bool m_isAdvancing;
+
+  shared_ptr<MemoryPool> m_timerPool;
+
+  friend class Timer;
+};
+
+inline const time::nanoseconds&
+TimerWheel::getTickInterval() const
+{
+  return m_tick;
+}
+
+inline bool
+TimerWheel::isEnabled() const
+{
+  return m_tickNs > 0;
+}
+
+inline size_t
+TimerWheel::size() const
+{
+  return m_nPending;
+}
+
+} // namespace scheduler
+
+using scheduler::TimerWheel;
+
+} // namespace nfd
+
+#endif // NFD_CORE_TIMER_WHEEL_HPP
@@ -23,6 +23,7 @@
  * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "available-strategies.hpp"
 #include "best-route-strategy.hpp"
 #include "broadcast-strategy.hpp"
 #include "client-control-strategy.hpp"
@@ -39,23 +40,61 @@ makeDefaultStrategy(Forwarder& forwarder)
 }
 
 template<typename S>
-inline void
-installStrategy(Forwarder& forwarder)
+shared_ptr<Strategy>
+createStrategy(Forwarder& forwarder)
 {
-  StrategyChoice& strategyChoice = forwarder.getStrategyChoice();
-  if (!strategyChoice.hasStrategy(S::STRATEGY_NAME)) {
-    strategyChoice.install(make_shared<S>(ref(forwarder)));
-  }
+  return make_shared<S>(ref(forwarder));
+}
+
+struct AvailableStrategy
+{
+  const Name& name;
+  shared_ptr<Strategy> (*create)(Forwarder& forwarder);
+};
+
+static std::vector<AvailableStrategy>
+getAvailableStrategies()
+{
+  return {
+    {BestRouteStrategy::STRATEGY_NAME, &createStrategy<BestRouteStrategy>},
+    {BroadcastStrategy::STRATEGY_NAME, &createStrategy<BroadcastStrategy>},
+    {ClientControlStrategy::STRATEGY_NAME, &createStrategy<ClientControlStrategy>},
+    {NccStrategy::STRATEGY_NAME, &createStrategy<NccStrategy>},
+    {BestRouteStrategy2::STRATEGY_NAME, &createStrategy<BestRouteStrategy2>},
+  };
 }
 
 void
 installStrategies(Forwarder& forwarder)
 {
-  installStrategy<BestRouteStrategy>(forwarder);
-  installStrategy<BroadcastStrategy>(forwarder);
-  installStrategy<ClientControlStrategy>(forwarder);
-  installStrategy<NccStrategy>(forwarder);
-  installStrategy<BestRouteStrategy2>(forwarder);
+  StrategyChoice& strategyChoice = forwarder.getStrategyChoice();
+  for (const AvailableStrategy& available : getAvailableStrategies()) {
+    if (!strategyChoice.hasStrategy(available.name)) {
+      strategyChoice.install(available.create(forwarder));
+    }
+  }
+}
+
+bool
+installStrategy(Forwarder& forwarder, const Name& strategyName)
+{
+  StrategyChoice& strategyChoice = forwarder.getStrategyChoice();
+  std::vector<AvailableStrategy> availableStrategies = getAvailableStrategies();
+
+  const AvailableStrategy* latest = nullptr;
+  for (const AvailableStrategy& available : availableStrategies) {
+    // same matching as StrategyChoice::getStrategy: exact, or one version component more
+    if (strategyName.isPrefixOf(available.name) &&
+        available.name.size() - strategyName.size() <= 1 &&
+        (latest == nullptr || latest->name < available.name)) {
+      latest = &available;
+    }
+  }
+
+  if (latest != nullptr && !strategyChoice.hasStrategy(latest->name, true)) {
+    strategyChoice.install(latest->create(forwarder));
+  }
+  return strategyChoice.hasStrategy(strategyName);
 }
 
 } // namespace fw
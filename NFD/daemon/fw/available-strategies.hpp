@@ -33,9 +33,22 @@ namespace fw {
 shared_ptr<Strategy>
 makeDefaultStrategy(Forwarder& forwarder);
 
+/** \brief install all available strategies that are not installed yet
+ */
 void
 installStrategies(Forwarder& forwarder);
 
+/** \brief install the available strategy matching \p strategyName, if not installed yet
+ *
+ *  An unversioned \p strategyName selects the latest available version, as in
+ *  StrategyChoice::insert.  This allows a forwarder to create strategies on first use
+ *  instead of creating all of them upfront.
+ *
+ *  \return whether a strategy matching \p strategyName is installed afterwards
+ */
+bool
+installStrategy(Forwarder& forwarder, const Name& strategyName);
+
 } // namespace fw
 } // namespace nfd
 
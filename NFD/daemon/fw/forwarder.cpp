@@ -44,15 +44,20 @@ using fw::Strategy;
 
 const Name Forwarder::LOCALHOST_NAME("ndn:/localhost");
 
-Forwarder::Forwarder()
+Forwarder::Forwarder(bool shouldInstallStrategies, const time::nanoseconds& timerWheelTick)
   : m_faceTable(*this)
+  , m_timerWheel(timerWheelTick)
   , m_fib(m_nameTree)
   , m_pit(m_nameTree)
-  , m_measurements(m_nameTree)
+  , m_cs(new SkipListCs())
+  , m_measurements(m_nameTree, m_timerWheel)
   , m_strategyChoice(m_nameTree, fw::makeDefaultStrategy(*this))
+  , m_deadNonceList(m_timerWheel)
   , m_csFace(make_shared<NullFace>(FaceUri("contentstore://")))
 {
-  fw::installStrategies(*this);
+  if (shouldInstallStrategies) {
+    fw::installStrategies(*this);
+  }
   getFaceTable().addReserved(m_csFace, FACEID_CONTENT_STORE);
 }
 
@@ -104,7 +109,7 @@ Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
     const Data* csMatch;
     shared_ptr<Data> match;
     if (m_csFromNdnSim == nullptr)
-      csMatch = m_cs.find(interest);
+      csMatch = m_cs->find(interest);
     else {
       match = m_csFromNdnSim->Lookup(interest.shared_from_this());
       csMatch = match.get();
@@ -297,17 +302,24 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
   ns3::ndn::FwHopCountTag tag;
   tmpPacket->RemovePacketTag(tag);
 
-  // CS insert
-  if (m_csFromNdnSim == nullptr)
-    m_cs.insert(*(ns3::ndn::Convert::FromPacket<Data>(tmpPacket)));
-  else
-    m_csFromNdnSim->Add(ns3::ndn::Convert::FromPacket<Data>(tmpPacket));
+  // CS insert, unless cooperative placement leaves the copy to another router
+  if (m_cachePlacement == nullptr || m_cachePlacement->ShouldCache(data, tag.Get())) {
+    if (m_csFromNdnSim == nullptr)
+      m_cs->insert(*(ns3::ndn::Convert::FromPacket<Data>(tmpPacket)));
+    else
+      m_csFromNdnSim->Add(ns3::ndn::Convert::FromPacket<Data>(tmpPacket));
+  }
 #else
-  // CS insert
-  if (m_csFromNdnSim == nullptr)
-    m_cs.insert(data);
-  else
-    m_csFromNdnSim->Add(data.shared_from_this());
+  ns3::ndn::FwHopCountTag tag;
+  ns3::ndn::Convert::ToPacket(data)->PeekPacketTag(tag);
+
+  // CS insert, unless cooperative placement leaves the copy to another router
+  if (m_cachePlacement == nullptr || m_cachePlacement->ShouldCache(data, tag.Get())) {
+    if (m_csFromNdnSim == nullptr)
+      m_cs->insert(data);
+    else
+      m_csFromNdnSim->Add(data.shared_from_this());
+  }
 #endif
 
 
@@ -364,7 +376,7 @@ Forwarder::onDataUnsolicited(Face& inFace, const Data& data)
   if (acceptToCache) {
     // CS insert
     if (m_csFromNdnSim == nullptr)
-      m_cs.insert(data, true);
+      m_cs->insert(data, true);
     else
       m_csFromNdnSim->Add(data.shared_from_this());
   }
@@ -421,7 +433,7 @@ Forwarder::setUnsatisfyTimer(shared_ptr<pit::Entry> pitEntry)
   }
 
   scheduler::cancel(pitEntry->m_unsatisfyTimer);
-  pitEntry->m_unsatisfyTimer = scheduler::schedule(lastExpiryFromNow,
+  pitEntry->m_unsatisfyTimer = m_timerWheel.schedule(lastExpiryFromNow,
     bind(&Forwarder::onInterestUnsatisfied, this, pitEntry));
 }
 
@@ -432,7 +444,7 @@ Forwarder::setStragglerTimer(shared_ptr<pit::Entry> pitEntry, bool isSatisfied,
   time::nanoseconds stragglerTime = time::milliseconds(100);
 
   scheduler::cancel(pitEntry->m_stragglerTimer);
-  pitEntry->m_stragglerTimer = scheduler::schedule(stragglerTime,
+  pitEntry->m_stragglerTimer = m_timerWheel.schedule(stragglerTime,
     bind(&Forwarder::onInterestFinalize, this, pitEntry, isSatisfied, dataFreshnessPeriod));
 }
 
@@ -28,6 +28,7 @@
 
 #include "common.hpp"
 #include "core/scheduler.hpp"
+#include "core/timer-wheel.hpp"
 #include "forwarder-counters.hpp"
 #include "face-table.hpp"
 #include "table/fib.hpp"
@@ -38,6 +39,7 @@
 #include "table/dead-nonce-list.hpp"
 
 #include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
+#include "ns3/ndnSIM/model/cs/ndn-cache-placement.hpp"
 
 namespace nfd {
 
@@ -47,6 +49,46 @@ class Strategy;
 
 class NullFace;
 
+/** \brief occupancy of the memory pools from which table entries are allocated
+ */
+struct ForwarderPoolOccupancy
+{
+  MemoryPool::Occupancy nameTreeEntries;
+  MemoryPool::Occupancy nameTreeNodes;
+  MemoryPool::Occupancy pitEntries;
+  MemoryPool::Occupancy csEntries;
+};
+
+/** \brief number of entries and estimated memory footprint of the forwarder's tables
+ */
+struct ForwarderMemoryUsage
+{
+  MemoryUsage nameTree;
+  MemoryUsage fib;
+  MemoryUsage pit;
+  MemoryUsage cs;
+  MemoryUsage measurements;
+  MemoryUsage strategyChoice;
+  MemoryUsage deadNonceList;
+
+  /** \return sum of all tables
+   *  \note Entries of FIB, PIT, Measurements, and Strategy Choice are attached to name tree
+   *        entries, so the total counts both.
+   */
+  MemoryUsage
+  getTotal() const
+  {
+    MemoryUsage total = nameTree;
+    total += fib;
+    total += pit;
+    total += cs;
+    total += measurements;
+    total += strategyChoice;
+    total += deadNonceList;
+    return total;
+  }
+};
+
 /** \brief main class of NFD
  *
  *  Forwarder owns all faces and tables, and implements forwarding pipelines.
@@ -54,7 +96,13 @@ class NullFace;
 class Forwarder
 {
 public:
-  Forwarder();
+  /** \param shouldInstallStrategies if false, only the default strategy is created;
+   *         other strategies must be installed on first use (see fw::installStrategy)
+   *  \param timerWheelTick tick interval of the timer wheel; zero disables the wheel
+   */
+  explicit
+  Forwarder(bool shouldInstallStrategies = true,
+            const time::nanoseconds& timerWheelTick = time::nanoseconds::zero());
 
   VIRTUAL_WITH_TESTS
   ~Forwarder();
@@ -99,6 +147,12 @@ public: // forwarding entrypoints and tables
   Cs&
   getCs();
 
+  /** \brief replace the Content Store implementation
+   *  \note Data packets in the current Content Store are discarded.
+   */
+  void
+  setCs(unique_ptr<Cs> cs);
+
   Measurements&
   getMeasurements();
 
@@ -108,10 +162,33 @@ public: // forwarding entrypoints and tables
   DeadNonceList&
   getDeadNonceList();
 
+  /** \brief get the timer wheel used by PIT, Measurements, and Dead Nonce List timers
+   *  \note The tick interval should be given to the constructor: timers that tables schedule
+   *        during construction are already pending when setTickInterval can be called.
+   */
+  TimerWheel&
+  getTimerWheel();
+
+public: // instrumentation
+  /** \brief get occupancy of the memory pools owned by this forwarder's tables
+   */
+  ForwarderPoolOccupancy
+  getPoolOccupancy() const;
+
+  /** \brief get number of entries and estimated memory footprint of each table
+   */
+  ForwarderMemoryUsage
+  getMemoryUsage() const;
+
 public: // allow enabling ndnSIM content store (will be removed in the future)
   void
   setCsFromNdnSim(ns3::Ptr<ns3::ndn::ContentStore> cs);
 
+  /** \brief set cooperative placement consulted before every CS insertion of incoming Data
+   */
+  void
+  setCachePlacement(ns3::Ptr<ns3::ndn::CachePlacement> placement);
+
 public:
   /** \brief trigger before PIT entry is satisfied
    *  \sa Strategy::beforeSatisfyInterest
@@ -209,17 +286,21 @@ private:
 
   FaceTable m_faceTable;
 
+  // declared before the tables, so that it outlives the timers they have scheduled
+  TimerWheel m_timerWheel;
+
   // tables
   NameTree       m_nameTree;
   Fib            m_fib;
   Pit            m_pit;
-  Cs             m_cs;
+  unique_ptr<Cs> m_cs;
   Measurements   m_measurements;
   StrategyChoice m_strategyChoice;
   DeadNonceList  m_deadNonceList;
   shared_ptr<NullFace> m_csFace;
 
   ns3::Ptr<ns3::ndn::ContentStore> m_csFromNdnSim;
+  ns3::Ptr<ns3::ndn::CachePlacement> m_cachePlacement;
 
   static const Name LOCALHOST_NAME;
 
@@ -284,7 +365,14 @@ Forwarder::getPit()
 inline Cs&
 Forwarder::getCs()
 {
-  return m_cs;
+  return *m_cs;
+}
+
+inline void
+Forwarder::setCs(unique_ptr<Cs> cs)
+{
+  BOOST_ASSERT(cs != nullptr);
+  m_cs = std::move(cs);
 }
 
 inline Measurements&
@@ -305,12 +393,49 @@ Forwarder::getDeadNonceList()
   return m_deadNonceList;
 }
 
+inline TimerWheel&
+Forwarder::getTimerWheel()
+{
+  return m_timerWheel;
+}
+
+inline ForwarderPoolOccupancy
+Forwarder::getPoolOccupancy() const
+{
+  ForwarderPoolOccupancy occupancy;
+  occupancy.nameTreeEntries = m_nameTree.getEntryPoolOccupancy();
+  occupancy.nameTreeNodes = m_nameTree.getNodePoolOccupancy();
+  occupancy.pitEntries = m_pit.getEntryPoolOccupancy();
+  occupancy.csEntries = m_cs->getEntryPoolOccupancy();
+  return occupancy;
+}
+
+inline ForwarderMemoryUsage
+Forwarder::getMemoryUsage() const
+{
+  ForwarderMemoryUsage usage;
+  usage.nameTree = m_nameTree.getMemoryUsage();
+  usage.fib = m_fib.getMemoryUsage();
+  usage.pit = m_pit.getMemoryUsage();
+  usage.cs = m_cs->getMemoryUsage();
+  usage.measurements = m_measurements.getMemoryUsage();
+  usage.strategyChoice = m_strategyChoice.getMemoryUsage();
+  usage.deadNonceList = m_deadNonceList.getMemoryUsage();
+  return usage;
+}
+
 inline void
 Forwarder::setCsFromNdnSim(ns3::Ptr<ns3::ndn::ContentStore> cs)
 {
   m_csFromNdnSim = cs;
 }
 
+inline void
+Forwarder::setCachePlacement(ns3::Ptr<ns3::ndn::CachePlacement> placement)
+{
+  m_cachePlacement = placement;
+}
+
 #ifdef WITH_TESTS
 inline void
 Forwarder::dispatchToStrategy(shared_ptr<pit::Entry> pitEntry, function<void(fw::Strategy*)> trigger)
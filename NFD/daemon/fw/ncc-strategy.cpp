@@ -228,8 +228,7 @@ NccStrategy::getMeasurementsEntryInfo(shared_ptr<measurements::Entry> entry)
     return info;
   }
 
-  info = make_shared<MeasurementsEntryInfo>();
-  entry->setStrategyInfo(info);
+  info = entry->getOrCreateStrategyInfo<MeasurementsEntryInfo>();
 
   shared_ptr<measurements::Entry> parentEntry = this->getMeasurements().getParent(*entry);
   if (static_cast<bool>(parentEntry)) {
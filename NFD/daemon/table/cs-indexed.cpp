@@ -0,0 +1,389 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-indexed.hpp"
+#include "name-tree.hpp"
+#include "core/logger.hpp"
+
+#include <ndn-cxx/util/crypto.hpp>
+
+NFD_LOG_INIT("IndexedCs");
+
+namespace nfd {
+namespace cs {
+namespace indexed {
+
+size_t
+NameHash::operator()(const Name& name) const
+{
+  return name_tree::computeHash(name);
+}
+
+} // namespace indexed
+} // namespace cs
+
+using cs::indexed::Entry;
+
+IndexedCs::IndexedCs(size_t nMaxPackets, Policy policy)
+  : m_policy(policy)
+  , m_nMaxPackets(nMaxPackets)
+  , m_nMaxBytes(0)
+  , m_nBytes(0)
+{
+}
+
+IndexedCs::~IndexedCs()
+{
+  // unlink entries from intrusive containers before releasing their memory
+  for (cs::indexed::Queue& queue : m_queues) {
+    queue.clear();
+  }
+  m_staleIndex.clear();
+
+  std::vector<Entry*> entries(m_table.begin(), m_table.end());
+  m_table.clear();
+
+  for (Entry* entry : entries) {
+    entry->~Entry();
+    m_entryPool.deallocate(entry);
+  }
+}
+
+IndexedCs::Policy
+IndexedCs::parsePolicy(const std::string& policyName)
+{
+  if (policyName == "lru") {
+    return POLICY_LRU;
+  }
+  if (policyName == "fifo") {
+    return POLICY_FIFO;
+  }
+  if (policyName == "priority_fifo") {
+    return POLICY_PRIORITY_FIFO;
+  }
+  throw std::invalid_argument("unknown CS policy " + policyName);
+}
+
+size_t
+IndexedCs::size() const
+{
+  return m_table.size();
+}
+
+size_t
+IndexedCs::getLimit() const
+{
+  return m_nMaxPackets;
+}
+
+void
+IndexedCs::setLimit(size_t nMaxPackets)
+{
+  m_nMaxPackets = nMaxPackets;
+
+  while (size() > m_nMaxPackets) {
+    evictItem();
+  }
+}
+
+void
+IndexedCs::setByteLimit(size_t nMaxBytes)
+{
+  m_nMaxBytes = nMaxBytes;
+
+  while (m_nMaxBytes > 0 && m_nBytes > m_nMaxBytes) {
+    evictItem();
+  }
+}
+
+size_t
+IndexedCs::getByteLimit() const
+{
+  return m_nMaxBytes;
+}
+
+size_t
+IndexedCs::getBytesInUse() const
+{
+  return m_nBytes;
+}
+
+MemoryPool::Occupancy
+IndexedCs::getEntryPoolOccupancy() const
+{
+  return m_entryPool.getOccupancy();
+}
+
+void
+IndexedCs::forEachEntry(const function<void(const cs::Entry&)>& visitor) const
+{
+  for (const cs::indexed::Entry* entry : m_table.get<cs::indexed::byFullName>()) {
+    visitor(*entry);
+  }
+}
+
+void
+IndexedCs::forEachEntryInEvictionOrder(const function<void(const cs::Entry&)>& visitor) const
+{
+  for (const cs::indexed::Queue& queue : m_queues) {
+    for (const Entry& entry : queue) {
+      visitor(entry);
+    }
+  }
+}
+
+bool
+IndexedCs::insert(const Data& data, bool isUnsolicited)
+{
+  NFD_LOG_TRACE("insert() " << data.getFullName());
+
+  size_t entrySize = computeEntrySize(data);
+  if (m_nMaxPackets == 0 || (m_nMaxBytes > 0 && entrySize > m_nMaxBytes)) {
+    return false;
+  }
+
+  auto& index = m_table.get<cs::indexed::byFullName>();
+  auto it = index.find(data.getFullName());
+  if (it != index.end()) {
+    NFD_LOG_TRACE("Duplicate name (with digest)");
+
+    // full name is the index key, so the entry can be refreshed in place
+    Entry* entry = *it;
+    m_nBytes -= computeEntrySize(entry->getData());
+    if (m_policy == POLICY_FIFO) {
+      entry->setData(data, isUnsolicited);
+    }
+    else {
+      this->dequeue(entry);
+      entry->setData(data, isUnsolicited);
+      this->enqueue(entry);
+    }
+    m_nBytes += entrySize;
+    notifyBytesInUse(m_nBytes);
+
+    // the refreshed entry may be larger than before
+    while (m_nMaxBytes > 0 && m_nBytes > m_nMaxBytes) {
+      evictItem();
+    }
+    return false;
+  }
+
+  if (size() >= m_nMaxPackets) {
+    evictItem();
+  }
+  while (m_nMaxBytes > 0 && m_nBytes + entrySize > m_nMaxBytes) {
+    evictItem();
+  }
+
+  Entry* entry = new (m_entryPool.allocate(sizeof(Entry))) Entry();
+  entry->setData(data, isUnsolicited);
+  m_table.insert(entry);
+  this->enqueue(entry);
+  m_nBytes += entrySize;
+  notifyBytesInUse(m_nBytes);
+  return true;
+}
+
+const Data*
+IndexedCs::find(const Interest& interest) const
+{
+  NFD_LOG_TRACE("find() " << interest.getName());
+
+  const Name& name = interest.getName();
+  bool mayContainDigest = interest.getMinSuffixComponents() <= 0 && !name.empty() &&
+                          name.get(-1).value_size() == ndn::crypto::SHA256_DIGEST_SIZE;
+
+  // Without MaxSuffixComponents=1, Data with a longer name can precede the exact-name Data
+  // in the leftmost-child order, so the hash index alone cannot determine the match.
+  Entry* match = nullptr;
+  if (interest.getMaxSuffixComponents() == 1 && !mayContainDigest) {
+    match = this->findExactName(interest);
+  }
+  else {
+    match = this->findByPrefix(interest, mayContainDigest);
+  }
+  if (match == nullptr) {
+    return 0;
+  }
+
+  this->touch(match);
+  return &match->getData();
+}
+
+Entry*
+IndexedCs::findExactName(const Interest& interest) const
+{
+  // With MaxSuffixComponents=1, only Data named exactly as the Interest can match.
+  // Their full names differ only in the implicit digest, which is the child component,
+  // so the leftmost child is the smallest full name and the rightmost child is the largest.
+  bool hasLeftmostSelector = (interest.getChildSelector() <= 0);
+  Entry* match = nullptr;
+  auto range = m_table.get<cs::indexed::byName>().equal_range(interest.getName());
+  for (auto it = range.first; it != range.second; ++it) {
+    Entry* entry = *it;
+    if (match != nullptr &&
+        (hasLeftmostSelector ? !(entry->getFullName() < match->getFullName()) :
+                               !(match->getFullName() < entry->getFullName()))) {
+      continue;
+    }
+    if (doesComplyWithSelectors(interest, entry, false)) {
+      match = entry;
+    }
+  }
+
+  return match;
+}
+
+Entry*
+IndexedCs::findByPrefix(const Interest& interest, bool mayContainDigest) const
+{
+  const Name& name = interest.getName();
+  Name scanPrefix = mayContainDigest ? name.getPrefix(-1) : name;
+  bool hasLeftmostSelector = (interest.getChildSelector() <= 0);
+
+  // with rightmost child selector, the result is the leftmost match under the rightmost child
+  Entry* match = nullptr;
+  Name currentChildPrefix;
+
+  const auto& index = m_table.get<cs::indexed::byFullName>();
+  for (auto it = index.lower_bound(scanPrefix);
+       it != index.end() && scanPrefix.isPrefixOf((*it)->getFullName()); ++it) {
+    Entry* entry = *it;
+    bool doesInterestContainDigest = mayContainDigest &&
+                                     recognizeInterestWithDigest(interest, entry);
+    if (!doesInterestContainDigest && !name.isPrefixOf(entry->getFullName())) {
+      continue;
+    }
+
+    if (!doesComplyWithSelectors(interest, entry, doesInterestContainDigest)) {
+      continue;
+    }
+
+    if (hasLeftmostSelector) {
+      return entry;
+    }
+
+    size_t childPrefixLength = doesInterestContainDigest ? name.size() : name.size() + 1;
+    Name childPrefix = entry->getFullName().getPrefix(childPrefixLength);
+    if (match == nullptr || childPrefix != currentChildPrefix) {
+      currentChildPrefix = childPrefix;
+      match = entry;
+    }
+  }
+
+  return match;
+}
+
+void
+IndexedCs::erase(const Name& exactName)
+{
+  NFD_LOG_TRACE("erase() " << exactName);
+
+  auto& index = m_table.get<cs::indexed::byFullName>();
+  auto it = index.find(exactName);
+  if (it != index.end()) {
+    this->eraseEntry(*it);
+  }
+}
+
+bool
+IndexedCs::evictItem()
+{
+  NFD_LOG_TRACE("evictItem()");
+
+  Entry* victim = nullptr;
+  if (!m_queues[cs::indexed::QUEUE_UNSOLICITED].empty()) {
+    NFD_LOG_TRACE("Evict from unsolicited queue");
+    victim = &m_queues[cs::indexed::QUEUE_UNSOLICITED].front();
+  }
+  else if (!m_staleIndex.empty() &&
+           m_staleIndex.begin()->getStaleTime() < time::steady_clock::now()) {
+    NFD_LOG_TRACE("Evict from staleness index");
+    victim = &*m_staleIndex.begin();
+  }
+  else if (!m_queues[cs::indexed::QUEUE_FIFO].empty()) {
+    NFD_LOG_TRACE("Evict from FIFO queue");
+    victim = &m_queues[cs::indexed::QUEUE_FIFO].front();
+  }
+
+  if (victim == nullptr) {
+    return false;
+  }
+
+  this->eraseEntry(victim);
+  return true;
+}
+
+void
+IndexedCs::eraseEntry(Entry* entry)
+{
+  this->dequeue(entry);
+  m_table.get<cs::indexed::byFullName>().erase(entry->getFullName());
+  m_nBytes -= computeEntrySize(entry->getData());
+  notifyBytesInUse(m_nBytes);
+
+  entry->~Entry();
+  m_entryPool.deallocate(entry);
+}
+
+void
+IndexedCs::enqueue(Entry* entry) const
+{
+  // only priority FIFO policy distinguishes unsolicited and stale entries
+  if (m_policy == POLICY_PRIORITY_FIFO) {
+    entry->queue = entry->isUnsolicited() ? cs::indexed::QUEUE_UNSOLICITED :
+                                            cs::indexed::QUEUE_FIFO;
+    m_staleIndex.insert(*entry);
+  }
+  else {
+    entry->queue = cs::indexed::QUEUE_FIFO;
+  }
+
+  m_queues[entry->queue].push_back(*entry);
+}
+
+void
+IndexedCs::dequeue(Entry* entry) const
+{
+  cs::indexed::Queue& queue = m_queues[entry->queue];
+  queue.erase(queue.iterator_to(*entry));
+
+  if (m_policy == POLICY_PRIORITY_FIFO) {
+    m_staleIndex.erase(m_staleIndex.iterator_to(*entry));
+  }
+}
+
+void
+IndexedCs::touch(Entry* entry) const
+{
+  if (m_policy != POLICY_LRU) {
+    return;
+  }
+
+  cs::indexed::Queue& queue = m_queues[entry->queue];
+  queue.splice(queue.end(), queue, queue.iterator_to(*entry));
+}
+
+} // namespace nfd
@@ -0,0 +1,265 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_INDEXED_HPP
+#define NFD_DAEMON_TABLE_CS_INDEXED_HPP
+
+#include "cs.hpp"
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/mem_fun.hpp>
+#include <boost/intrusive/list.hpp>
+#include <boost/intrusive/set.hpp>
+
+namespace nfd {
+namespace cs {
+namespace indexed {
+
+/** \brief identifies an eviction queue
+ */
+enum QueueId {
+  QUEUE_UNSOLICITED,
+  QUEUE_FIFO,
+  QUEUE_MAX
+};
+
+/** \brief represents an entry in a CS with indexed implementation
+ *
+ *  Eviction queues and the staleness index link entries through hooks embedded in the entry,
+ *  so that enqueuing an entry does not allocate memory.
+ */
+class Entry : public cs::Entry
+{
+public:
+  QueueId queue;
+  boost::intrusive::list_member_hook<> queueHook;
+  boost::intrusive::set_member_hook<> staleHook;
+};
+
+/** \brief orders entries by stale time
+ */
+struct StaleTimeCompare
+{
+  bool
+  operator()(const Entry& a, const Entry& b) const
+  {
+    return a.getStaleTime() < b.getStaleTime();
+  }
+};
+
+typedef boost::intrusive::list<
+  Entry,
+  boost::intrusive::member_hook<Entry, boost::intrusive::list_member_hook<>, &Entry::queueHook>
+> Queue;
+
+typedef boost::intrusive::multiset<
+  Entry,
+  boost::intrusive::member_hook<Entry, boost::intrusive::set_member_hook<>, &Entry::staleHook>,
+  boost::intrusive::compare<StaleTimeCompare>
+> StaleIndex;
+
+/** \brief computes hash of a Name, for use in hashed indexes
+ */
+struct NameHash
+{
+  size_t
+  operator()(const Name& name) const;
+};
+
+// tags
+class byFullName;
+class byName;
+
+typedef boost::multi_index_container<
+  Entry*,
+  boost::multi_index::indexed_by<
+
+    // by full name, for prefix and selector matching
+    boost::multi_index::ordered_unique<
+      boost::multi_index::tag<byFullName>,
+      boost::multi_index::const_mem_fun<cs::Entry, const Name&, &cs::Entry::getFullName>
+    >,
+
+    // by Data name, for exact-name lookups
+    boost::multi_index::hashed_non_unique<
+      boost::multi_index::tag<byName>,
+      boost::multi_index::const_mem_fun<cs::Entry, const Name&, &cs::Entry::getName>,
+      NameHash
+    >
+
+  >
+> Table;
+
+} // namespace indexed
+} // namespace cs
+
+/** \brief represents Content Store implemented with a hash index and an ordered index
+ *
+ *  Interests that can only be satisfied by Data named exactly as the Interest
+ *  (MaxSuffixComponents=1) are looked up in the hash index. Other Interests are served
+ *  by a scan of the ordered index from the Interest name, which yields the same match
+ *  as SkipListCs.
+ *
+ *  \note Interests without MaxSuffixComponents, which is what ndnSIM consumer applications
+ *         send, do not use the hash index even if their name is a complete Data name:
+ *         Data named /A/B sorts before Data named /A (whose implicit digest is a 32-octet
+ *         component), so it is the leftmost match of Interest /A, and only the ordered index
+ *         can tell whether such Data exists. For these Interests, the lookup is a single
+ *         lower_bound in the ordered index, unless entries under the Interest name are
+ *         skipped because they violate the selectors (e.g. stale Data for MustBeFresh).
+ *
+ *  Entries are evicted according to one of the following policies:
+ *  \li LRU: the least recently inserted or found entry is evicted
+ *  \li FIFO: the earliest inserted entry is evicted
+ *  \li priority FIFO: unsolicited entries are evicted first, then stale entries,
+ *      then the earliest inserted entry
+ */
+class IndexedCs : public Cs
+{
+public:
+  enum Policy {
+    POLICY_LRU,
+    POLICY_FIFO,
+    POLICY_PRIORITY_FIFO
+  };
+
+  explicit
+  IndexedCs(size_t nMaxPackets = 10, Policy policy = POLICY_LRU);
+
+  virtual
+  ~IndexedCs();
+
+  /** \brief parses name of a replacement policy
+   *  \param policyName "lru", "fifo", or "priority_fifo"
+   *  \throw std::invalid_argument policyName is unknown
+   */
+  static Policy
+  parsePolicy(const std::string& policyName);
+
+  Policy
+  getPolicy() const;
+
+  virtual bool
+  insert(const Data& data, bool isUnsolicited = false) DECL_OVERRIDE;
+
+  virtual const Data*
+  find(const Interest& interest) const DECL_OVERRIDE;
+
+  virtual void
+  erase(const Name& exactName) DECL_OVERRIDE;
+
+  virtual void
+  setLimit(size_t nMaxPackets) DECL_OVERRIDE;
+
+  virtual size_t
+  getLimit() const DECL_OVERRIDE;
+
+  virtual void
+  setByteLimit(size_t nMaxBytes) DECL_OVERRIDE;
+
+  virtual size_t
+  getByteLimit() const DECL_OVERRIDE;
+
+  virtual size_t
+  getBytesInUse() const DECL_OVERRIDE;
+
+  virtual size_t
+  size() const DECL_OVERRIDE;
+
+  virtual MemoryPool::Occupancy
+  getEntryPoolOccupancy() const DECL_OVERRIDE;
+
+  /** \brief invokes \p visitor for every CS entry, in full name order
+   */
+  virtual void
+  forEachEntry(const function<void(const cs::Entry&)>& visitor) const DECL_OVERRIDE;
+
+  /** \brief invokes \p visitor for every CS entry, unsolicited queue first
+   */
+  virtual void
+  forEachEntryInEvictionOrder(const function<void(const cs::Entry&)>& visitor) const
+    DECL_OVERRIDE;
+
+private:
+  /** \brief finds the best match among entries whose Data name equals Interest name
+   *  \pre Interest has MaxSuffixComponents=1 and does not end with an implicit digest
+   *  \return{ the best match, if any; otherwise 0 }
+   */
+  cs::indexed::Entry*
+  findExactName(const Interest& interest) const;
+
+  /** \brief finds the best match by scanning the ordered index
+   *  \return{ the best match, if any; otherwise 0 }
+   */
+  cs::indexed::Entry*
+  findByPrefix(const Interest& interest, bool mayContainDigest) const;
+
+  /** \brief removes one entry based on replacement policy
+   *  \return{ whether an entry was removed }
+   */
+  bool
+  evictItem();
+
+  void
+  eraseEntry(cs::indexed::Entry* entry);
+
+  /** \brief appends an entry to its eviction queue
+   */
+  void
+  enqueue(cs::indexed::Entry* entry) const;
+
+  /** \brief removes an entry from its eviction queue
+   */
+  void
+  dequeue(cs::indexed::Entry* entry) const;
+
+  /** \brief marks an entry as recently used
+   */
+  void
+  touch(cs::indexed::Entry* entry) const;
+
+private:
+  Policy m_policy;
+  size_t m_nMaxPackets;
+  size_t m_nMaxBytes;
+  size_t m_nBytes;
+  cs::indexed::Table m_table;
+
+  // eviction state is updated on lookups under LRU policy
+  mutable cs::indexed::Queue m_queues[cs::indexed::QUEUE_MAX];
+  mutable cs::indexed::StaleIndex m_staleIndex;
+
+  MemoryPool m_entryPool;
+};
+
+inline IndexedCs::Policy
+IndexedCs::getPolicy() const
+{
+  return m_policy;
+}
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_INDEXED_HPP
@@ -49,19 +49,37 @@ NFD_LOG_INIT("ContentStore");
 namespace nfd {
 
 // http://en.cppreference.com/w/cpp/concept/ForwardIterator
-BOOST_CONCEPT_ASSERT((boost::ForwardIterator<Cs::const_iterator>));
+BOOST_CONCEPT_ASSERT((boost::ForwardIterator<SkipListCs::const_iterator>));
 // boost::ForwardIterator follows SGI standard http://www.sgi.com/tech/stl/ForwardIterator.html,
 // which doesn't require DefaultConstructible
 #ifdef HAVE_IS_DEFAULT_CONSTRUCTIBLE
-static_assert(std::is_default_constructible<Cs::const_iterator>::value,
-              "Cs::const_iterator must be default-constructible");
+static_assert(std::is_default_constructible<SkipListCs::const_iterator>::value,
+              "SkipListCs::const_iterator must be default-constructible");
 #else
-BOOST_CONCEPT_ASSERT((boost::DefaultConstructible<Cs::const_iterator>));
+BOOST_CONCEPT_ASSERT((boost::DefaultConstructible<SkipListCs::const_iterator>));
 #endif // HAVE_IS_DEFAULT_CONSTRUCTIBLE
 
-Cs::Cs(size_t nMaxPackets)
+Cs::~Cs()
+{
+}
+
+size_t
+Cs::computeEntrySize(const Data& data)
+{
+  return data.wireEncode().size() + sizeof(Data) + sizeof(cs::Entry);
+}
+
+void
+Cs::notifyBytesInUse(size_t nBytes)
+{
+  this->afterBytesInUseChange(nBytes);
+}
+
+SkipListCs::SkipListCs(size_t nMaxPackets)
   : m_nMaxPackets(nMaxPackets)
   , m_nPackets(0)
+  , m_nMaxBytes(0)
+  , m_nBytes(0)
 {
   SkipListLayer* zeroLayer = new SkipListLayer();
   m_skipList.push_back(zeroLayer);
@@ -70,7 +88,7 @@ Cs::Cs(size_t nMaxPackets)
     m_freeCsEntries.push(new cs::skip_list::Entry());
 }
 
-Cs::~Cs()
+SkipListCs::~SkipListCs()
 {
   // evict all items from CS
   while (evictItem())
@@ -86,13 +104,42 @@ Cs::~Cs()
 }
 
 size_t
-Cs::size() const
+SkipListCs::size() const
 {
   return m_nPackets; // size of the first layer in a skip list
 }
 
+MemoryPool::Occupancy
+SkipListCs::getEntryPoolOccupancy() const
+{
+  MemoryPool::Occupancy occupancy;
+  occupancy.blockSize = sizeof(cs::skip_list::Entry);
+  occupancy.nInUse = m_nPackets;
+  occupancy.nFree = m_freeCsEntries.size();
+  occupancy.nChunks = 0;
+  return occupancy;
+}
+
 void
-Cs::setLimit(size_t nMaxPackets)
+SkipListCs::forEachEntry(const function<void(const cs::Entry&)>& visitor) const
+{
+  for (const_iterator it = begin(); it != end(); ++it) {
+    visitor(*it);
+  }
+}
+
+void
+SkipListCs::forEachEntryInEvictionOrder(const function<void(const cs::Entry&)>& visitor) const
+{
+  // unsolicited and stale entries are evicted first based on their own state,
+  // which is restored on insertion
+  for (const cs::skip_list::Entry* entry : m_cleanupIndex.get<byArrival>()) {
+    visitor(*entry);
+  }
+}
+
+void
+SkipListCs::setLimit(size_t nMaxPackets)
 {
   size_t oldNMaxPackets = m_nMaxPackets;
   m_nMaxPackets = nMaxPackets;
@@ -115,14 +162,70 @@ Cs::setLimit(size_t nMaxPackets)
 }
 
 size_t
-Cs::getLimit() const
+SkipListCs::getLimit() const
 {
   return m_nMaxPackets;
 }
 
+void
+SkipListCs::setByteLimit(size_t nMaxBytes)
+{
+  m_nMaxBytes = nMaxBytes;
+
+  while (m_nMaxBytes > 0 && m_nBytes > m_nMaxBytes) {
+    evictItem();
+  }
+}
+
+size_t
+SkipListCs::getByteLimit() const
+{
+  return m_nMaxBytes;
+}
+
+size_t
+SkipListCs::getBytesInUse() const
+{
+  return m_nBytes;
+}
+
+cs::skip_list::Entry*
+SkipListCs::findExactFullName(const Name& fullName) const
+{
+  // descend from the top layer, remembering the last entry whose full name is smaller;
+  // that entry is also present in all lower layers
+  cs::skip_list::Entry* predecessor = 0;
+  int layer = m_skipList.size() - 1;
+  for (SkipList::const_reverse_iterator rit = m_skipList.rbegin(); rit != m_skipList.rend();
+       ++rit, --layer)
+    {
+      SkipListLayer::iterator it = (*rit)->begin();
+      if (predecessor != 0)
+        {
+          it = predecessor->getIterators().find(layer)->second;
+          ++it;
+        }
+
+      for (; it != (*rit)->end() && (*it)->getFullName() < fullName; ++it)
+        predecessor = *it;
+    }
+
+  SkipListLayer::iterator candidate = m_skipList.front()->begin();
+  if (predecessor != 0)
+    {
+      candidate = predecessor->getIterators().find(0)->second;
+      ++candidate;
+    }
+
+  if (candidate != m_skipList.front()->end() && (*candidate)->getFullName() == fullName)
+    return *candidate;
+
+  return 0;
+}
+
 //Reference: "Skip Lists: A Probabilistic Alternative to Balanced Trees" by W.Pugh
 std::pair<cs::skip_list::Entry*, bool>
-Cs::insertToSkipList(const Data& data, bool isUnsolicited)
+SkipListCs::insertToSkipList(const Data& data, bool isUnsolicited)
 {
   NFD_LOG_TRACE("insertToSkipList() " << data.getFullName() << ", "
                 << "skipList size " << size());
@@ -206,7 +309,10 @@ Cs::insertToSkipList(const Data& data, bool isUnsolicited)
     {
       NFD_LOG_TRACE("Duplicate name (with digest)");
 
+      m_nBytes -= computeEntrySize((*head)->getData());
       (*head)->setData(data, isUnsolicited); //updates stale time
+      m_nBytes += computeEntrySize(data);
+      notifyBytesInUse(m_nBytes);
 
       // new entry not needed, returning to the pool
       entry->release();
@@ -258,17 +364,35 @@ Cs::insertToSkipList(const Data& data, bool isUnsolicited)
       layer++;
     }
 
+  m_nBytes += computeEntrySize(data);
+  notifyBytesInUse(m_nBytes);
   return std::make_pair(entry, true);
 }
 
 bool
-Cs::insert(const Data& data, bool isUnsolicited)
+SkipListCs::insert(const Data& data, bool isUnsolicited)
 {
   NFD_LOG_TRACE("insert() " << data.getFullName());
 
-  if (isFull())
+  size_t entrySize = computeEntrySize(data);
+  if (m_nMaxBytes > 0 && entrySize > m_nMaxBytes)
     {
-      evictItem();
+      NFD_LOG_TRACE("Data exceeds byte limit");
+      return false;
+    }
+
+  // A duplicate is refreshed in place and needs no room, so it must not evict other entries.
+  // Room is made before insertion, so that the new entry cannot be chosen for eviction.
+  bool needsRoom = isFull() || (m_nMaxBytes > 0 && m_nBytes + entrySize > m_nMaxBytes);
+  if (needsRoom && findExactFullName(data.getFullName()) == 0)
+    {
+      while (m_nMaxBytes > 0 && m_nBytes + entrySize > m_nMaxBytes && evictItem())
+        ;
+
+      if (isFull())
+        {
+          evictItem();
+        }
     }
 
   //pointer and insertion status
@@ -285,7 +409,7 @@ Cs::insert(const Data& data, bool isUnsolicited)
 }
 
 size_t
-Cs::pickRandomLayer() const
+SkipListCs::pickRandomLayer() const
 {
   static boost::random::bernoulli_distribution<> dist(SKIPLIST_PROBABILITY);
   // TODO rewrite using geometry_distribution
@@ -299,7 +423,7 @@ Cs::pickRandomLayer() const
 }
 
 bool
-Cs::isFull() const
+SkipListCs::isFull() const
 {
   if (size() >= m_nMaxPackets) //size of the first layer vs. max size
     return true;
@@ -308,7 +432,7 @@ Cs::isFull() const
 }
 
 bool
-Cs::eraseFromSkipList(cs::skip_list::Entry* entry)
+SkipListCs::eraseFromSkipList(cs::skip_list::Entry* entry)
 {
   NFD_LOG_TRACE("eraseFromSkipList() "  << entry->getFullName());
   NFD_LOG_TRACE("SkipList size " << size());
@@ -350,6 +474,8 @@ Cs::eraseFromSkipList(cs::skip_list::Entry* entry)
   //delete entry;
   if (isErased)
   {
+    m_nBytes -= computeEntrySize(entry->getData());
+    notifyBytesInUse(m_nBytes);
     entry->release();
     m_freeCsEntries.push(entry);
     m_nPackets--;
@@ -359,7 +485,7 @@ Cs::eraseFromSkipList(cs::skip_list::Entry* entry)
 }
 
 bool
-Cs::evictItem()
+SkipListCs::evictItem()
 {
   NFD_LOG_TRACE("evictItem()");
 
@@ -404,7 +530,7 @@ Cs::evictItem()
 }
 
 const Data*
-Cs::find(const Interest& interest) const
+SkipListCs::find(const Interest& interest) const
 {
   NFD_LOG_TRACE("find() " << interest.getName());
 
@@ -472,7 +598,7 @@ Cs::find(const Interest& interest) const
 }
 
 const Data*
-Cs::selectChild(const Interest& interest, SkipListLayer::iterator startingPoint) const
+SkipListCs::selectChild(const Interest& interest, SkipListLayer::iterator startingPoint) const
 {
   BOOST_ASSERT(startingPoint != (*m_skipList.begin())->end());
 
@@ -619,7 +745,7 @@ Cs::selectChild(const Interest& interest, SkipListLayer::iterator startingPoint)
 
 bool
 Cs::doesComplyWithSelectors(const Interest& interest,
-                            cs::skip_list::Entry* entry,
+                            const cs::Entry* entry,
                             bool doesInterestContainDigest) const
 {
   NFD_LOG_TRACE("doesComplyWithSelectors()");
@@ -725,7 +851,7 @@ Cs::doesComplyWithSelectors(const Interest& interest,
 }
 
 bool
-Cs::recognizeInterestWithDigest(const Interest& interest, cs::skip_list::Entry* entry) const
+Cs::recognizeInterestWithDigest(const Interest& interest, const cs::Entry* entry) const
 {
   // only when min selector is not specified or specified with value of 0
   // and Interest's name length is exactly the length of the name of CS entry
@@ -744,7 +870,7 @@ Cs::recognizeInterestWithDigest(const Interest& interest, cs::skip_list::Entry*
 }
 
 void
-Cs::erase(const Name& exactName)
+SkipListCs::erase(const Name& exactName)
 {
   NFD_LOG_TRACE("insert() " << exactName << ", "
                 << "skipList size " << size());
@@ -829,7 +955,7 @@ Cs::erase(const Name& exactName)
 }
 
 void
-Cs::printSkipList() const
+SkipListCs::printSkipList() const
 {
   NFD_LOG_TRACE("print()");
   //start from the upper layer towards bottom
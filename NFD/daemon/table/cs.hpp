@@ -32,6 +32,8 @@
 
 #include "common.hpp"
 #include "cs-skip-list-entry.hpp"
+#include "core/memory-pool.hpp"
+#include "memory-usage.hpp"
 
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index_container.hpp>
@@ -107,13 +109,14 @@ typedef boost::multi_index_container<
 > CleanupIndex;
 
 /** \brief represents Content Store
+ *
+ *  This is the interface of Content Store implementations.
+ *  \sa SkipListCs, IndexedCs
  */
 class Cs : noncopyable
 {
 public:
-  explicit
-  Cs(size_t nMaxPackets = 10);
-
+  virtual
   ~Cs();
 
   /** \brief inserts a Data packet
@@ -124,36 +127,178 @@ public:
    *  is not placed in the Content Store
    *  \return{ whether the Data is added }
    */
-  bool
-  insert(const Data& data, bool isUnsolicited = false);
+  virtual bool
+  insert(const Data& data, bool isUnsolicited = false) = 0;
 
   /** \brief finds the best match Data for an Interest
    *  \return{ the best match, if any; otherwise 0 }
    */
-  const Data*
-  find(const Interest& interest) const;
+  virtual const Data*
+  find(const Interest& interest) const = 0;
 
   /** \brief deletes CS entry by the exact name
    */
-  void
-  erase(const Name& exactName);
+  virtual void
+  erase(const Name& exactName) = 0;
 
   /** \brief sets maximum allowed size of Content Store (in packets)
    */
-  void
-  setLimit(size_t nMaxPackets);
+  virtual void
+  setLimit(size_t nMaxPackets) = 0;
 
   /** \brief returns maximum allowed size of Content Store (in packets)
    *  \return{ number of packets that can be stored in Content Store }
    */
-  size_t
-  getLimit() const;
+  virtual size_t
+  getLimit() const = 0;
+
+  /** \brief sets maximum allowed size of Content Store (in bytes)
+   *
+   *  Each entry is charged the size of its wire-encoded Data packet plus a fixed per-entry
+   *  overhead. When an insertion would exceed the limit, entries are evicted according to
+   *  the replacement policy of the implementation.
+   *  \param nMaxBytes byte limit; zero means no byte limit
+   */
+  virtual void
+  setByteLimit(size_t nMaxBytes) = 0;
+
+  /** \brief returns maximum allowed size of Content Store (in bytes)
+   *  \return{ byte limit, or zero if the byte limit is not enforced }
+   */
+  virtual size_t
+  getByteLimit() const = 0;
+
+  /** \brief returns current size of Content Store measured in bytes
+   */
+  virtual size_t
+  getBytesInUse() const = 0;
 
   /** \brief returns current size of Content Store measured in packets
    *  \return{ number of packets located in Content Store }
    */
-  size_t
-  size() const;
+  virtual size_t
+  size() const = 0;
+
+  /** \brief returns occupancy of the pool of CS entries
+   */
+  virtual MemoryPool::Occupancy
+  getEntryPoolOccupancy() const = 0;
+
+  /** \return number of packets and bytes charged to them, including per-entry overhead
+   */
+  MemoryUsage
+  getMemoryUsage() const
+  {
+    return MemoryUsage(this->size(), this->getBytesInUse());
+  }
+
+  /** \brief invokes \p visitor for every CS entry
+   *
+   *  Visiting order is implementation-specific. \p visitor must not modify Content Store.
+   */
+  virtual void
+  forEachEntry(const function<void(const cs::Entry&)>& visitor) const = 0;
+
+  /** \brief invokes \p visitor for every CS entry, in the order of the replacement queue
+   *
+   *  Staleness is not taken into account. Inserting the entries into an empty Content Store
+   *  in visiting order, with the same unsolicited flags and remaining freshness, restores the
+   *  replacement order. \p visitor must not modify Content Store.
+   */
+  virtual void
+  forEachEntryInEvictionOrder(const function<void(const cs::Entry&)>& visitor) const = 0;
+
+public: // signals
+  /** \brief fires after the number of bytes in use has changed
+   *
+   *  The argument is the new number of bytes in use.
+   */
+  signal::Signal<Cs, size_t> afterBytesInUseChange;
+
+protected:
+  /** \brief returns number of bytes charged to an entry holding \p data
+   */
+  static size_t
+  computeEntrySize(const Data& data);
+
+  /** \brief emits afterBytesInUseChange on behalf of an implementation
+   */
+  void
+  notifyBytesInUse(size_t nBytes);
+
+  /** \brief checks if Content Store entry satisfies Interest selectors (MinSuffixComponents,
+   *  MaxSuffixComponents, Implicit Digest, MustBeFresh)
+   *  \return{ true if satisfies all selectors; false otherwise }
+   */
+  bool
+  doesComplyWithSelectors(const Interest& interest,
+                          const cs::Entry* entry,
+                          bool doesInterestContainDigest) const;
+
+  /** \brief interprets minSuffixComponent and name lengths to understand if Interest contains
+   *  implicit digest of the data
+   *  \return{ True if Interest name contains digest; False otherwise }
+   */
+  bool
+  recognizeInterestWithDigest(const Interest& interest, const cs::Entry* entry) const;
+};
+
+/** \brief represents Content Store implemented as a skip list
+ */
+class SkipListCs : public Cs
+{
+public:
+  explicit
+  SkipListCs(size_t nMaxPackets = 10);
+
+  virtual
+  ~SkipListCs();
+
+  virtual bool
+  insert(const Data& data, bool isUnsolicited = false) DECL_OVERRIDE;
+
+  virtual const Data*
+  find(const Interest& interest) const DECL_OVERRIDE;
+
+  virtual void
+  erase(const Name& exactName) DECL_OVERRIDE;
+
+  virtual void
+  setLimit(size_t nMaxPackets) DECL_OVERRIDE;
+
+  virtual size_t
+  getLimit() const DECL_OVERRIDE;
+
+  virtual void
+  setByteLimit(size_t nMaxBytes) DECL_OVERRIDE;
+
+  virtual size_t
+  getByteLimit() const DECL_OVERRIDE;
+
+  virtual size_t
+  getBytesInUse() const DECL_OVERRIDE;
+
+  virtual size_t
+  size() const DECL_OVERRIDE;
+
+  /** \brief returns occupancy of the pool of preallocated CS entries
+   *
+   *  CS entries are preallocated individually rather than carved from chunks,
+   *  so nChunks is always zero.
+   */
+  virtual MemoryPool::Occupancy
+  getEntryPoolOccupancy() const DECL_OVERRIDE;
+
+  /** \brief invokes \p visitor for every CS entry, from begin() to end()
+   */
+  virtual void
+  forEachEntry(const function<void(const cs::Entry&)>& visitor) const DECL_OVERRIDE;
+
+  /** \brief invokes \p visitor for every CS entry, in arrival order
+   */
+  virtual void
+  forEachEntryInEvictionOrder(const function<void(const cs::Entry&)>& visitor) const
+    DECL_OVERRIDE;
 
 public: // enumeration
   class const_iterator;
@@ -224,6 +369,12 @@ private:
   size_t
   pickRandomLayer() const;
 
+  /** \brief Finds the CS Entry whose full name equals \p fullName
+   *  \return{ the CS Entry, or 0 if it does not exist }
+   */
+  cs::skip_list::Entry*
+  findExactFullName(const Name& fullName) const;
+
   /** \brief Inserts a new Content Store Entry in a skip list
    *  \return{ returns a pair containing a pointer to the CS Entry,
    *  and a flag indicating if the entry was newly created (True) or refreshed (False) }
@@ -257,88 +408,74 @@ private:
   const Data*
   selectChild(const Interest& interest, SkipListLayer::iterator startingPoint) const;
 
-  /** \brief checks if Content Store entry satisfies Interest selectors (MinSuffixComponents,
-   *  MaxSuffixComponents, Implicit Digest, MustBeFresh)
-   *  \return{ true if satisfies all selectors; false otherwise }
-   */
-  bool
-  doesComplyWithSelectors(const Interest& interest,
-                          cs::skip_list::Entry* entry,
-                          bool doesInterestContainDigest) const;
-
-  /** \brief interprets minSuffixComponent and name lengths to understand if Interest contains
-   *  implicit digest of the data
-   *  \return{ True if Interest name contains digest; False otherwise }
-   */
-  bool
-  recognizeInterestWithDigest(const Interest& interest, cs::skip_list::Entry* entry) const;
-
 private:
   SkipList m_skipList;
   CleanupIndex m_cleanupIndex;
   size_t m_nMaxPackets; // user defined maximum size of the Content Store in packets
   size_t m_nPackets;    // current number of packets in Content Store
+  size_t m_nMaxBytes;   // user defined maximum size of the Content Store in bytes, 0 if unlimited
+  size_t m_nBytes;      // current number of bytes charged to entries in Content Store
   std::queue<cs::skip_list::Entry*> m_freeCsEntries; // memory pool
 };
 
-inline Cs::const_iterator
-Cs::begin() const
+inline SkipListCs::const_iterator
+SkipListCs::begin() const
 {
   return const_iterator(m_skipList.front()->begin());
 }
 
-inline Cs::const_iterator
-Cs::end() const
+inline SkipListCs::const_iterator
+SkipListCs::end() const
 {
   return const_iterator(m_skipList.front()->end());
 }
 
 inline
-Cs::const_iterator::const_iterator(SkipListLayer::const_iterator it)
+SkipListCs::const_iterator::const_iterator(SkipListLayer::const_iterator it)
   : m_skipListIterator(it)
 {
 }
 
 inline
-Cs::const_iterator::~const_iterator()
+SkipListCs::const_iterator::~const_iterator()
 {
 }
 
-inline Cs::const_iterator&
-Cs::const_iterator::operator++()
+inline SkipListCs::const_iterator&
+SkipListCs::const_iterator::operator++()
 {
   ++m_skipListIterator;
   return *this;
 }
 
-inline Cs::const_iterator
-Cs::const_iterator::operator++(int)
+inline SkipListCs::const_iterator
+SkipListCs::const_iterator::operator++(int)
 {
-  Cs::const_iterator temp(*this);
+  SkipListCs::const_iterator temp(*this);
   ++(*this);
   return temp;
 }
 
-inline Cs::const_iterator::reference
-Cs::const_iterator::operator*() const
+inline SkipListCs::const_iterator::reference
+SkipListCs::const_iterator::operator*() const
 {
   return *(this->operator->());
 }
 
-inline Cs::const_iterator::pointer
-Cs::const_iterator::operator->() const
+inline SkipListCs::const_iterator::pointer
+SkipListCs::const_iterator::operator->() const
 {
   return *m_skipListIterator;
 }
 
 inline bool
-Cs::const_iterator::operator==(const Cs::const_iterator& other) const
+SkipListCs::const_iterator::operator==(const SkipListCs::const_iterator& other) const
 {
   return m_skipListIterator == other.m_skipListIterator;
 }
 
 inline bool
-Cs::const_iterator::operator!=(const Cs::const_iterator& other) const
+SkipListCs::const_iterator::operator!=(const SkipListCs::const_iterator& other) const
 {
   return !(*this == other);
 }
@@ -42,8 +42,9 @@ const double DeadNonceList::CAPACITY_UP = 1.2;
 const double DeadNonceList::CAPACITY_DOWN = 0.9;
 const size_t DeadNonceList::EVICT_LIMIT = (1 << 6);
 
-DeadNonceList::DeadNonceList(const time::nanoseconds& lifetime)
-  : m_lifetime(lifetime)
+DeadNonceList::DeadNonceList(TimerWheel& timerWheel, const time::nanoseconds& lifetime)
+  : m_timerWheel(timerWheel)
+  , m_lifetime(lifetime)
   , m_queue(m_index.get<0>())
   , m_ht(m_index.get<1>())
   , m_capacity(INITIAL_CAPACITY)
@@ -58,9 +59,9 @@ DeadNonceList::DeadNonceList(const time::nanoseconds& lifetime)
     m_queue.push_back(MARK);
   }
 
-  m_markEvent = scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
-  m_adjustCapacityEvent = scheduler::schedule(m_adjustCapacityInterval,
-                                              bind(&DeadNonceList::adjustCapacity, this));
+  m_markEvent = m_timerWheel.schedule(m_markInterval, bind(&DeadNonceList::mark, this));
+  m_adjustCapacityEvent = m_timerWheel.schedule(m_adjustCapacityInterval,
+                                                bind(&DeadNonceList::adjustCapacity, this));
 }
 
 DeadNonceList::~DeadNonceList()
@@ -86,6 +87,15 @@ DeadNonceList::size() const
   return m_queue.size() - this->countMarks();
 }
 
+MemoryUsage
+DeadNonceList::getMemoryUsage() const
+{
+  // each index node carries two links of the sequenced index and one of the hashed index
+  static const size_t NODE_SIZE = sizeof(Entry) + 3 * sizeof(void*);
+  return MemoryUsage(this->size(),
+                     m_queue.size() * NODE_SIZE + m_ht.bucket_count() * sizeof(void*));
+}
+
 bool
 DeadNonceList::has(const Name& name, uint32_t nonce) const
 {
@@ -125,7 +135,7 @@ DeadNonceList::mark()
 
   NFD_LOG_DEBUG("mark nMarks=" << nMarks);
 
-  scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
+  m_markEvent = m_timerWheel.schedule(m_markInterval, bind(&DeadNonceList::mark, this));
 }
 
 void
@@ -151,8 +161,8 @@ DeadNonceList::adjustCapacity()
 
   this->evictEntries();
 
-  m_adjustCapacityEvent = scheduler::schedule(m_adjustCapacityInterval,
-                                              bind(&DeadNonceList::adjustCapacity, this));
+  m_adjustCapacityEvent = m_timerWheel.schedule(m_adjustCapacityInterval,
+                                                bind(&DeadNonceList::adjustCapacity, this));
 }
 
 void
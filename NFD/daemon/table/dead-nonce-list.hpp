@@ -30,7 +30,8 @@
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index/hashed_index.hpp>
-#include "core/scheduler.hpp"
+#include "core/timer-wheel.hpp"
+#include "memory-usage.hpp"
 
 namespace nfd {
 
@@ -55,6 +56,7 @@ class DeadNonceList : noncopyable
 {
 public:
   /** \brief constructs the Dead Nonce List
+   *  \param timerWheel timer wheel for mark and capacity adjustment events
    *  \param lifetime duration of the expected lifetime of each nonce,
    *         must be no less than MIN_LIFETIME.
    *         This should be set to the duration in which most loops would have occured.
@@ -62,7 +64,7 @@ public:
    *  \throw std::invalid_argument if lifetime is less than MIN_LIFETIME
    */
   explicit
-  DeadNonceList(const time::nanoseconds& lifetime = DEFAULT_LIFETIME);
+  DeadNonceList(TimerWheel& timerWheel, const time::nanoseconds& lifetime = DEFAULT_LIFETIME);
 
   ~DeadNonceList();
 
@@ -83,6 +85,11 @@ public:
   size_t
   size() const;
 
+  /** \return number of stored Nonces and estimated memory footprint of the index
+   */
+  MemoryUsage
+  getMemoryUsage() const;
+
   /** \return expected lifetime
    */
   const time::nanoseconds&
@@ -139,6 +146,7 @@ public:
   static const time::nanoseconds MIN_LIFETIME;
 
 private:
+  TimerWheel& m_timerWheel;
   time::nanoseconds m_lifetime;
   Index m_index;
   Queue& m_queue;
@@ -52,6 +52,11 @@ public:
   size_t
   size() const;
 
+  /** \return number of entries and estimated memory footprint
+   */
+  MemoryUsage
+  getMemoryUsage() const;
+
 public: // lookup
   /// performs a longest prefix match
   shared_ptr<fib::Entry>
@@ -168,6 +173,13 @@ Fib::size() const
   return m_nItems;
 }
 
+inline MemoryUsage
+Fib::getMemoryUsage() const
+{
+  // next hop vectors are not counted
+  return MemoryUsage(m_nItems, m_nItems * sizeof(fib::Entry));
+}
+
 inline Fib::const_iterator
 Fib::end() const
 {
@@ -30,8 +30,9 @@
 
 namespace nfd {
 
-Measurements::Measurements(NameTree& nameTree)
+Measurements::Measurements(NameTree& nameTree, TimerWheel& timerWheel)
   : m_nameTree(nameTree)
+  , m_timerWheel(timerWheel)
   , m_nItems(0)
 {
 }
@@ -44,12 +45,13 @@ Measurements::get(name_tree::Entry& nte)
     return entry;
 
   entry = make_shared<measurements::Entry>(nte.getPrefix());
+  entry->setStrategyInfoPools(&m_strategyInfoPools);
   nte.setMeasurementsEntry(entry);
   ++m_nItems;
 
   entry->m_expiry = time::steady_clock::now() + getInitialLifetime();
-  entry->m_cleanup = scheduler::schedule(getInitialLifetime(),
-                                         bind(&Measurements::cleanup, this, ref(*entry)));
+  entry->m_cleanup = m_timerWheel.schedule(getInitialLifetime(),
+                                           bind(&Measurements::cleanup, this, ref(*entry)));
 
   return entry;
 }
@@ -127,7 +129,8 @@ Measurements::extendLifetime(measurements::Entry& entry,
 
   scheduler::cancel(entry.m_cleanup);
   entry.m_expiry = expiry;
-  entry.m_cleanup = scheduler::schedule(lifetime, bind(&Measurements::cleanup, this, ref(entry)));
+  entry.m_cleanup = m_timerWheel.schedule(lifetime,
+                                          bind(&Measurements::cleanup, this, ref(entry)));
 }
 
 void
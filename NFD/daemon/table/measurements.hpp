@@ -28,6 +28,7 @@
 
 #include "measurements-entry.hpp"
 #include "name-tree.hpp"
+#include "core/timer-wheel.hpp"
 
 namespace nfd {
 
@@ -46,8 +47,10 @@ class Entry;
 class Measurements : noncopyable
 {
 public:
-  explicit
-  Measurements(NameTree& nametree);
+  /** \param nametree the name tree that stores Measurements entries
+   *  \param timerWheel timer wheel for entry cleanup events
+   */
+  Measurements(NameTree& nametree, TimerWheel& timerWheel);
 
   /** \brief find or insert a Measurements entry for name
    */
@@ -93,6 +96,11 @@ public:
   size_t
   size() const;
 
+  /** \return number of entries and estimated memory footprint
+   */
+  MemoryUsage
+  getMemoryUsage() const;
+
 private:
   void
   cleanup(measurements::Entry& entry);
@@ -102,7 +110,9 @@ private:
 
 private:
   NameTree& m_nameTree;
+  TimerWheel& m_timerWheel;
   size_t m_nItems;
+  StrategyInfoPools m_strategyInfoPools; // StrategyInfo on Measurements entries
   static const time::nanoseconds s_defaultLifetime;
 };
 
@@ -118,6 +128,12 @@ Measurements::size() const
   return m_nItems;
 }
 
+inline MemoryUsage
+Measurements::getMemoryUsage() const
+{
+  return MemoryUsage(m_nItems, m_nItems * sizeof(measurements::Entry));
+}
+
 } // namespace nfd
 
 #endif // NFD_DAEMON_TABLE_MEASUREMENTS_HPP
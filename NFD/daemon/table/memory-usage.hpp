@@ -0,0 +1,71 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_MEMORY_USAGE_HPP
+#define NFD_DAEMON_TABLE_MEMORY_USAGE_HPP
+
+#include "common.hpp"
+#include "core/memory-pool.hpp"
+
+namespace nfd {
+
+/** \brief number of entries and estimated memory footprint of a table
+ *
+ *  Estimates are computed from entry counts and object sizes, without walking the table.
+ *  Name buffers, which are shared with packets, are not counted.
+ */
+struct MemoryUsage
+{
+  MemoryUsage(size_t nEntries = 0, size_t nBytes = 0)
+    : nEntries(nEntries)
+    , nBytes(nBytes)
+  {
+  }
+
+  MemoryUsage&
+  operator+=(const MemoryUsage& other)
+  {
+    nEntries += other.nEntries;
+    nBytes += other.nBytes;
+    return *this;
+  }
+
+  /// number of entries
+  size_t nEntries;
+  /// estimated number of bytes
+  size_t nBytes;
+};
+
+/** \return number of bytes obtained from the system by a pool with \p occupancy
+ */
+inline size_t
+getPoolBytes(const MemoryPool::Occupancy& occupancy)
+{
+  return occupancy.blockSize * (occupancy.nInUse + occupancy.nFree);
+}
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_MEMORY_USAGE_HPP
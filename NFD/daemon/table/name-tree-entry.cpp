@@ -36,17 +36,16 @@ Node::Node()
 
 Node::~Node()
 {
-  // erase the Name Tree Nodes that were created to
-  // resolve hash collisions
-  // So before erasing a single node, make sure its m_next == 0
-  // See eraseEntryIfEmpty in name-tree.cpp
-  if (m_next != 0)
-    delete m_next;
+  // Name Tree Nodes are allocated from the NameTree's node pool,
+  // so the chain of nodes that resolve hash collisions is released by NameTree
+  // See eraseEntryIfEmpty and ~NameTree in name-tree.cpp
 }
 
 Entry::Entry(const Name& name)
   : m_hash(0)
   , m_prefix(name)
+  , m_effectiveStrategy(nullptr)
+  , m_effectiveStrategyVersion(0)
 {
 }
 
@@ -96,7 +95,7 @@ Entry::erasePitEntry(shared_ptr<pit::Entry> pitEntry)
   BOOST_ASSERT(static_cast<bool>(pitEntry));
   BOOST_ASSERT(pitEntry->m_nameTreeEntry.get() == this);
 
-  std::vector<shared_ptr<pit::Entry> >::iterator it =
+  PitEntryCollection::iterator it =
     std::find(m_pitEntries.begin(), m_pitEntries.end(), pitEntry);
   BOOST_ASSERT(it != m_pitEntries.end());
 
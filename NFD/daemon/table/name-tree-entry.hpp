@@ -31,10 +31,16 @@
 #include "table/pit-entry.hpp"
 #include "table/measurements-entry.hpp"
 #include "table/strategy-choice-entry.hpp"
+#include "core/small-vector.hpp"
 
 namespace nfd {
 
 class NameTree;
+class StrategyChoice;
+
+namespace fw {
+class Strategy;
+} // namespace fw
 
 namespace name_tree {
 
@@ -42,6 +48,18 @@ namespace name_tree {
 class Node;
 class Entry;
 
+/** \brief represents the children of a Name Tree Entry
+ *
+ *  Most Name Tree Entries have few children, which are stored inline.
+ */
+typedef SmallVector<shared_ptr<Entry>, 2> ChildCollection;
+
+/** \brief represents the PIT entries attached to a Name Tree Entry
+ *
+ *  PIT entries with the same Name differ only in selectors, so there is usually only one.
+ */
+typedef SmallVector<shared_ptr<pit::Entry>, 1> PitEntryCollection;
+
 /**
  * \brief Name Tree Node Class
  */
@@ -85,7 +103,7 @@ public:
   shared_ptr<Entry>
   getParent() const;
 
-  std::vector<shared_ptr<Entry> >&
+  ChildCollection&
   getChildren();
 
   bool
@@ -110,7 +128,7 @@ public: // attached table entries
   bool
   hasPitEntries() const;
 
-  const std::vector<shared_ptr<pit::Entry> >&
+  const PitEntryCollection&
   getPitEntries() const;
 
   void
@@ -132,17 +150,23 @@ private:
   size_t m_hash;
   Name m_prefix;
   shared_ptr<Entry> m_parent;     // Pointing to the parent entry.
-  std::vector<shared_ptr<Entry> > m_children; // Children pointers.
+  ChildCollection m_children; // Children pointers.
   shared_ptr<fib::Entry> m_fibEntry;
-  std::vector<shared_ptr<pit::Entry> > m_pitEntries;
+  PitEntryCollection m_pitEntries;
   shared_ptr<measurements::Entry> m_measurementsEntry;
   shared_ptr<strategy_choice::Entry> m_strategyChoiceEntry;
 
   // get the Name Tree Node that is associated with this Name Tree Entry
   Node* m_node;
 
+  // Effective strategy resolved by StrategyChoice, valid while
+  // m_effectiveStrategyVersion equals StrategyChoice's current version
+  fw::Strategy* m_effectiveStrategy;
+  uint64_t m_effectiveStrategyVersion;
+
   // Make private members accessible by Name Tree
   friend class nfd::NameTree;
+  friend class nfd::StrategyChoice;
 };
 
 inline const Name&
@@ -175,7 +199,7 @@ Entry::setParent(shared_ptr<Entry> parent)
   m_parent = parent;
 }
 
-inline std::vector<shared_ptr<name_tree::Entry> >&
+inline ChildCollection&
 Entry::getChildren()
 {
   return m_children;
@@ -199,7 +223,7 @@ Entry::hasPitEntries() const
   return !m_pitEntries.empty();
 }
 
-inline const std::vector<shared_ptr<pit::Entry> >&
+inline const PitEntryCollection&
 Entry::getPitEntries() const
 {
   return m_pitEntries;
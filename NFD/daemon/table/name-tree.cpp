@@ -121,6 +121,7 @@ NameTree::NameTree(size_t nBuckets)
   , m_enlargeFactor(2)       // double the hash table size
   , m_shrinkLoadFactor(0.1) // less than 10% buckets loaded
   , m_shrinkFactor(0.5)     // reduce the number of buckets by half
+  , m_entryPool(make_shared<MemoryPool>())
   , m_endIterator(FULL_ENUMERATE_TYPE, *this, m_end)
 {
   m_enlargeThreshold = static_cast<size_t>(m_enlargeLoadFactor *
@@ -140,14 +141,30 @@ NameTree::~NameTree()
 {
   for (size_t i = 0; i < m_nBuckets; i++)
     {
-      if (m_buckets[i] != 0) {
-        delete m_buckets[i];
+      name_tree::Node* node = m_buckets[i];
+      while (node != 0) {
+        name_tree::Node* next = node->m_next;
+        destroyNode(node);
+        node = next;
       }
     }
 
   delete [] m_buckets;
 }
 
+name_tree::Node*
+NameTree::createNode()
+{
+  return new (m_nodePool.allocate(sizeof(name_tree::Node))) name_tree::Node();
+}
+
+void
+NameTree::destroyNode(name_tree::Node* node)
+{
+  node->~Node();
+  m_nodePool.deallocate(node);
+}
+
 // insert() is a private function, and called by only lookup()
 std::pair<shared_ptr<name_tree::Entry>, bool>
 NameTree::insert(const Name& prefix)
@@ -179,7 +196,7 @@ NameTree::insert(const Name& prefix)
 
   // If no bucket is empty occupied, we need to create a new node, and it is
   // linked from nodePrev
-  node = new name_tree::Node();
+  node = this->createNode();
   node->m_prev = nodePrev;
 
   if (nodePrev == 0)
@@ -192,7 +209,8 @@ NameTree::insert(const Name& prefix)
     }
 
   // Create a new Entry
-  shared_ptr<name_tree::Entry> entry(make_shared<name_tree::Entry>(prefix));
+  shared_ptr<name_tree::Entry> entry =
+    std::allocate_shared<name_tree::Entry>(PoolAllocator<name_tree::Entry>(m_entryPool), prefix);
   entry->setHash(hashValue);
   node->m_entry = entry; // link the Entry to its Node
   entry->m_node = node; // link the node to Entry. Used in eraseEntryIfEmpty.
@@ -338,7 +356,7 @@ NameTree::eraseEntryIfEmpty(shared_ptr<name_tree::Entry> entry)
 
       if (static_cast<bool>(parent))
         {
-          std::vector<shared_ptr<name_tree::Entry> >& parentChildrenList =
+          name_tree::ChildCollection& parentChildrenList =
             parent->getChildren();
 
           bool isFound = false;
@@ -382,7 +400,7 @@ NameTree::eraseEntryIfEmpty(shared_ptr<name_tree::Entry> entry)
       BOOST_ASSERT(node->m_next == 0);
 
       m_nItems--;
-      delete node;
+      destroyNode(node);
 
       if (static_cast<bool>(parent))
         eraseEntryIfEmpty(parent);
@@ -710,7 +728,7 @@ NameTree::const_iterator::operator++()
               // Should try to find its sibling
               shared_ptr<name_tree::Entry> parent = m_entry->getParent();
 
-              std::vector<shared_ptr<name_tree::Entry> >& parentChildrenList = parent->getChildren();
+              name_tree::ChildCollection& parentChildrenList = parent->getChildren();
               bool isFound = false;
               size_t i = 0;
               for (i = 0; i < parentChildrenList.size(); i++)
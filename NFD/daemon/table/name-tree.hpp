@@ -28,6 +28,8 @@
 
 #include "common.hpp"
 #include "name-tree-entry.hpp"
+#include "core/memory-pool.hpp"
+#include "memory-usage.hpp"
 
 namespace nfd {
 namespace name_tree {
@@ -101,6 +103,24 @@ public: // information
   size_t
   getNBuckets() const;
 
+  /**
+   * \brief Get the occupancy of the pool from which Name Tree Entries are allocated
+   */
+  MemoryPool::Occupancy
+  getEntryPoolOccupancy() const;
+
+  /**
+   * \brief Get the occupancy of the pool from which Name Tree Nodes are allocated
+   */
+  MemoryPool::Occupancy
+  getNodePoolOccupancy() const;
+
+  /**
+   * \brief Get the number of entries and the memory held by entry and node pools and buckets
+   */
+  MemoryUsage
+  getMemoryUsage() const;
+
   /**
    * \brief Dump all the information stored in the Name Tree for debugging.
    */
@@ -302,6 +322,12 @@ private:
   void
   resize(size_t newNBuckets);
 
+  name_tree::Node*
+  createNode();
+
+  void
+  destroyNode(name_tree::Node* node);
+
 private:
   size_t                        m_nItems;  // Number of items being stored
   size_t                        m_nBuckets; // Number of hash buckets
@@ -313,6 +339,8 @@ private:
   size_t                        m_shrinkThreshold;
   double                        m_shrinkFactor;
   name_tree::Node**             m_buckets; // Name Tree Buckets in the NPHT
+  shared_ptr<MemoryPool>        m_entryPool; // Name Tree Entries and their control blocks
+  MemoryPool                    m_nodePool; // Name Tree Nodes
   shared_ptr<name_tree::Entry>  m_end;
   const_iterator                m_endIterator;
 
@@ -344,6 +372,26 @@ NameTree::getNBuckets() const
   return m_nBuckets;
 }
 
+inline MemoryPool::Occupancy
+NameTree::getEntryPoolOccupancy() const
+{
+  return m_entryPool->getOccupancy();
+}
+
+inline MemoryPool::Occupancy
+NameTree::getNodePoolOccupancy() const
+{
+  return m_nodePool.getOccupancy();
+}
+
+inline MemoryUsage
+NameTree::getMemoryUsage() const
+{
+  return MemoryUsage(m_nItems, getPoolBytes(m_entryPool->getOccupancy()) +
+                               getPoolBytes(m_nodePool.getOccupancy()) +
+                               m_nBuckets * sizeof(name_tree::Node*));
+}
+
 inline shared_ptr<name_tree::Entry>
 NameTree::get(const fib::Entry& fibEntry) const
 {
@@ -133,8 +133,9 @@ Entry::insertOrUpdateInRecord(shared_ptr<Face> face, const Interest& interest)
   auto it = std::find_if(m_inRecords.begin(), m_inRecords.end(),
     [&face] (const InRecord& inRecord) { return inRecord.getFace() == face; });
   if (it == m_inRecords.end()) {
-    m_inRecords.emplace_front(face);
-    it = m_inRecords.begin();
+    m_inRecords.emplace_back(face);
+    it = m_inRecords.end() - 1;
+    it->setStrategyInfoPools(this->getStrategyInfoPools());
   }
 
   it->update(interest);
@@ -160,8 +161,9 @@ Entry::insertOrUpdateOutRecord(shared_ptr<Face> face, const Interest& interest)
   auto it = std::find_if(m_outRecords.begin(), m_outRecords.end(),
     [&face] (const OutRecord& outRecord) { return outRecord.getFace() == face; });
   if (it == m_outRecords.end()) {
-    m_outRecords.emplace_front(face);
-    it = m_outRecords.begin();
+    m_outRecords.emplace_back(face);
+    it = m_outRecords.end() - 1;
+    it->setStrategyInfoPools(this->getStrategyInfoPools());
   }
 
   it->update(interest);
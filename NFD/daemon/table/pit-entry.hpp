@@ -29,6 +29,7 @@
 #include "pit-in-record.hpp"
 #include "pit-out-record.hpp"
 #include "core/scheduler.hpp"
+#include "core/small-vector.hpp"
 
 namespace nfd {
 
@@ -41,12 +42,18 @@ class Entry;
 namespace pit {
 
 /** \brief represents an unordered collection of InRecords
+ *
+ *  Most PIT entries have one or two InRecords, which are stored inline.
+ *  \note Inserting or deleting an InRecord invalidates iterators to other InRecords.
  */
-typedef std::list< InRecord>  InRecordCollection;
+typedef SmallVector<InRecord, 2> InRecordCollection;
 
 /** \brief represents an unordered collection of OutRecords
+ *
+ *  Most PIT entries have one OutRecord, which is stored inline.
+ *  \note Inserting or deleting an OutRecord invalidates iterators to other OutRecords.
  */
-typedef std::list<OutRecord> OutRecordCollection;
+typedef SmallVector<OutRecord, 1> OutRecordCollection;
 
 /** \brief indicates where duplicate Nonces are found
  */
@@ -54,6 +54,7 @@ BOOST_CONCEPT_ASSERT((boost::DefaultConstructible<Pit::const_iterator>));
 Pit::Pit(NameTree& nameTree)
   : m_nameTree(nameTree)
   , m_nItems(0)
+  , m_entryPool(make_shared<MemoryPool>())
 {
 }
 
@@ -69,7 +70,7 @@ Pit::insert(const Interest& interest)
   shared_ptr<name_tree::Entry> nameTreeEntry = m_nameTree.lookup(interest.getName());
   BOOST_ASSERT(static_cast<bool>(nameTreeEntry));
 
-  const std::vector<shared_ptr<pit::Entry>>& pitEntries = nameTreeEntry->getPitEntries();
+  const name_tree::PitEntryCollection& pitEntries = nameTreeEntry->getPitEntries();
 
   // then check if this Interest is already in the PIT entries
   auto it = std::find_if(pitEntries.begin(), pitEntries.end(),
@@ -81,7 +82,9 @@ Pit::insert(const Interest& interest)
     return { *it, false };
   }
 
-  shared_ptr<pit::Entry> entry = make_shared<pit::Entry>(interest);
+  shared_ptr<pit::Entry> entry =
+    std::allocate_shared<pit::Entry>(PoolAllocator<pit::Entry>(m_entryPool), interest);
+  entry->setStrategyInfoPools(&m_strategyInfoPools);
   nameTreeEntry->insertPitEntry(entry);
   m_nItems++;
   return { entry, true };
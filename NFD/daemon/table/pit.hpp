@@ -58,6 +58,11 @@ public:
   size_t
   size() const;
 
+  /** \return number of entries and estimated memory footprint
+   */
+  MemoryUsage
+  getMemoryUsage() const;
+
   /** \brief inserts a PIT entry for Interest
    *
    *  If an entry for exact same name and selectors exists, that entry is returned.
@@ -78,6 +83,11 @@ public:
   void
   erase(shared_ptr<pit::Entry> pitEntry);
 
+  /** \brief get the occupancy of the pool from which PIT entries are allocated
+   */
+  MemoryPool::Occupancy
+  getEntryPoolOccupancy() const;
+
 public: // enumeration
   class const_iterator;
 
@@ -137,6 +147,8 @@ public: // enumeration
 private:
   NameTree& m_nameTree;
   size_t m_nItems;
+  shared_ptr<MemoryPool> m_entryPool; // PIT entries and their control blocks
+  StrategyInfoPools m_strategyInfoPools; // StrategyInfo on PIT entries and their records
 };
 
 inline size_t
@@ -145,6 +157,19 @@ Pit::size() const
   return m_nItems;
 }
 
+inline MemoryUsage
+Pit::getMemoryUsage() const
+{
+  // in-records and out-records are stored inline in entries, except for overflow
+  return MemoryUsage(m_nItems, getPoolBytes(m_entryPool->getOccupancy()));
+}
+
+inline MemoryPool::Occupancy
+Pit::getEntryPoolOccupancy() const
+{
+  return m_entryPool->getOccupancy();
+}
+
 inline Pit::const_iterator
 Pit::end() const
 {
@@ -39,6 +39,7 @@ NFD_LOG_INIT("StrategyChoice");
 StrategyChoice::StrategyChoice(NameTree& nameTree, shared_ptr<Strategy> defaultStrategy)
   : m_nameTree(nameTree)
   , m_nItems(0)
+  , m_version(1)
 {
   this->setDefaultStrategy(defaultStrategy);
 }
@@ -118,6 +119,7 @@ StrategyChoice::insert(const Name& prefix, const Name& strategyName)
 
   this->changeStrategy(*entry, *oldStrategy, *strategy);
   entry->setStrategy(*strategy);
+  this->invalidateEffectiveStrategies();
   return true;
 }
 
@@ -144,6 +146,7 @@ StrategyChoice::erase(const Name& prefix)
   nte->setStrategyChoiceEntry(shared_ptr<Entry>());
   m_nameTree.eraseEntryIfEmpty(nte);
   --m_nItems;
+  this->invalidateEffectiveStrategies();
 }
 
 std::pair<bool, Name>
@@ -177,17 +180,29 @@ StrategyChoice::findEffectiveStrategy(const Name& prefix) const
 Strategy&
 StrategyChoice::findEffectiveStrategy(shared_ptr<name_tree::Entry> nte) const
 {
+  if (nte->m_effectiveStrategyVersion == m_version) {
+    BOOST_ASSERT(nte->m_effectiveStrategy != nullptr);
+    return *nte->m_effectiveStrategy;
+  }
+
+  Strategy* strategy = nullptr;
   shared_ptr<strategy_choice::Entry> entry = nte->getStrategyChoiceEntry();
-  if (static_cast<bool>(entry))
-    return entry->getStrategy();
+  if (static_cast<bool>(entry)) {
+    strategy = &entry->getStrategy();
+  }
+  else {
+    shared_ptr<name_tree::Entry> match = m_nameTree.findLongestPrefixMatch(nte,
+      [] (const name_tree::Entry& entry) {
+        return static_cast<bool>(entry.getStrategyChoiceEntry());
+      });
 
-  nte = m_nameTree.findLongestPrefixMatch(nte,
-    [] (const name_tree::Entry& entry) {
-      return static_cast<bool>(entry.getStrategyChoiceEntry());
-    });
+    BOOST_ASSERT(static_cast<bool>(match));
+    strategy = &match->getStrategyChoiceEntry()->getStrategy();
+  }
 
-  BOOST_ASSERT(static_cast<bool>(nte));
-  return nte->getStrategyChoiceEntry()->getStrategy();
+  nte->m_effectiveStrategy = strategy;
+  nte->m_effectiveStrategyVersion = m_version;
+  return *strategy;
 }
 
 Strategy&
@@ -222,6 +237,14 @@ StrategyChoice::setDefaultStrategy(shared_ptr<Strategy> strategy)
   NFD_LOG_INFO("setDefaultStrategy " << strategy->getName());
 
   entry->setStrategy(*strategy);
+  this->invalidateEffectiveStrategies();
+}
+
+void
+StrategyChoice::invalidateEffectiveStrategies()
+{
+  ++m_version;
+  NFD_LOG_TRACE("invalidateEffectiveStrategies version=" << m_version);
 }
 
 static inline void
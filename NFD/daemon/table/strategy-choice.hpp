@@ -137,6 +137,11 @@ public: // enumeration
   size_t
   size() const;
 
+  /** \return number of entries and estimated memory footprint
+   */
+  MemoryUsage
+  getMemoryUsage() const;
+
   const_iterator
   begin() const;
 
@@ -161,10 +166,24 @@ private:
   fw::Strategy&
   findEffectiveStrategy(shared_ptr<name_tree::Entry> nte) const;
 
+  /** \brief invalidate effective strategies cached on NameTree entries
+   *
+   *  Must be called whenever the effective strategy of any prefix may have changed.
+   */
+  void
+  invalidateEffectiveStrategies();
+
 private:
   NameTree& m_nameTree;
   size_t m_nItems;
 
+  /** \brief generation counter for effective strategies cached on NameTree entries
+   *
+   *  A cached effective strategy is valid only if it was resolved at current version.
+   *  Version 0 is never used, so that newly created NameTree entries are invalid.
+   */
+  uint64_t m_version;
+
   typedef std::map<Name, shared_ptr<fw::Strategy> > StrategyInstanceTable;
   StrategyInstanceTable m_strategyInstances;
 };
@@ -175,6 +194,12 @@ StrategyChoice::size() const
   return m_nItems;
 }
 
+inline MemoryUsage
+StrategyChoice::getMemoryUsage() const
+{
+  return MemoryUsage(m_nItems, m_nItems * sizeof(strategy_choice::Entry));
+}
+
 inline StrategyChoice::const_iterator
 StrategyChoice::end() const
 {
@@ -27,6 +27,19 @@
 
 namespace nfd {
 
+const shared_ptr<MemoryPool>&
+StrategyInfoPools::get(int typeId)
+{
+  for (const auto& pool : m_pools) {
+    if (pool.first == typeId) {
+      return pool.second;
+    }
+  }
+
+  m_pools.emplace_back(typeId, make_shared<MemoryPool>());
+  return m_pools.back().second;
+}
+
 void
 StrategyInfoHost::clearStrategyInfo()
 {
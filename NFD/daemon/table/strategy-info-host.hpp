@@ -27,14 +27,39 @@
 #define NFD_DAEMON_TABLE_STRATEGY_INFO_HOST_HPP
 
 #include "fw/strategy-info.hpp"
+#include "core/small-vector.hpp"
+#include "core/memory-pool.hpp"
 
 namespace nfd {
 
+/** \brief memory pools from which StrategyInfo items are allocated
+ *
+ *  Each table hosting StrategyInfo items owns one instance, so that items placed by
+ *  different forwarders never share a pool.
+ */
+class StrategyInfoPools : noncopyable
+{
+public:
+  /** \return memory pool for StrategyInfo type with \p typeId
+   */
+  const shared_ptr<MemoryPool>&
+  get(int typeId);
+
+private:
+  std::vector<std::pair<int, shared_ptr<MemoryPool>>> m_pools;
+};
+
 /** \brief base class for an entity onto which StrategyInfo objects may be placed
+ *
+ *  Items are stored together with their type ID in a small array and found by linear search.
+ *  If the host is attached to StrategyInfoPools, new items are allocated from the pool of
+ *  their type; otherwise, they are allocated from the heap.
  */
 class StrategyInfoHost
 {
 public:
+  StrategyInfoHost();
+
   /** \brief get a StrategyInfo item
    *  \tparam T type of StrategyInfo, must be a subclass of from nfd::fw::StrategyInfo
    *  \retval nullptr if no StrategyInfo of type T is stored
@@ -65,10 +90,50 @@ public:
   void
   clearStrategyInfo();
 
+  /** \brief attach to pools from which getOrCreateStrategyInfo allocates new items
+   *  \param pools the pools, or nullptr to allocate from the heap;
+   *               must remain valid while items are being created on this host
+   */
+  void
+  setStrategyInfoPools(StrategyInfoPools* pools);
+
+  StrategyInfoPools*
+  getStrategyInfoPools() const;
+
+private:
+  struct Item
+  {
+    int typeId;
+    shared_ptr<fw::StrategyInfo> info;
+  };
+
 private:
-  std::map<int, shared_ptr<fw::StrategyInfo>> m_items;
+  /** \brief StrategyInfo items with their type IDs
+   *
+   *  Entries typically hold items of one or two strategies, which fit in inline storage
+   *  regardless of how many StrategyInfo types exist in the process.
+   */
+  SmallVector<Item, 2> m_items;
+  StrategyInfoPools* m_pools;
 };
 
+inline
+StrategyInfoHost::StrategyInfoHost()
+  : m_pools(nullptr)
+{
+}
+
+inline void
+StrategyInfoHost::setStrategyInfoPools(StrategyInfoPools* pools)
+{
+  m_pools = pools;
+}
+
+inline StrategyInfoPools*
+StrategyInfoHost::getStrategyInfoPools() const
+{
+  return m_pools;
+}
 
 template<typename T>
 shared_ptr<T>
@@ -77,25 +142,35 @@ StrategyInfoHost::getStrategyInfo() const
   static_assert(std::is_base_of<fw::StrategyInfo, T>::value,
                 "T must inherit from StrategyInfo");
 
-  auto it = m_items.find(T::getTypeId());
-  if (it == m_items.end()) {
-    return nullptr;
+  for (const Item& item : m_items) {
+    if (item.typeId == T::getTypeId()) {
+      return static_pointer_cast<T, fw::StrategyInfo>(item.info);
+    }
   }
-  return static_pointer_cast<T, fw::StrategyInfo>(it->second);
+  return nullptr;
 }
 
 template<typename T>
 void
-StrategyInfoHost::setStrategyInfo(shared_ptr<T> item)
+StrategyInfoHost::setStrategyInfo(shared_ptr<T> info)
 {
   static_assert(std::is_base_of<fw::StrategyInfo, T>::value,
                 "T must inherit from StrategyInfo");
 
-  if (item == nullptr) {
-    m_items.erase(T::getTypeId());
+  for (auto it = m_items.begin(); it != m_items.end(); ++it) {
+    if (it->typeId == T::getTypeId()) {
+      if (info == nullptr) {
+        m_items.erase(it);
+      }
+      else {
+        it->info = info;
+      }
+      return;
+    }
   }
-  else {
-    m_items[T::getTypeId()] = item;
+
+  if (info != nullptr) {
+    m_items.push_back(Item{T::getTypeId(), info});
   }
 }
 
@@ -108,7 +183,13 @@ StrategyInfoHost::getOrCreateStrategyInfo(A&&... args)
 
   shared_ptr<T> item = this->getStrategyInfo<T>();
   if (!static_cast<bool>(item)) {
-    item = make_shared<T>(std::forward<A>(args)...);
+    if (m_pools != nullptr) {
+      item = std::allocate_shared<T>(PoolAllocator<T>(m_pools->get(T::getTypeId())),
+                                     std::forward<A>(args)...);
+    }
+    else {
+      item = make_shared<T>(std::forward<A>(args)...);
+    }
     this->setStrategyInfo(item);
   }
   return item;
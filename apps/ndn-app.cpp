@@ -98,6 +98,12 @@ App::OnData(shared_ptr<const Data> data)
   m_receivedDatas(data, this, m_face);
 }
 
+uint64_t
+App::GetBufferedBytes() const
+{
+  return 0;
+}
+
 // Application Methods
 void
 App::StartApplication() // Called at time specified by Start
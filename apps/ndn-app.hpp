@@ -80,6 +80,15 @@ public:
   virtual void
   OnData(shared_ptr<const Data> data);
 
+  /**
+   * @brief Get estimated number of bytes held by application buffers (e.g., per-sequence state
+   *        or received file content)
+   *
+   * Applications without significant buffers report 0.
+   */
+  virtual uint64_t
+  GetBufferedBytes() const;
+
 protected:
   /**
    * @brief Do cleanup when application is destroyed
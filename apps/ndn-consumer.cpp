@@ -265,6 +265,18 @@ Consumer::OnTimeout(uint32_t sequenceNumber)
   ScheduleNextPacket();
 }
 
+uint64_t
+Consumer::GetBufferedBytes() const
+{
+  // tree nodes carry three links and a color per ordered index
+  static const size_t TREE_NODE_OVERHEAD = 4 * sizeof(void*);
+  static const size_t SEQ_TIMEOUT_NODE = sizeof(SeqTimeout) + 2 * TREE_NODE_OVERHEAD;
+
+  return m_retxSeqs.size() * (sizeof(uint32_t) + TREE_NODE_OVERHEAD)
+         + (m_seqTimeouts.size() + m_seqLastDelay.size() + m_seqFullDelay.size()) * SEQ_TIMEOUT_NODE
+         + m_seqRetxCounts.size() * (2 * sizeof(uint32_t) + TREE_NODE_OVERHEAD);
+}
+
 void
 Consumer::WillSendOutInterest(uint32_t sequenceNumber)
 {
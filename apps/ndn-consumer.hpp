@@ -70,6 +70,10 @@ public:
   virtual void
   OnTimeout(uint32_t sequenceNumber);
 
+  // From App
+  virtual uint64_t
+  GetBufferedBytes() const;
+
   /**
    * @brief Actually send packet
    */
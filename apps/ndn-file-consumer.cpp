@@ -201,6 +201,21 @@ FileConsumer::StopApplication() // Called at time specified by Stop
   App::StopApplication();
 }
 
+uint64_t
+FileConsumer::GetBufferedBytes() const
+{
+  static const size_t TREE_NODE_OVERHEAD = 4 * sizeof(void*);
+
+  uint64_t nBytes = m_sequenceStatus.capacity() * sizeof(SequenceStatus)
+                    + m_chunkTimeoutEvents.size() * (sizeof(uint32_t) + sizeof(EventId)
+                                                     + TREE_NODE_OVERHEAD)
+                    + m_sequenceSendTime.size() * (sizeof(uint32_t) + sizeof(long)
+                                                   + TREE_NODE_OVERHEAD);
+  if (m_localDataCache != NULL)
+    nBytes += m_fileSize;
+  return nBytes;
+}
+
 
 bool
 FileConsumer::SendPacket()
@@ -81,6 +81,9 @@ public:
   virtual void
   StopApplication();
 
+  virtual uint64_t
+  GetBufferedBytes() const;
+
   enum SequenceStatus { NotRequested = 0, Requested = 1, TimedOut = 2, Received = 3 };
 
 protected:
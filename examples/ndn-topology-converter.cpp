@@ -0,0 +1,104 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-topology-converter.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/topology/rocketfuel-map-reader.hpp"
+
+namespace ns3 {
+
+/**
+ * This program converts an annotated topology file or a Rocketfuel map (.cch) into the binary
+ * topology format, which AnnotatedTopologyReader::Read loads much faster:
+ *
+ *     ./waf --run "ndn-topology-converter --input=topo.txt --output=topo.bin"
+ *     ./waf --run "ndn-topology-converter --format=rocketfuel --input=1755.cch --output=1755.bin"
+ *
+ * Link bandwidths and delays that RocketfuelMapReader assigns randomly are stored in the binary
+ * file, so every simulation that loads it uses the same values.
+ */
+
+int
+main(int argc, char* argv[])
+{
+  std::string format = "annotated";
+  std::string input;
+  std::string output;
+  double scale = 1.0;
+
+  CommandLine cmd;
+  cmd.AddValue("format", "Format of the input file (annotated or rocketfuel)", format);
+  cmd.AddValue("input", "Input topology file", input);
+  cmd.AddValue("output", "Output binary topology file", output);
+  cmd.AddValue("scale", "Scaling factor for coordinates of annotated topology", scale);
+  cmd.Parse(argc, argv);
+
+  if (input.empty() || output.empty()) {
+    std::cerr << "--input and --output are required" << std::endl;
+    return 1;
+  }
+
+  if (format == "rocketfuel") {
+    RocketfuelParams params;
+    params.averageRtt = 2; // s
+    params.clientNodeDegrees = 2;
+    params.minb2bBandwidth = "40Mbps";
+    params.maxb2bBandwidth = "100Mbps";
+    params.minb2bDelay = "5ms";
+    params.maxb2bDelay = "10ms";
+    params.minb2gBandwidth = "10Mbps";
+    params.maxb2gBandwidth = "20Mbps";
+    params.minb2gDelay = "5ms";
+    params.maxb2gDelay = "10ms";
+    params.ming2cBandwidth = "1Mbps";
+    params.maxg2cBandwidth = "3Mbps";
+    params.ming2cDelay = "10ms";
+    params.maxg2cDelay = "70ms";
+
+    RocketfuelMapReader reader;
+    reader.SetFileName(input);
+    reader.Read(params);
+    reader.SaveBinaryTopology(output);
+  }
+  else if (format == "annotated") {
+    AnnotatedTopologyReader reader("", scale);
+    reader.SetFileName(input);
+    reader.Read();
+    reader.SaveBinaryTopology(output);
+  }
+  else {
+    std::cerr << "Unknown format " << format << std::endl;
+    return 1;
+  }
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
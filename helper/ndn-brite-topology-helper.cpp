@@ -27,7 +27,9 @@
 #include "ns3/rng-seed-manager.h"
 
 #include "ndn-brite-topology-helper.hpp"
+#include "ndn-topology-partitioner.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 
@@ -407,23 +409,27 @@ NDNBriteTopologyHelper::BuildBriteTopology ()
 void
 NDNBriteTopologyHelper::BuildBriteTopology (const uint32_t systemCount)
 {
-  NS_LOG_FUNCTION (this);
+  BuildBriteTopology (systemCount, std::vector<uint32_t> ());
+}
+
+void
+NDNBriteTopologyHelper::BuildBriteTopology (const uint32_t systemCount,
+                                            const std::vector<uint32_t>& clientsPerAs,
+                                            double clientWeight)
+{
+  NS_LOG_FUNCTION (this << systemCount << clientWeight);
+  NS_ASSERT_MSG (systemCount > 0, "At least one MPI instance is required");
 
   GenerateBriteTopology ();
 
-  //determine as system number for each AS
-  NS_LOG_LOGIC ("Assigning << " << m_numAs << " AS to " << systemCount << " MPI instances");
-  for (uint32_t i = 0; i < m_numAs; ++i)
-    {
-      int val = i % systemCount;
-      m_systemForAs.push_back (val);
-      NS_LOG_INFO ("AS: " << i << " System: " << val);
-    }
+  //determine system number for each node
+  NS_LOG_LOGIC ("Assigning " << m_briteNodeInfoList.size () << " nodes to " << systemCount << " MPI instances");
+  std::vector<uint32_t> systemForNode = PartitionBriteTopology (systemCount, clientsPerAs, clientWeight);
 
   //create nodes
-  for (NDNBriteTopologyHelper::BriteNodeInfoList::iterator it = m_briteNodeInfoList.begin (); it != m_briteNodeInfoList.end (); ++it)
+  for (uint32_t i = 0; i < m_briteNodeInfoList.size (); ++i)
     {
-      m_nodes.Add (CreateObject<Node> (GetSystemNumberForAs ((*it).asId)));
+      m_nodes.Add (CreateObject<Node> (systemForNode[i]));
       m_numNodes++;
     }
 
@@ -432,6 +438,72 @@ NDNBriteTopologyHelper::BuildBriteTopology (const uint32_t systemCount)
   ConstructTopology ();
 }
 
+std::vector<uint32_t>
+NDNBriteTopologyHelper::PartitionBriteTopology (uint32_t systemCount,
+                                                const std::vector<uint32_t>& clientsPerAs,
+                                                double clientWeight)
+{
+  NS_LOG_FUNCTION (this << systemCount);
+
+  //clients attach to leaf routers, or to any router of an AS without leaf routers
+  std::vector<uint32_t> nNodes (m_numAs, 0);
+  std::vector<uint32_t> nLeafNodes (m_numAs, 0);
+  for (NDNBriteTopologyHelper::BriteNodeInfoList::iterator it = m_briteNodeInfoList.begin (); it != m_briteNodeInfoList.end (); ++it)
+    {
+      nNodes[(*it).asId]++;
+      if ((*it).type == "RT_LEAF ")
+        {
+          nLeafNodes[(*it).asId]++;
+        }
+    }
+
+  //node weight is 1 per router plus the weighted share of clients expected on it
+  TopologyPartitioner partitioner;
+  for (NDNBriteTopologyHelper::BriteNodeInfoList::iterator it = m_briteNodeInfoList.begin (); it != m_briteNodeInfoList.end (); ++it)
+    {
+      uint32_t asId = (*it).asId;
+      double clients = 0;
+      if (asId < clientsPerAs.size ())
+        {
+          if (nLeafNodes[asId] == 0)
+            {
+              clients = static_cast<double> (clientsPerAs[asId]) / nNodes[asId];
+            }
+          else if ((*it).type == "RT_LEAF ")
+            {
+              clients = static_cast<double> (clientsPerAs[asId]) / nLeafNodes[asId];
+            }
+        }
+      partitioner.AddVertex (1.0 + clientWeight * clients, asId);
+    }
+
+  for (NDNBriteTopologyHelper::BriteEdgeInfoList::iterator it = m_briteEdgeInfoList.begin (); it != m_briteEdgeInfoList.end (); ++it)
+    {
+      partitioner.AddEdge ((*it).srcId, (*it).destId);
+    }
+
+  std::vector<uint32_t> systemForNode = partitioner.Partition (systemCount);
+
+  NS_LOG_INFO (partitioner.GetCutWeight (systemForNode) << " of " << m_briteEdgeInfoList.size ()
+               << " links cross MPI instances");
+
+  //system number of an AS is the one holding most of its nodes
+  std::vector<std::vector<uint32_t> > nodesOnSystem (m_numAs, std::vector<uint32_t> (systemCount, 0));
+  for (uint32_t i = 0; i < m_briteNodeInfoList.size (); ++i)
+    {
+      nodesOnSystem[m_briteNodeInfoList[i].asId][systemForNode[i]]++;
+    }
+
+  m_systemForAs.clear ();
+  for (uint32_t i = 0; i < m_numAs; ++i)
+    {
+      int val = std::max_element (nodesOnSystem[i].begin (), nodesOnSystem[i].end ()) - nodesOnSystem[i].begin ();
+      m_systemForAs.push_back (val);
+      NS_LOG_INFO ("AS: " << i << " System: " << val);
+    }
+
+  return systemForNode;
+}
 
 void
 NDNBriteTopologyHelper::ConstructTopology ()
@@ -100,11 +100,31 @@ public:
   /**
    * Create NS3 topology using information generated from BRITE and configure topology for MPI use.
    *
+   * Nodes are assigned to MPI instances with TopologyPartitioner, which balances the number of
+   * nodes per instance and keeps each AS on a single instance unless it is too large for one.
+   *
    * \param systemCount The number of MPI instances to be used in the simulation.
    *
    */
   void BuildBriteTopology (const uint32_t systemCount);
 
+  /**
+   * Create NS3 topology using information generated from BRITE and configure topology for MPI
+   * use, taking the expected number of clients (e.g., DASH consumers) in each AS into account.
+   *
+   * Clients of an AS are expected to run on, or be attached to, its leaf routers (any of its
+   * routers if the AS has no leaf routers) and are spread evenly among them.  The load of a
+   * router is 1 plus clientWeight times its share of clients.  Client nodes created
+   * outside of the helper should use the system number of the router they are attached to.
+   *
+   * \param systemCount The number of MPI instances to be used in the simulation.
+   * \param clientsPerAs Expected number of clients in each AS, indexed by AS number; missing
+   *        entries mean no clients.
+   * \param clientWeight Load of one client relative to the load of one router.
+   */
+  void BuildBriteTopology (const uint32_t systemCount, const std::vector<uint32_t>& clientsPerAs,
+                           double clientWeight = 1.0);
+
   /**
    * Returns the number of router leaf nodes for a given AS
    *
@@ -167,7 +187,8 @@ public:
   uint32_t GetNAs (void) const;
 
   /**
-    * Returns the system number for the MPI instance that this AS is assigned to.  Will always return 0 if MPI not used
+    * Returns the system number for the MPI instance that this AS is assigned to.  Will always return 0 if MPI not used.
+    * If the AS had to be split between several instances, the instance with most of its nodes is returned.
     *
     * \returns The system number that the specified AS number belongs to
     *
@@ -257,6 +278,17 @@ private:
     */
   void GenerateBriteTopology (void);
 
+  /**
+    * \internal
+    *
+    * Assign BRITE nodes to MPI instances and fill m_systemForAs
+    *
+    * \returns system number of every node in m_briteNodeInfoList
+    */
+  std::vector<uint32_t> PartitionBriteTopology (uint32_t systemCount,
+                                                const std::vector<uint32_t>& clientsPerAs,
+                                                double clientWeight);
+
   /// brite configuration file to use
   std::string m_confFile;
 
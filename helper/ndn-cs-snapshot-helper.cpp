@@ -0,0 +1,304 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-cs-snapshot-helper.hpp"
+
+#include "ns3/log.h"
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+
+#include "model/ndn-l3-protocol.hpp"
+#include "model/cs/ndn-content-store.hpp"
+
+#include "fw/forwarder.hpp"
+#include "table/cs.hpp"
+
+#include <algorithm>
+#include <fstream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.CsSnapshotHelper");
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+// File layout (all integers are big-endian):
+//
+//   "NCSS" version(1) flags(1)
+//   { nodeId(4) nEntries(4) { entryFlags(1) freshness(4) entry } * nEntries } until end of file
+//
+// Entries of a node are in eviction order (first evicted first).  freshness is the freshness
+// period left at the time of the snapshot in milliseconds, or NO_FRESHNESS if Data has no
+// freshness period.  entry is either Data TLV (snapshot with payloads), or Name TLV and payload
+// size(4).  Each TLV is preceded by its length(4).
+
+const char MAGIC[] = {'N', 'C', 'S', 'S'};
+const uint8_t VERSION = 2;
+
+const uint8_t SNAPSHOT_WITH_PAYLOADS = 0x01;
+const uint8_t ENTRY_UNSOLICITED = 0x01;
+const uint32_t NO_FRESHNESS = 0xFFFFFFFF;
+
+struct SnapshotEntry
+{
+  shared_ptr<const Data> data;
+  bool isUnsolicited;
+  uint32_t freshness;
+};
+
+/**
+ * @brief Encode freshness field of an entry that stays fresh for @p leftMs milliseconds
+ */
+uint32_t
+encodeFreshness(const Data& data, int64_t leftMs)
+{
+  if (data.getFreshnessPeriod() < time::milliseconds::zero())
+    return NO_FRESHNESS;
+
+  return static_cast<uint32_t>(std::max<int64_t>(leftMs, 0));
+}
+
+void
+writeUint8(std::ostream& os, uint8_t value)
+{
+  os.put(static_cast<char>(value));
+}
+
+void
+writeUint32(std::ostream& os, uint32_t value)
+{
+  char bytes[] = {static_cast<char>(value >> 24), static_cast<char>(value >> 16),
+                  static_cast<char>(value >> 8), static_cast<char>(value)};
+  os.write(bytes, sizeof(bytes));
+}
+
+void
+writeBlock(std::ostream& os, const Block& block)
+{
+  writeUint32(os, block.size());
+  os.write(reinterpret_cast<const char*>(block.wire()), block.size());
+}
+
+uint8_t
+readUint8(std::istream& is)
+{
+  return static_cast<uint8_t>(is.get());
+}
+
+uint32_t
+readUint32(std::istream& is)
+{
+  unsigned char bytes[4] = {0};
+  is.read(reinterpret_cast<char*>(bytes), sizeof(bytes));
+  return (static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16)
+         | (static_cast<uint32_t>(bytes[2]) << 8) | static_cast<uint32_t>(bytes[3]);
+}
+
+Block
+readBlock(std::istream& is)
+{
+  uint32_t size = readUint32(is);
+  auto buffer = make_shared< ::ndn::Buffer>(size);
+  is.read(reinterpret_cast<char*>(buffer->buf()), size);
+  if (!is) {
+    NS_FATAL_ERROR("Content store snapshot is truncated");
+  }
+  return Block(buffer);
+}
+
+void
+writeEntry(std::ostream& os, const SnapshotEntry& entry, bool withPayloads)
+{
+  writeUint8(os, entry.isUnsolicited ? ENTRY_UNSOLICITED : 0);
+  writeUint32(os, entry.freshness);
+
+  if (withPayloads) {
+    writeBlock(os, entry.data->wireEncode());
+  }
+  else {
+    writeBlock(os, entry.data->getName().wireEncode());
+    writeUint32(os, entry.data->getContent().value_size());
+  }
+}
+
+shared_ptr<Data>
+readEntry(std::istream& is, bool withPayloads, bool& isUnsolicited)
+{
+  isUnsolicited = (readUint8(is) & ENTRY_UNSOLICITED) != 0;
+  uint32_t freshness = readUint32(is);
+
+  shared_ptr<Data> data;
+  if (withPayloads) {
+    data = make_shared<Data>(readBlock(is));
+  }
+  else {
+    data = make_shared<Data>(Name(readBlock(is)));
+    data->setContent(make_shared< ::ndn::Buffer>(readUint32(is)));
+
+    // same fake signature as ndn::Producer, so that Data has wire encoding and full name
+    Signature signature;
+    SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+    signature.setInfo(signatureInfo);
+    signature.setValue(::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+    data->setSignature(signature);
+  }
+
+  // Data expires as it would have without the snapshot
+  if (freshness != NO_FRESHNESS) {
+    data->setFreshnessPeriod(time::milliseconds(freshness));
+  }
+
+  data->wireEncode();
+  return data;
+}
+
+} // namespace
+
+void
+CsSnapshotHelper::SaveAll(const std::string& filename, Time when, bool withPayloads)
+{
+  Simulator::Schedule(when - Simulator::Now(), &CsSnapshotHelper::SaveAllNodes, filename,
+                      withPayloads);
+}
+
+void
+CsSnapshotHelper::SaveAllNodes(const std::string& filename, bool withPayloads)
+{
+  Save(NodeContainer::GetGlobal(), filename, withPayloads);
+}
+
+void
+CsSnapshotHelper::Save(const NodeContainer& nodes, const std::string& filename, bool withPayloads)
+{
+  std::ofstream os(filename.c_str(), std::ios_base::out | std::ios_base::trunc
+                                       | std::ios_base::binary);
+  if (!os.is_open()) {
+    NS_FATAL_ERROR("File " << filename << " cannot be opened for writing");
+  }
+
+  os.write(MAGIC, sizeof(MAGIC));
+  writeUint8(os, VERSION);
+  writeUint8(os, withPayloads ? SNAPSHOT_WITH_PAYLOADS : 0);
+
+  size_t nTotalEntries = 0;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); ++node) {
+    Ptr<L3Protocol> ndn = (*node)->GetObject<L3Protocol>();
+    if (ndn == nullptr)
+      continue;
+
+    // Data packets are held here, as entries of some content stores exist only while enumerated
+    std::vector<SnapshotEntry> entries;
+
+    Ptr<ContentStore> cs = (*node)->GetObject<ContentStore>();
+    if (cs != nullptr) {
+      Time now = Simulator::Now();
+      cs->ForEachInEvictionOrder([&entries, &now] (Ptr<cs::Entry> entry) {
+        shared_ptr<const Data> data = entry->GetData();
+        Time staleAt = entry->GetCreationTime()
+                       + MilliSeconds(data->getFreshnessPeriod().count());
+        entries.push_back({data, false, encodeFreshness(*data, (staleAt - now).GetMilliSeconds())});
+      });
+    }
+    else {
+      // steady clock follows simulation time (see StackHelper)
+      time::steady_clock::TimePoint now = time::steady_clock::now();
+      ndn->getForwarder()->getCs().forEachEntryInEvictionOrder(
+        [&entries, &now] (const nfd::cs::Entry& entry) {
+          int64_t leftMs =
+            time::duration_cast<time::milliseconds>(entry.getStaleTime() - now).count();
+          entries.push_back({entry.getData().shared_from_this(), entry.isUnsolicited(),
+                             encodeFreshness(entry.getData(), leftMs)});
+        });
+    }
+
+    writeUint32(os, (*node)->GetId());
+    writeUint32(os, entries.size());
+    for (const SnapshotEntry& entry : entries) {
+      writeEntry(os, entry, withPayloads);
+    }
+
+    NS_LOG_DEBUG("Node " << (*node)->GetId() << ": " << entries.size() << " entries saved");
+    nTotalEntries += entries.size();
+  }
+
+  if (!os) {
+    NS_FATAL_ERROR("Failed to write content store snapshot to " << filename);
+  }
+  NS_LOG_INFO(nTotalEntries << " entries saved to " << filename << " at "
+                            << Simulator::Now().ToDouble(Time::S) << "s");
+}
+
+size_t
+CsSnapshotHelper::Load(const std::string& filename)
+{
+  std::ifstream is(filename.c_str(), std::ios_base::in | std::ios_base::binary);
+  if (!is.is_open()) {
+    NS_FATAL_ERROR("File " << filename << " cannot be opened for reading");
+  }
+
+  char magic[sizeof(MAGIC)] = {0};
+  is.read(magic, sizeof(magic));
+  if (!is || !std::equal(magic, magic + sizeof(magic), MAGIC)) {
+    NS_FATAL_ERROR(filename << " is not a content store snapshot");
+  }
+  if (readUint8(is) != VERSION) {
+    NS_FATAL_ERROR(filename << " was saved by an incompatible version of CsSnapshotHelper");
+  }
+  bool withPayloads = (readUint8(is) & SNAPSHOT_WITH_PAYLOADS) != 0;
+
+  size_t nTotalEntries = 0;
+  while (is.peek() != std::char_traits<char>::eof()) {
+    uint32_t nodeId = readUint32(is);
+    uint32_t nEntries = readUint32(is);
+
+    Ptr<L3Protocol> ndn;
+    Ptr<ContentStore> cs;
+    if (nodeId < NodeList::GetNNodes()) {
+      ndn = NodeList::GetNode(nodeId)->GetObject<L3Protocol>();
+      cs = NodeList::GetNode(nodeId)->GetObject<ContentStore>();
+    }
+    if (ndn == nullptr) {
+      NS_LOG_WARN("Node " << nodeId << " does not exist or has no NDN stack, "
+                          << nEntries << " entries skipped");
+    }
+
+    size_t nInserted = 0;
+    for (uint32_t i = 0; i < nEntries; ++i) {
+      bool isUnsolicited = false;
+      shared_ptr<Data> data = readEntry(is, withPayloads, isUnsolicited);
+      if (ndn == nullptr)
+        continue;
+
+      bool isInserted = cs != nullptr ? cs->Add(data)
+                                      : ndn->getForwarder()->getCs().insert(*data, isUnsolicited);
+      nInserted += isInserted;
+    }
+
+    NS_LOG_DEBUG("Node " << nodeId << ": " << nInserted << " of " << nEntries
+                         << " entries loaded");
+    nTotalEntries += nInserted;
+  }
+
+  NS_LOG_INFO(nTotalEntries << " entries loaded from " << filename);
+  return nTotalEntries;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CS_SNAPSHOT_HELPER_H
+#define NDN_CS_SNAPSHOT_HELPER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/node.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Helper to save content of content stores into a file and to restore it in a later run
+ *
+ * Snapshot allows a series of simulation runs to skip identical cache warm-up: the warm-up run
+ * saves content stores of all nodes at the end of the warm-up period, and the following runs
+ * load the snapshot right after the NDN stack is installed.
+ *
+ * Entries are saved in eviction order (ContentStore::ForEachInEvictionOrder on nodes that use
+ * one of the old content store implementations, nfd::Cs::forEachEntryInEvictionOrder otherwise)
+ * and re-inserted in the same order, so the entry that would have been evicted next is evicted
+ * next after loading under policies that depend on the order of insertions and lookups (LRU,
+ * FIFO).  Other policy state (e.g., LFU frequencies) is not recorded.  Nodes are matched by node
+ * ID, and entries are inserted into whatever content store the node has at load time.
+ *
+ * The snapshot is a binary file.  For every entry it records the entry flags (unsolicited), the
+ * freshness period left at the time of the snapshot, and either the complete Data packet, or
+ * (compact snapshot) the name and payload size, from which a Data packet with an empty payload
+ * of the same size is re-created.  Loaded Data packets carry the remaining freshness as their
+ * freshness period, so they become stale when they would have without the snapshot.
+ */
+class CsSnapshotHelper {
+public:
+  /**
+   * @brief Schedule saving content stores of all nodes at the specified simulation time
+   *
+   * @param filename     snapshot file
+   * @param when         simulation time of the snapshot
+   * @param withPayloads if true, complete Data packets are saved; otherwise only names, payload
+   *                     sizes, and freshness periods
+   */
+  static void
+  SaveAll(const std::string& filename, Time when, bool withPayloads = false);
+
+  /**
+   * @brief Save content stores of the nodes now
+   *
+   * @param nodes        nodes whose content stores are saved
+   * @param filename     snapshot file
+   * @param withPayloads if true, complete Data packets are saved; otherwise only names, payload
+   *                     sizes, and freshness periods
+   */
+  static void
+  Save(const NodeContainer& nodes, const std::string& filename, bool withPayloads = false);
+
+  /**
+   * @brief Load content stores of all nodes from the snapshot file
+   *
+   * Should be called after the NDN stack is installed on the nodes.  Entries of nodes that do
+   * not exist or have no NDN stack are skipped.
+   *
+   * @returns number of entries inserted into content stores
+   */
+  static size_t
+  Load(const std::string& filename);
+
+private:
+  static void
+  SaveAllNodes(const std::string& filename, bool withPayloads);
+}; // CsSnapshotHelper
+
+} // ndn
+} // ns3
+
+#endif // NDN_CS_SNAPSHOT_HELPER_H
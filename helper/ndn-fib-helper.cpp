@@ -39,6 +39,7 @@
 #include "ns3/data-rate.h"
 
 #include "daemon/mgmt/fib-manager.hpp"
+#include "daemon/fw/forwarder.hpp"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 #include "ns3/ndnSIM/helper/ndn-stack-helper.hpp"
 
@@ -96,6 +97,12 @@ FibHelper::AddRoute(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face, i
   // Get the forwarder instance
   shared_ptr<nfd::Forwarder> m_forwarder = L3protocol->getForwarder();
 
+  if (L3protocol->isForwardingOnly()) {
+    // no FibManager to send the command to
+    AddRoutes(node, {Route(prefix, face, metric)});
+    return;
+  }
+
   ControlParameters parameters;
   parameters.setName(prefix);
   parameters.setFaceId(face->getId());
@@ -178,6 +185,46 @@ FibHelper::AddRoute(const std::string& nodeName, const Name& prefix,
   AddRoute(node, prefix, otherNode, metric);
 }
 
+void
+FibHelper::AddRoutes(Ptr<Node> node, const std::vector<Route>& routes)
+{
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(ndn != 0, "Ndn stack should be installed on the node");
+
+  nfd::Fib& fib = ndn->getForwarder()->getFib();
+  for (const Route& route : routes) {
+    NS_LOG_LOGIC("[" << node->GetId() << "]$ route add " << route.prefix << " via "
+                     << route.face->getLocalUri() << " metric " << route.metric);
+    NS_ASSERT_MSG(ndn->getFaceById(route.face->getId()) == route.face,
+                  "Face " << route.face->getLocalUri() << " does not belong to node ["
+                          << node->GetId() << "]");
+
+    fib.insert(route.prefix).first->addNextHop(route.face, route.metric);
+  }
+}
+
+void
+FibHelper::RemoveRoutes(Ptr<Node> node, const std::vector<Route>& routes)
+{
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(ndn != 0, "Ndn stack should be installed on the node");
+
+  nfd::Fib& fib = ndn->getForwarder()->getFib();
+  for (const Route& route : routes) {
+    NS_LOG_LOGIC("[" << node->GetId() << "]$ route del " << route.prefix << " via "
+                     << route.face->getLocalUri());
+
+    shared_ptr<nfd::fib::Entry> entry = fib.findExactMatch(route.prefix);
+    if (entry == nullptr)
+      continue;
+
+    entry->removeNextHop(route.face);
+    if (!entry->hasNextHops()) {
+      fib.erase(*entry);
+    }
+  }
+}
+
 void
 FibHelper::RemoveRoute(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face)
 {
@@ -186,6 +233,12 @@ FibHelper::RemoveRoute(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face
   // Get the forwarder instance
   shared_ptr<nfd::Forwarder> m_forwarder = L3protocol->getForwarder();
 
+  if (L3protocol->isForwardingOnly()) {
+    // no FibManager to send the command to
+    RemoveRoutes(node, {Route(prefix, face, 0)});
+    return;
+  }
+
   ControlParameters parameters;
   parameters.setName(prefix);
   parameters.setFaceId(face->getId());
@@ -44,6 +44,22 @@ using ::ndn::nfd::ControlParameters;
  */
 class FibHelper {
 public:
+  /**
+   * @brief Forwarding entry to be installed with AddRoutes
+   */
+  struct Route {
+    Route(const Name& prefix, shared_ptr<Face> face, int32_t metric)
+      : prefix(prefix)
+      , face(face)
+      , metric(metric)
+    {
+    }
+
+    Name prefix;
+    shared_ptr<Face> face;
+    int32_t metric;
+  };
+
   /**
    * \brief Add forwarding entry to FIB
    *
@@ -101,6 +117,31 @@ public:
   AddRoute(const std::string& nodeName, const Name& prefix, const std::string& otherNodeName,
            int32_t metric);
 
+  /**
+   * @brief Add many forwarding entries to FIB of a node at once
+   *
+   * Unlike AddRoute, which sends one signed command Interest per route to NFD's FIB manager,
+   * next hops are written directly into NFD's FIB, skipping command signing, encoding, and
+   * validation.  Use it to install large numbers of routes, e.g., computed by routing helpers.
+   *
+   * \param node   Node
+   * \param routes Routes to install; faces must belong to \p node
+   */
+  static void
+  AddRoutes(Ptr<Node> node, const std::vector<Route>& routes);
+
+  /**
+   * @brief Remove many forwarding entries from FIB of a node at once
+   *
+   * Counterpart of AddRoutes: next hops are removed directly from NFD's FIB (metric of routes
+   * is ignored), and FIB entries left without next hops are erased.
+   *
+   * \param node   Node
+   * \param routes Routes to remove
+   */
+  static void
+  RemoveRoutes(Ptr<Node> node, const std::vector<Route>& routes);
+
   /**
    * \brief remove forwarding entry in FIB
    *
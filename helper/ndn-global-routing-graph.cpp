@@ -0,0 +1,571 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-global-routing-graph.hpp"
+
+#include "model/ndn-global-router.hpp"
+
+#include "ns3/node-list.h"
+#include "ns3/channel-list.h"
+#include "ns3/node.h"
+#include "ns3/channel.h"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include <thread>
+#include <tuple>
+
+#include <unistd.h>
+
+NS_LOG_COMPONENT_DEFINE("ndn.GlobalRoutingGraph");
+
+namespace ns3 {
+namespace ndn {
+
+const GlobalRoutingGraph::VertexId GlobalRoutingGraph::INVALID_VERTEX;
+const GlobalRoutingGraph::EdgeId GlobalRoutingGraph::INVALID_EDGE;
+const uint32_t GlobalRoutingGraph::MAX_DISTANCE;
+
+static const char ROUTES_FILE_MAGIC[8] = {'N', 'D', 'N', 'R', 'O', 'U', 'T', 'E'};
+static const uint32_t ROUTES_FILE_VERSION = 1;
+
+/**
+ * @brief Incremental 64-bit FNV-1a hash
+ */
+class Fnv1a {
+public:
+  void
+  add(const uint8_t* data, size_t size)
+  {
+    for (size_t i = 0; i < size; ++i) {
+      m_hash = (m_hash ^ data[i]) * 1099511628211ull;
+    }
+  }
+
+  /// hashes little-endian representation, so the value does not depend on the platform
+  void
+  add(uint64_t value)
+  {
+    for (int i = 0; i < 8; ++i) {
+      uint8_t byte = static_cast<uint8_t>(value >> (8 * i));
+      add(&byte, 1);
+    }
+  }
+
+  uint64_t
+  get() const
+  {
+    return m_hash;
+  }
+
+private:
+  uint64_t m_hash = 14695981039346656037ull;
+};
+
+/**
+ * @brief Dijkstra's algorithm on the snapshot, with state reused across sources
+ */
+class GlobalRoutingGraph::Dijkstra {
+public:
+  explicit Dijkstra(const GlobalRoutingGraph& graph)
+    : m_graph(graph)
+    , m_distances(graph.GetNVertices(), MAX_DISTANCE)
+    , m_firstHops(graph.GetNVertices(), INVALID_EDGE)
+  {
+  }
+
+  RouteList
+  operator()(const Source& source)
+  {
+    typedef std::pair<uint32_t, VertexId> QueueItem;
+    std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> queue;
+
+    m_distances[source.vertex] = 0;
+    m_visited.push_back(source.vertex);
+    queue.push(QueueItem(0, source.vertex));
+
+    while (!queue.empty()) {
+      uint32_t distance = queue.top().first;
+      VertexId u = queue.top().second;
+      queue.pop();
+      if (distance > m_distances[u])
+        continue; // stale queue item
+
+      EdgeId first = m_graph.m_offsets[u];
+      EdgeId last = m_graph.m_offsets[u + 1];
+      if (u == source.vertex && source.firstHop != INVALID_EDGE) {
+        first = source.firstHop;
+        last = source.firstHop + 1;
+      }
+
+      for (EdgeId e = first; e < last; ++e) {
+        if (!m_graph.m_isUp[e])
+          continue;
+
+        VertexId v = m_graph.m_targets[e];
+        uint32_t newDistance = distance + m_graph.m_weights[e];
+        if (newDistance < m_distances[v]) {
+          if (m_distances[v] == MAX_DISTANCE)
+            m_visited.push_back(v);
+          m_distances[v] = newDistance;
+          m_firstHops[v] = (u == source.vertex) ? e : m_firstHops[u];
+          queue.push(QueueItem(newDistance, v));
+        }
+      }
+    }
+
+    RouteList routes;
+    for (VertexId origin : m_graph.m_origins) {
+      if (origin != source.vertex && m_distances[origin] < MAX_DISTANCE) {
+        routes.push_back(Route(origin, m_firstHops[origin], m_distances[origin]));
+      }
+    }
+
+    // reset only what was touched, so that a calculation costs O(reached vertices)
+    for (VertexId v : m_visited) {
+      m_distances[v] = MAX_DISTANCE;
+      m_firstHops[v] = INVALID_EDGE;
+    }
+    m_visited.clear();
+
+    return routes;
+  }
+
+private:
+  const GlobalRoutingGraph& m_graph;
+  std::vector<uint32_t> m_distances;
+  std::vector<EdgeId> m_firstHops;
+  std::vector<VertexId> m_visited;
+};
+
+GlobalRoutingGraph::GlobalRoutingGraph()
+{
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<GlobalRouter> gr = (*node)->GetObject<GlobalRouter>();
+    if (gr != 0)
+      m_routers.push_back(gr);
+  }
+
+  for (ChannelList::Iterator channel = ChannelList::Begin(); channel != ChannelList::End();
+       channel++) {
+    Ptr<GlobalRouter> gr = (*channel)->GetObject<GlobalRouter>();
+    if (gr != 0)
+      m_routers.push_back(gr);
+  }
+
+  m_vertices.reserve(m_routers.size());
+  for (VertexId v = 0; v < m_routers.size(); ++v) {
+    m_vertices[PeekPointer(m_routers[v])] = v;
+    if (!m_routers[v]->GetLocalPrefixes().empty())
+      m_origins.push_back(v);
+  }
+
+  m_offsets.reserve(m_routers.size() + 1);
+  m_offsets.push_back(0);
+  for (const Ptr<GlobalRouter>& gr : m_routers) {
+    for (const GlobalRouter::Incidency& edge : gr->GetIncidencies()) {
+      VertexId target = GetVertex(std::get<2>(edge));
+      if (target == INVALID_VERTEX)
+        continue;
+
+      const shared_ptr<Face>& face = std::get<1>(edge);
+      m_targets.push_back(target);
+      m_weights.push_back(face == nullptr ? 0 : static_cast<uint16_t>(face->getMetric()));
+      m_faces.push_back(face);
+    }
+    m_offsets.push_back(m_targets.size());
+  }
+  m_isUp.assign(m_targets.size(), true);
+
+  // counting sort of edges by target
+  m_inOffsets.assign(m_routers.size() + 1, 0);
+  for (VertexId target : m_targets) {
+    m_inOffsets[target + 1]++;
+  }
+  for (VertexId v = 0; v < m_routers.size(); ++v) {
+    m_inOffsets[v + 1] += m_inOffsets[v];
+  }
+  m_inEdges.resize(m_targets.size());
+  m_inSources.resize(m_targets.size());
+  std::vector<EdgeId> position(m_inOffsets.begin(), m_inOffsets.end() - 1);
+  for (VertexId u = 0; u < m_routers.size(); ++u) {
+    for (EdgeId e = m_offsets[u]; e < m_offsets[u + 1]; ++e) {
+      EdgeId i = position[m_targets[e]]++;
+      m_inEdges[i] = e;
+      m_inSources[i] = u;
+    }
+  }
+}
+
+size_t
+GlobalRoutingGraph::GetNVertices() const
+{
+  return m_routers.size();
+}
+
+GlobalRoutingGraph::VertexId
+GlobalRoutingGraph::GetVertex(Ptr<GlobalRouter> router) const
+{
+  auto i = m_vertices.find(PeekPointer(router));
+  if (i == m_vertices.end())
+    return INVALID_VERTEX;
+  return i->second;
+}
+
+Ptr<GlobalRouter>
+GlobalRoutingGraph::GetRouter(VertexId vertex) const
+{
+  return m_routers[vertex];
+}
+
+std::pair<GlobalRoutingGraph::EdgeId, GlobalRoutingGraph::EdgeId>
+GlobalRoutingGraph::GetOutEdges(VertexId vertex) const
+{
+  return std::make_pair(m_offsets[vertex], m_offsets[vertex + 1]);
+}
+
+shared_ptr<Face>
+GlobalRoutingGraph::GetEdgeFace(EdgeId edge) const
+{
+  return m_faces[edge];
+}
+
+GlobalRoutingGraph::VertexId
+GlobalRoutingGraph::GetEdgeTarget(EdgeId edge) const
+{
+  return m_targets[edge];
+}
+
+uint16_t
+GlobalRoutingGraph::GetEdgeWeight(EdgeId edge) const
+{
+  return m_weights[edge];
+}
+
+bool
+GlobalRoutingGraph::IsEdgeUp(EdgeId edge) const
+{
+  return m_isUp[edge];
+}
+
+void
+GlobalRoutingGraph::SetEdgeUp(EdgeId edge, bool isUp)
+{
+  m_isUp[edge] = isUp;
+}
+
+const std::vector<GlobalRoutingGraph::VertexId>&
+GlobalRoutingGraph::GetOrigins() const
+{
+  return m_origins;
+}
+
+GlobalRoutingGraph::RouteList
+GlobalRoutingGraph::CalculateRoutes(const Source& source) const
+{
+  return Dijkstra(*this)(source);
+}
+
+/**
+ * @brief Process tasks [0, nTasks) on a pool of threads
+ * @param makeWorker called once in every thread, returns function that processes one task
+ *
+ * Tasks are handed out one at a time, as their costs can differ a lot.
+ */
+static void
+RunParallel(size_t nTasks, uint32_t nThreads,
+            const std::function<std::function<void(size_t)>()>& makeWorker)
+{
+  if (nThreads == 0)
+    nThreads = std::max(std::thread::hardware_concurrency(), 1u);
+  nThreads = std::min<size_t>(nThreads, nTasks);
+
+  std::atomic<size_t> next(0);
+  auto worker = [&] {
+    std::function<void(size_t)> process = makeWorker();
+    for (size_t i = next++; i < nTasks; i = next++) {
+      process(i);
+    }
+  };
+
+  if (nThreads <= 1) {
+    worker();
+    return;
+  }
+
+  std::vector<std::thread> threads;
+  for (uint32_t i = 1; i < nThreads; ++i) {
+    threads.push_back(std::thread(worker));
+  }
+  worker();
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
+std::vector<GlobalRoutingGraph::RouteList>
+GlobalRoutingGraph::CalculateRoutes(const std::vector<Source>& sources, uint32_t nThreads) const
+{
+  std::vector<RouteList> routes(sources.size());
+
+  RunParallel(sources.size(), nThreads, [&] {
+    auto dijkstra = make_shared<Dijkstra>(*this);
+    return [&, dijkstra](size_t i) { routes[i] = (*dijkstra)(sources[i]); };
+  });
+
+  return routes;
+}
+
+std::vector<GlobalRoutingGraph::RouteList>
+GlobalRoutingGraph::CalculateMultipathRoutes(const std::vector<VertexId>& sources, uint32_t k,
+                                             uint32_t nThreads) const
+{
+  // one reverse search per origin gives distances of all vertices to it
+  std::vector<std::vector<uint32_t>> toOrigins(m_origins.size());
+  RunParallel(m_origins.size(), nThreads, [&] {
+    return [&](size_t i) { toOrigins[i] = CalculateDistancesTo(m_origins[i]); };
+  });
+
+  std::vector<RouteList> routes(sources.size());
+  RunParallel(sources.size(), nThreads, [&] {
+    return [&](size_t i) {
+      VertexId source = sources[i];
+      std::vector<uint32_t> toSource = CalculateDistancesTo(source);
+
+      RouteList candidates;
+      for (size_t j = 0; j < m_origins.size(); ++j) {
+        const std::vector<uint32_t>& toOrigin = toOrigins[j];
+        if (m_origins[j] == source || toOrigin[source] >= MAX_DISTANCE)
+          continue;
+
+        candidates.clear();
+        for (EdgeId e = m_offsets[source]; e < m_offsets[source + 1]; ++e) {
+          VertexId neighbor = m_targets[e];
+          if (!m_isUp[e] || toOrigin[neighbor] >= MAX_DISTANCE)
+            continue;
+
+          // loop-free alternate: shortest path of the neighbor does not lead back through source
+          if (toOrigin[neighbor] >= toSource[neighbor] + toOrigin[source])
+            continue;
+
+          uint32_t distance = m_weights[e] + toOrigin[neighbor];
+          if (distance < MAX_DISTANCE)
+            candidates.push_back(Route(m_origins[j], e, distance));
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [](const Route& a, const Route& b) {
+          return std::tie(a.distance, a.firstHop) < std::tie(b.distance, b.firstHop);
+        });
+        if (k > 0 && candidates.size() > k)
+          candidates.erase(candidates.begin() + k, candidates.end());
+
+        routes[i].insert(routes[i].end(), candidates.begin(), candidates.end());
+      }
+    };
+  });
+
+  return routes;
+}
+
+std::vector<uint32_t>
+GlobalRoutingGraph::CalculateDistancesTo(VertexId target) const
+{
+  typedef std::pair<uint32_t, VertexId> QueueItem;
+  std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> queue;
+
+  std::vector<uint32_t> distances(GetNVertices(), MAX_DISTANCE);
+  distances[target] = 0;
+  queue.push(QueueItem(0, target));
+
+  while (!queue.empty()) {
+    uint32_t distance = queue.top().first;
+    VertexId v = queue.top().second;
+    queue.pop();
+    if (distance > distances[v])
+      continue;
+
+    for (EdgeId i = m_inOffsets[v]; i < m_inOffsets[v + 1]; ++i) {
+      EdgeId e = m_inEdges[i];
+      if (!m_isUp[e])
+        continue;
+
+      VertexId u = m_inSources[i];
+      uint32_t newDistance = distance + m_weights[e];
+      if (newDistance < distances[u]) {
+        distances[u] = newDistance;
+        queue.push(QueueItem(newDistance, u));
+      }
+    }
+  }
+
+  return distances;
+}
+
+uint64_t
+GlobalRoutingGraph::GetFingerprint() const
+{
+  Fnv1a hash;
+  hash.add(ROUTES_FILE_VERSION);
+  hash.add(m_routers.size());
+  for (VertexId u = 0; u < m_routers.size(); ++u) {
+    hash.add(m_offsets[u + 1] - m_offsets[u]);
+    for (EdgeId e = m_offsets[u]; e < m_offsets[u + 1]; ++e) {
+      hash.add(m_targets[e]);
+      hash.add(m_weights[e]);
+      hash.add(m_faces[e] == nullptr ? 0 : m_faces[e]->getId());
+    }
+  }
+
+  for (VertexId origin : m_origins) {
+    hash.add(origin);
+    hash.add(m_routers[origin]->GetLocalPrefixes().size());
+    for (const auto& prefix : m_routers[origin]->GetLocalPrefixes()) {
+      const Block& wire = prefix->wireEncode();
+      hash.add(wire.wire(), wire.size());
+    }
+  }
+
+  return hash.get();
+}
+
+uint64_t
+GlobalRoutingGraph::GetFingerprint(const std::vector<Source>& sources) const
+{
+  Fnv1a hash;
+  hash.add(GetFingerprint());
+  hash.add(sources.size());
+  for (const Source& source : sources) {
+    hash.add(source.vertex);
+    hash.add(source.firstHop);
+  }
+  return hash.get();
+}
+
+bool
+GlobalRoutingGraph::SaveRoutes(const std::string& fileName,
+                               const std::vector<RouteList>& routes) const
+{
+  // written next to the target and renamed into place, so that concurrent runs sharing the
+  // file never read a partially written one
+  std::string tmpFileName = fileName + ".tmp." + std::to_string(getpid());
+  std::ofstream file(tmpFileName.c_str(), std::ios::binary | std::ios::trunc);
+  if (!file) {
+    NS_LOG_WARN("Cannot open " << tmpFileName << " for writing");
+    return false;
+  }
+
+  // little-endian, so that files can be shared between platforms
+  auto write = [&file](uint64_t value, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+      file.put(static_cast<char>(value >> (8 * i)));
+    }
+  };
+
+  file.write(ROUTES_FILE_MAGIC, sizeof(ROUTES_FILE_MAGIC));
+  write(ROUTES_FILE_VERSION, 4);
+  write(GetFingerprint(), 8);
+  write(routes.size(), 4);
+  for (const RouteList& list : routes) {
+    write(list.size(), 4);
+    for (const Route& route : list) {
+      write(route.origin, 4);
+      write(route.firstHop, 4);
+      write(route.distance, 4);
+    }
+  }
+
+  file.close();
+  if (!file) {
+    NS_LOG_WARN("Cannot write routes to " << tmpFileName);
+    std::remove(tmpFileName.c_str());
+    return false;
+  }
+
+  if (std::rename(tmpFileName.c_str(), fileName.c_str()) != 0) {
+    NS_LOG_WARN("Cannot rename " << tmpFileName << " to " << fileName);
+    std::remove(tmpFileName.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool
+GlobalRoutingGraph::LoadRoutes(const std::string& fileName, std::vector<RouteList>& routes) const
+{
+  std::ifstream file(fileName.c_str(), std::ios::binary);
+  if (!file)
+    return false;
+
+  auto read = [&file](size_t size) -> uint64_t {
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; ++i) {
+      value |= static_cast<uint64_t>(static_cast<uint8_t>(file.get())) << (8 * i);
+    }
+    return value;
+  };
+
+  char magic[sizeof(ROUTES_FILE_MAGIC)];
+  file.read(magic, sizeof(magic));
+  if (!file || !std::equal(magic, magic + sizeof(magic), ROUTES_FILE_MAGIC)
+      || read(4) != ROUTES_FILE_VERSION || read(8) != GetFingerprint()) {
+    NS_LOG_DEBUG(fileName << " does not contain routes of this topology");
+    return false;
+  }
+
+  uint64_t nLists = read(4);
+  if (!file || nLists > m_routers.size()) {
+    NS_LOG_WARN(fileName << " is damaged");
+    return false;
+  }
+
+  std::vector<RouteList> loaded(nLists);
+  for (RouteList& list : loaded) {
+    uint64_t size = read(4);
+    if (!file || size > m_origins.size()) {
+      NS_LOG_WARN(fileName << " is damaged");
+      return false;
+    }
+
+    list.reserve(size);
+    for (uint64_t i = 0; i < size; ++i) {
+      VertexId origin = read(4);
+      EdgeId firstHop = read(4);
+      uint32_t distance = read(4);
+      if (!file || origin >= m_routers.size() || firstHop >= m_targets.size()) {
+        NS_LOG_WARN(fileName << " is damaged");
+        return false;
+      }
+      list.push_back(Route(origin, firstHop, distance));
+    }
+  }
+
+  if (!file)
+    return false;
+  routes.swap(loaded);
+  return true;
+}
+
+} // namespace ndn
+} // namespace ns3
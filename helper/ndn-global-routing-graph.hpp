@@ -0,0 +1,254 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_GLOBAL_ROUTING_GRAPH_H
+#define NDN_GLOBAL_ROUTING_GRAPH_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/model/ndn-face.hpp"
+
+#include "ns3/ptr.h"
+
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+class GlobalRouter;
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Compact snapshot of the GlobalRouter graph used for route calculation
+ *
+ * Vertices (GlobalRouters of nodes, then of channels) are numbered consecutively and edges
+ * are stored in compressed sparse row form, with edge weights taken from face metrics at the
+ * time of the snapshot.  Shortest path trees are computed on integer arrays only, so
+ * calculations for different sources can run concurrently on several threads.
+ */
+class GlobalRoutingGraph {
+public:
+  typedef uint32_t VertexId;
+  typedef uint32_t EdgeId;
+
+  static const VertexId INVALID_VERTEX = std::numeric_limits<VertexId>::max();
+  static const EdgeId INVALID_EDGE = std::numeric_limits<EdgeId>::max();
+
+  /**
+   * @brief Paths with total metric of this value or above are considered unreachable
+   */
+  static const uint32_t MAX_DISTANCE = std::numeric_limits<uint16_t>::max();
+
+  /**
+   * @brief Source of a route calculation
+   */
+  struct Source {
+    Source(VertexId vertex, EdgeId firstHop = INVALID_EDGE)
+      : vertex(vertex)
+      , firstHop(firstHop)
+    {
+    }
+
+    VertexId vertex;
+    /// if not INVALID_EDGE, the only out edge of the source that paths may start with
+    EdgeId firstHop;
+  };
+
+  /**
+   * @brief Shortest path from a source to an origin (vertex with local prefixes)
+   */
+  struct Route {
+    Route(VertexId origin, EdgeId firstHop, uint32_t distance)
+      : origin(origin)
+      , firstHop(firstHop)
+      , distance(distance)
+    {
+    }
+
+    VertexId origin;
+    EdgeId firstHop;
+    uint32_t distance;
+  };
+
+  typedef std::vector<Route> RouteList;
+
+  /**
+   * @brief Take snapshot of GlobalRouters installed on all nodes and channels
+   */
+  GlobalRoutingGraph();
+
+  size_t
+  GetNVertices() const;
+
+  /**
+   * @brief Get vertex of \p router, or INVALID_VERTEX if router is not in the snapshot
+   */
+  VertexId
+  GetVertex(Ptr<GlobalRouter> router) const;
+
+  Ptr<GlobalRouter>
+  GetRouter(VertexId vertex) const;
+
+  /**
+   * @brief Get range [first, last) of out edges of \p vertex
+   */
+  std::pair<EdgeId, EdgeId>
+  GetOutEdges(VertexId vertex) const;
+
+  /**
+   * @brief Get face through which the edge leaves its source (null for edges leaving channels)
+   */
+  shared_ptr<Face>
+  GetEdgeFace(EdgeId edge) const;
+
+  VertexId
+  GetEdgeTarget(EdgeId edge) const;
+
+  uint16_t
+  GetEdgeWeight(EdgeId edge) const;
+
+  /**
+   * @brief Check whether the edge can be used by shortest paths (all edges are up initially)
+   */
+  bool
+  IsEdgeUp(EdgeId edge) const;
+
+  /**
+   * @brief Set status of the edge
+   *
+   * Must not be called while route calculations are running.
+   */
+  void
+  SetEdgeUp(EdgeId edge, bool isUp);
+
+  /**
+   * @brief Get vertices that have locally exported prefixes
+   */
+  const std::vector<VertexId>&
+  GetOrigins() const;
+
+  /**
+   * @brief Calculate shortest paths from \p source to every reachable origin
+   */
+  RouteList
+  CalculateRoutes(const Source& source) const;
+
+  /**
+   * @brief Calculate shortest paths for many sources on a pool of threads
+   * @param sources  sources of the calculations
+   * @param nThreads number of threads; 0 means number of hardware threads
+   * @return routes of each source, in the order of \p sources
+   *
+   * Worker threads access only integer arrays of the snapshot and never ns-3 objects, whose
+   * reference counting is not thread-safe.
+   */
+  std::vector<RouteList>
+  CalculateRoutes(const std::vector<Source>& sources, uint32_t nThreads) const;
+
+  /**
+   * @brief Calculate multipath routes (loop-free alternates) for many sources
+   * @param sources  source vertices
+   * @param k        maximum number of routes per source and origin; 0 means no limit
+   * @param nThreads number of threads; 0 means number of hardware threads
+   * @return routes of each source, in the order of \p sources; routes to the same origin are
+   *         sorted by distance
+   *
+   * Instead of a search per source and out edge, distances of all vertices to every origin
+   * are found with one reverse search per origin, and distances to every source with one
+   * reverse search per source.  Out edge (s, v) then gives a route from s to origin t with
+   * distance w(s, v) + d(v, t), provided that v is a loop-free alternate:
+   * d(v, t) < d(v, s) + d(s, t), i.e., the shortest path of v does not lead back through s.
+   * For such neighbors the distance equals the one found by a search restricted to the edge.
+   */
+  std::vector<RouteList>
+  CalculateMultipathRoutes(const std::vector<VertexId>& sources, uint32_t k,
+                           uint32_t nThreads) const;
+
+  /**
+   * @brief Calculate shortest distances from every vertex to \p target
+   * @return distances indexed by vertex, MAX_DISTANCE for vertices that cannot reach target
+   */
+  std::vector<uint32_t>
+  CalculateDistancesTo(VertexId target) const;
+
+  /**
+   * @brief Get 64-bit hash of the snapshot: vertices, edges with their faces and weights, and
+   *        local prefixes of origins
+   *
+   * Equal fingerprints mean that route calculations give the same results, so they can be
+   * stored with SaveRoutes and reused by later simulation runs.
+   */
+  uint64_t
+  GetFingerprint() const;
+
+  /**
+   * @brief Get 64-bit hash of the snapshot and of a list of sources
+   *
+   * Routes saved with SaveRoutes can be loaded for the same list of sources only; in MPI
+   * simulations, for instance, each process calculates routes of its own nodes.
+   */
+  uint64_t
+  GetFingerprint(const std::vector<Source>& sources) const;
+
+  /**
+   * @brief Save routes calculated for a list of sources to a binary file
+   * @return false if the file cannot be written
+   *
+   * The file holds the fingerprint of the snapshot and, for every source, the list of
+   * (origin, first hop, distance) triples.  The caller is responsible for loading the routes
+   * for the same list of sources.  An existing file is replaced atomically: routes are written to
+   * a temporary file in the same directory, which is then renamed to \p fileName.
+   */
+  bool
+  SaveRoutes(const std::string& fileName, const std::vector<RouteList>& routes) const;
+
+  /**
+   * @brief Load routes saved by SaveRoutes from a snapshot with the same fingerprint
+   * @return false if the file does not exist, is damaged, or belongs to a different snapshot
+   */
+  bool
+  LoadRoutes(const std::string& fileName, std::vector<RouteList>& routes) const;
+
+private:
+  class Dijkstra;
+
+private:
+  std::vector<Ptr<GlobalRouter>> m_routers;
+  std::unordered_map<const GlobalRouter*, VertexId> m_vertices;
+  std::vector<VertexId> m_origins;
+
+  // compressed sparse row: out edges of vertex v are [m_offsets[v], m_offsets[v + 1])
+  std::vector<EdgeId> m_offsets;
+  std::vector<VertexId> m_targets;
+  std::vector<uint16_t> m_weights;
+  std::vector<shared_ptr<Face>> m_faces;
+  std::vector<bool> m_isUp;
+
+  // reverse graph: in edges of vertex v are m_inEdges[i], i in [m_inOffsets[v], m_inOffsets[v + 1])
+  std::vector<EdgeId> m_inOffsets;
+  std::vector<EdgeId> m_inEdges;
+  std::vector<VertexId> m_inSources;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_GLOBAL_ROUTING_GRAPH_H
@@ -29,6 +29,7 @@
 #include "helper/ndn-fib-helper.hpp"
 #include "model/ndn-net-device-face.hpp"
 #include "model/ndn-global-router.hpp"
+#include "utils/ndn-local-node.hpp"
 
 #include "daemon/table/fib.hpp"
 #include "daemon/fw/forwarder.hpp"
@@ -46,23 +47,44 @@
 #include "ns3/node-list.h"
 #include "ns3/channel-list.h"
 #include "ns3/object-factory.h"
+#include "ns3/simulator.h"
 
 #include <boost/lexical_cast.hpp>
-#include <boost/foreach.hpp>
-#include <boost/concept/assert.hpp>
-#include <boost/graph/dijkstra_shortest_paths.hpp>
 
-#include <unordered_map>
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <sstream>
 
-#include "boost-graph-ndn-global-routing-helper.hpp"
-
-#include <math.h>
+#include "ndn-global-routing-graph.hpp"
 
 NS_LOG_COMPONENT_DEFINE("ndn.GlobalRoutingHelper");
 
 namespace ns3 {
 namespace ndn {
 
+static uint32_t g_nThreads = 0;
+static std::string g_routeCacheDirectory;
+
+/**
+ * @brief Routes calculated by the last CalculateRoutes, kept for incremental updates
+ */
+struct RoutingState {
+  std::unique_ptr<GlobalRoutingGraph> graph;
+  std::vector<Ptr<Node>> nodes;
+  std::vector<GlobalRoutingGraph::Source> sources;
+  std::vector<GlobalRoutingGraph::RouteList> routes;
+  bool isCleanupScheduled = false;
+};
+
+static RoutingState g_state;
+
+static void
+ResetRoutingState()
+{
+  g_state = RoutingState();
+}
+
 void
 GlobalRoutingHelper::Install(Ptr<Node> node)
 {
@@ -215,174 +237,337 @@ GlobalRoutingHelper::AddOriginsForAll()
 }
 
 void
-GlobalRoutingHelper::CalculateRoutes()
+GlobalRoutingHelper::SetRouteCalculationThreads(uint32_t nThreads)
+{
+  g_nThreads = nThreads;
+}
+
+void
+GlobalRoutingHelper::SetRouteCacheDirectory(const std::string& directory)
+{
+  g_routeCacheDirectory = directory;
+}
+
+/**
+ * @brief Convert calculated routes of a node into FIB routes towards all prefixes of the origins
+ */
+static void
+AppendFibRoutes(const GlobalRoutingGraph& graph, const GlobalRoutingGraph::RouteList& routes,
+                std::vector<FibHelper::Route>& fibRoutes)
 {
-  /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
-   */
+  for (const GlobalRoutingGraph::Route& route : routes) {
+    shared_ptr<Face> face = graph.GetEdgeFace(route.firstHop);
+    for (const auto& prefix : graph.GetRouter(route.origin)->GetLocalPrefixes()) {
+      NS_LOG_DEBUG(" prefix " << *prefix << " reachable via face " << *face << " with distance "
+                   << route.distance);
 
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
+      fibRoutes.push_back(FibHelper::Route(*prefix, face, route.distance));
+    }
+  }
+}
 
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+void
+GlobalRoutingHelper::CalculateRoutes()
+{
+  // Shortest path trees of all nodes are calculated on a snapshot of the router graph in
+  // parallel, while FIBs (which are not thread-safe) are updated afterwards on this thread
+  std::unique_ptr<GlobalRoutingGraph> graph(new GlobalRoutingGraph());
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
+  std::vector<Ptr<Node>> nodes;
+  std::vector<GlobalRoutingGraph::Source> sources;
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
     Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
     if (source == 0) {
       NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
       continue;
     }
+    if (!IsLocalNode(*node)) {
+      continue;
+    }
 
-    boost::DistancesMap distances;
-
-    dijkstra_shortest_paths(graph, source,
-                            // predecessor_map (boost::ref(predecessors))
-                            // .
-                            distance_map(boost::ref(distances))
-                              .distance_inf(boost::WeightInf)
-                              .distance_zero(boost::WeightZero)
-                              .distance_compare(boost::WeightCompare())
-                              .distance_combine(boost::WeightCombine()));
-
-    // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
-
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
-
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId());
-    for (const auto& dist : distances) {
-      if (dist.first == source)
-        continue;
-      else {
-        // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-        if (std::get<0>(dist.second) == 0) {
-          // cout << " is unreachable" << endl;
-        }
-        else {
-          for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-            NS_LOG_DEBUG(" prefix " << prefix << " reachable via face " << *std::get<0>(dist.second)
-                         << " with distance " << std::get<1>(dist.second) << " with delay "
-                         << std::get<2>(dist.second));
-
-            FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                std::get<1>(dist.second));
-          }
-        }
-      }
+    nodes.push_back(*node);
+    sources.push_back(GlobalRoutingGraph::Source(graph->GetVertex(source)));
+  }
+
+  std::vector<GlobalRoutingGraph::RouteList> routes;
+  std::string cacheFile;
+  if (!g_routeCacheDirectory.empty()) {
+    std::ostringstream os;
+    os << g_routeCacheDirectory << "/routes-" << std::hex << std::setw(16) << std::setfill('0')
+       << graph->GetFingerprint(sources) << ".bin";
+    cacheFile = os.str();
+  }
+
+  if (!cacheFile.empty() && graph->LoadRoutes(cacheFile, routes)
+      && routes.size() == sources.size()) {
+    NS_LOG_DEBUG("Routes are loaded from " << cacheFile);
+  }
+  else {
+    routes = graph->CalculateRoutes(sources, g_nThreads);
+    if (!cacheFile.empty()) {
+      graph->SaveRoutes(cacheFile, routes);
     }
   }
+
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    NS_LOG_DEBUG("Reachability from Node: " << nodes[i]->GetId());
+
+    std::vector<FibHelper::Route> fibRoutes;
+    AppendFibRoutes(*graph, routes[i], fibRoutes);
+    FibHelper::AddRoutes(nodes[i], fibRoutes);
+  }
+
+  g_state.graph = std::move(graph);
+  g_state.nodes = std::move(nodes);
+  g_state.sources = std::move(sources);
+  g_state.routes = std::move(routes);
+  if (!g_state.isCleanupScheduled) {
+    Simulator::ScheduleDestroy(&ResetRoutingState);
+    g_state.isCleanupScheduled = true;
+  }
 }
 
 void
 GlobalRoutingHelper::CalculateAllPossibleRoutes()
 {
-  /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
-   */
+  // For every face of every node, shortest paths are calculated with that face being the only
+  // allowed first hop, yielding one (possibly non-optimal) route per face and origin
+  GlobalRoutingGraph graph;
+  ResetRoutingState(); // UpdateRoutes supports only routes of CalculateRoutes
+
+  std::vector<Ptr<Node>> nodes;
+  std::vector<size_t> firstSources; // index of the first calculation of each node
+  std::vector<GlobalRoutingGraph::Source> sources;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
+    if (source == 0) {
+      NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
+      continue;
+    }
+    if (!IsLocalNode(*node)) {
+      continue;
+    }
+
+    nodes.push_back(*node);
+    firstSources.push_back(sources.size());
+
+    GlobalRoutingGraph::VertexId vertex = graph.GetVertex(source);
+    std::pair<GlobalRoutingGraph::EdgeId, GlobalRoutingGraph::EdgeId> edges =
+      graph.GetOutEdges(vertex);
+    for (GlobalRoutingGraph::EdgeId edge = edges.first; edge != edges.second; ++edge) {
+      sources.push_back(GlobalRoutingGraph::Source(vertex, edge));
+    }
+  }
+  firstSources.push_back(sources.size());
+
+  std::vector<GlobalRoutingGraph::RouteList> routes = graph.CalculateRoutes(sources, g_nThreads);
+
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    NS_LOG_DEBUG("Reachability from Node: " << nodes[i]->GetId() << " ("
+                                            << Names::FindName(nodes[i]) << ")");
+
+    std::vector<FibHelper::Route> fibRoutes;
+    for (size_t j = firstSources[i]; j < firstSources[i + 1]; ++j) {
+      AppendFibRoutes(graph, routes[j], fibRoutes);
+    }
+    FibHelper::AddRoutes(nodes[i], fibRoutes);
+  }
+}
+
+/**
+ * @brief Merge routes of a prefix through the same face (keeping the smallest metric) and keep
+ *        at most \p maxNextHops cheapest next hops per prefix (0 means no limit)
+ */
+static std::vector<FibHelper::Route>
+SelectNextHops(const std::vector<FibHelper::Route>& routes, uint32_t maxNextHops)
+{
+  std::map<Name, std::map<nfd::FaceId, const FibHelper::Route*>> prefixes;
+  for (const FibHelper::Route& route : routes) {
+    const FibHelper::Route*& best = prefixes[route.prefix][route.face->getId()];
+    if (best == nullptr || route.metric < best->metric)
+      best = &route;
+  }
 
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
+  std::vector<FibHelper::Route> selected;
+  for (const auto& prefix : prefixes) {
+    std::vector<const FibHelper::Route*> nextHops;
+    for (const auto& nextHop : prefix.second) {
+      nextHops.push_back(nextHop.second);
+    }
+    std::stable_sort(nextHops.begin(), nextHops.end(),
+                     [](const FibHelper::Route* a, const FibHelper::Route* b) {
+                       return a->metric < b->metric;
+                     });
+    if (maxNextHops > 0 && nextHops.size() > maxNextHops)
+      nextHops.resize(maxNextHops);
+
+    for (const FibHelper::Route* nextHop : nextHops) {
+      selected.push_back(*nextHop);
+    }
+  }
+  return selected;
+}
 
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+void
+GlobalRoutingHelper::CalculateMultipathRoutes(uint32_t k, uint32_t maxNextHops)
+{
+  GlobalRoutingGraph graph;
+  ResetRoutingState(); // UpdateRoutes supports only routes of CalculateRoutes
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
+  std::vector<Ptr<Node>> nodes;
+  std::vector<GlobalRoutingGraph::VertexId> sources;
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
     Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
     if (source == 0) {
       NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
       continue;
     }
+    if (!IsLocalNode(*node)) {
+      continue;
+    }
 
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
+    nodes.push_back(*node);
+    sources.push_back(graph.GetVertex(source));
+  }
 
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId() << " ("
-                                            << Names::FindName(source->GetObject<Node>()) << ")");
+  std::vector<GlobalRoutingGraph::RouteList> routes =
+    graph.CalculateMultipathRoutes(sources, k, g_nThreads);
 
-    Ptr<L3Protocol> l3 = source->GetObject<L3Protocol>();
-    NS_ASSERT(l3 != 0);
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    NS_LOG_DEBUG("Reachability from Node: " << nodes[i]->GetId());
 
-    // remember interface statuses
-    std::list<nfd::FaceId> faceIds;
-    std::unordered_map<nfd::FaceId, uint16_t> originalMetrics;
-    for (auto& i : l3->getForwarder()->getFaceTable()) {
-      shared_ptr<Face> nfdFace = std::dynamic_pointer_cast<Face>(i);
-      faceIds.push_back(nfdFace->getId());
-      originalMetrics[nfdFace->getId()] = nfdFace->getMetric();
-      nfdFace->setMetric(std::numeric_limits<uint16_t>::max() - 1);
-      // value std::numeric_limits<uint16_t>::max () MUST NOT be used (reserved)
-    }
+    std::vector<FibHelper::Route> fibRoutes;
+    AppendFibRoutes(graph, routes[i], fibRoutes);
+    FibHelper::AddRoutes(nodes[i], SelectNextHops(fibRoutes, maxNextHops));
+  }
+}
 
-    for (auto& faceId : faceIds) {
-      shared_ptr<Face> k = l3->getForwarder()->getFaceTable().get(faceId);
-      shared_ptr<NetDeviceFace> face = std::dynamic_pointer_cast<NetDeviceFace>(k);
-      if (face == 0) {
-        NS_LOG_DEBUG("Skipping non-netdevice face");
-        continue;
-      }
+typedef std::map<std::pair<Name, nfd::FaceId>, FibHelper::Route> NextHopMap;
 
-      // enabling only faceId
-      face->setMetric(originalMetrics[faceId]);
+/**
+ * @brief Get FIB next hops that correspond to calculated routes of a node
+ *
+ * When several origins of the same prefix are reached through the same face, the later route
+ * wins, as with successive FibHelper::AddRoutes.
+ */
+static NextHopMap
+CollectNextHops(const GlobalRoutingGraph& graph, const GlobalRoutingGraph::RouteList& routes)
+{
+  std::vector<FibHelper::Route> fibRoutes;
+  AppendFibRoutes(graph, routes, fibRoutes);
+
+  NextHopMap nextHops;
+  for (const FibHelper::Route& route : fibRoutes) {
+    auto key = std::make_pair(route.prefix, route.face->getId());
+    auto i = nextHops.find(key);
+    if (i == nextHops.end())
+      nextHops.insert(std::make_pair(key, route));
+    else
+      i->second = route;
+  }
+  return nextHops;
+}
 
-      boost::DistancesMap distances;
+/**
+ * @brief Find edge from \p from to \p to over the first point-to-point channel connecting them
+ *        (the same link that LinkControlHelper controls), and the edge in reverse direction
+ */
+static std::pair<GlobalRoutingGraph::EdgeId, GlobalRoutingGraph::EdgeId>
+FindLink(const GlobalRoutingGraph& graph, GlobalRoutingGraph::VertexId from,
+         GlobalRoutingGraph::VertexId to)
+{
+  auto getChannel = [&graph](GlobalRoutingGraph::EdgeId edge) -> Ptr<Channel> {
+    shared_ptr<NetDeviceFace> face =
+      std::dynamic_pointer_cast<NetDeviceFace>(graph.GetEdgeFace(edge));
+    return face == nullptr ? nullptr : face->GetNetDevice()->GetChannel();
+  };
+
+  std::pair<GlobalRoutingGraph::EdgeId, GlobalRoutingGraph::EdgeId> edges = graph.GetOutEdges(from);
+  for (GlobalRoutingGraph::EdgeId edge = edges.first; edge != edges.second; ++edge) {
+    if (graph.GetEdgeTarget(edge) != to)
+      continue;
 
-      NS_LOG_DEBUG("-----------");
+    Ptr<Channel> channel = getChannel(edge);
+    std::pair<GlobalRoutingGraph::EdgeId, GlobalRoutingGraph::EdgeId> reverseEdges =
+      graph.GetOutEdges(to);
+    for (GlobalRoutingGraph::EdgeId reverse = reverseEdges.first; reverse != reverseEdges.second;
+         ++reverse) {
+      if (graph.GetEdgeTarget(reverse) == from && getChannel(reverse) == channel)
+        return std::make_pair(edge, reverse);
+    }
+  }
+  return std::make_pair(GlobalRoutingGraph::INVALID_EDGE, GlobalRoutingGraph::INVALID_EDGE);
+}
 
-      dijkstra_shortest_paths(graph, source,
-                              // predecessor_map (boost::ref(predecessors))
-                              // .
-                              distance_map(boost::ref(distances))
-                                .distance_inf(boost::WeightInf)
-                                .distance_zero(boost::WeightZero)
-                                .distance_compare(boost::WeightCompare())
-                                .distance_combine(boost::WeightCombine()));
+void
+GlobalRoutingHelper::UpdateRoutes(Ptr<Node> node1, Ptr<Node> node2, bool isUp)
+{
+  NS_LOG_FUNCTION(node1->GetId() << node2->GetId() << isUp);
+  NS_ASSERT_MSG(g_state.graph != nullptr, "CalculateRoutes must be called before UpdateRoutes");
+  GlobalRoutingGraph& graph = *g_state.graph;
+
+  GlobalRoutingGraph::VertexId v1 = graph.GetVertex(node1->GetObject<GlobalRouter>());
+  GlobalRoutingGraph::VertexId v2 = graph.GetVertex(node2->GetObject<GlobalRouter>());
+  NS_ASSERT_MSG(v1 != GlobalRoutingGraph::INVALID_VERTEX
+                  && v2 != GlobalRoutingGraph::INVALID_VERTEX,
+                "GlobalRouter is not installed on the nodes");
+
+  GlobalRoutingGraph::EdgeId e12, e21;
+  std::tie(e12, e21) = FindLink(graph, v1, v2);
+  if (e12 == GlobalRoutingGraph::INVALID_EDGE) {
+    NS_FATAL_ERROR("There is no link between the requested nodes");
+  }
+  if (graph.IsEdgeUp(e12) == isUp && graph.IsEdgeUp(e21) == isUp)
+    return;
 
-      // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
+  // A shortest path tree can change only if the link lies on a shortest path from its source,
+  // before a failure or after a recovery:  d(s, v1) + w(v1, v2) <= d(s, v2) (or vice versa).
+  // Distances d(s, v1) and d(s, v2) of all sources are found with two reverse searches.
+  std::vector<uint32_t> to1 = graph.CalculateDistancesTo(v1);
+  std::vector<uint32_t> to2 = graph.CalculateDistancesTo(v2);
+  auto isOnShortestPath = [](uint32_t toTail, uint16_t weight, uint32_t toHead) {
+    return toTail + weight < GlobalRoutingGraph::MAX_DISTANCE && toTail + weight <= toHead;
+  };
+
+  std::vector<size_t> affected;
+  std::vector<GlobalRoutingGraph::Source> sources;
+  for (size_t i = 0; i < g_state.sources.size(); ++i) {
+    GlobalRoutingGraph::VertexId s = g_state.sources[i].vertex;
+    if (isOnShortestPath(to1[s], graph.GetEdgeWeight(e12), to2[s])
+        || isOnShortestPath(to2[s], graph.GetEdgeWeight(e21), to1[s])) {
+      affected.push_back(i);
+      sources.push_back(g_state.sources[i]);
+    }
+  }
+  NS_LOG_DEBUG("Recalculating " << affected.size() << " of " << g_state.sources.size()
+                                << " shortest path trees");
 
-      for (const auto& dist : distances) {
-        if (dist.first == source)
-          continue;
-        else {
-          // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-          if (std::get<0>(dist.second) == 0) {
-            // cout << " is unreachable" << endl;
-          }
-          else {
-            for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-              NS_LOG_DEBUG(" prefix " << *prefix << " reachable via face "
-                           << *std::get<0>(dist.second)
-                           << " with distance " << std::get<1>(dist.second)
-                           << " with delay " << std::get<2>(dist.second));
-
-              if (std::get<0>(dist.second)->getMetric() == std::numeric_limits<uint16_t>::max() - 1)
-                continue;
-
-              FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                  std::get<1>(dist.second));
-            }
-          }
-        }
-      }
+  graph.SetEdgeUp(e12, isUp);
+  graph.SetEdgeUp(e21, isUp);
+
+  std::vector<GlobalRoutingGraph::RouteList> routes = graph.CalculateRoutes(sources, g_nThreads);
 
-      // disabling the face again
-      face->setMetric(std::numeric_limits<uint16_t>::max() - 1);
+  for (size_t i = 0; i < affected.size(); ++i) {
+    size_t index = affected[i];
+    NextHopMap oldNextHops = CollectNextHops(graph, g_state.routes[index]);
+    NextHopMap newNextHops = CollectNextHops(graph, routes[i]);
+
+    std::vector<FibHelper::Route> removed;
+    for (const auto& nextHop : oldNextHops) {
+      if (newNextHops.count(nextHop.first) == 0)
+        removed.push_back(nextHop.second);
     }
 
-    // recover original interface statuses
-    for (auto& i : originalMetrics) {
-      l3->getForwarder()->getFaceTable().get(i.first)->setMetric(i.second);
+    std::vector<FibHelper::Route> added;
+    for (const auto& nextHop : newNextHops) {
+      auto old = oldNextHops.find(nextHop.first);
+      if (old == oldNextHops.end() || old->second.metric != nextHop.second.metric)
+        added.push_back(nextHop.second);
     }
+
+    FibHelper::RemoveRoutes(g_state.nodes[index], removed);
+    FibHelper::AddRoutes(g_state.nodes[index], added);
+    g_state.routes[index] = std::move(routes[i]);
   }
 }
 
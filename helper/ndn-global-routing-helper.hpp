@@ -94,8 +94,37 @@ public:
   void
   AddOriginsForAll();
 
+  /**
+   * @brief Set number of threads used to calculate shortest path trees
+   * @param nThreads number of threads; 0 (default) means number of hardware threads
+   *
+   * Calculated routes do not depend on the number of threads.
+   */
+  static void
+  SetRouteCalculationThreads(uint32_t nThreads);
+
+  /**
+   * @brief Enable caching of routes calculated by CalculateRoutes in \p directory
+   *
+   * Routes are stored in a compact binary file named after the fingerprint of the topology:
+   * nodes, links, link metrics, faces, prefixes added with AddOrigin, and nodes whose routes are
+   * calculated (in MPI simulations, nodes of the local partition).  Later runs with the
+   * same fingerprint (e.g., in a parameter sweep) load routes from the file and install them
+   * directly into FIBs instead of calculating them again.
+   *
+   * @param directory existing directory for cache files; empty string (default) disables cache
+   */
+  static void
+  SetRouteCacheDirectory(const std::string& directory);
+
   /**
    * @brief Calculate for every node shortest path trees and install routes to all prefix origins
+   *
+   * Shortest path trees of different nodes are calculated in parallel (see
+   * SetRouteCalculationThreads), FIBs are updated afterwards from the main thread.
+   *
+   * In MPI simulations, as well as in CalculateAllPossibleRoutes and CalculateMultipathRoutes,
+   * only routes of nodes that belong to the partition of the local process are calculated.
    */
   static void
   CalculateRoutes();
@@ -103,14 +132,52 @@ public:
   /**
    * @brief Calculate all possible next-hop independent alternative routes
    *
-   * Refer to the implementation for more details.
+   * For every face of a node, a shortest path tree is calculated with that face being the only
+   * allowed first hop, yielding one route per face and prefix origin.
    *
    * Note that this method is highly experimental and should be used with caution (very time
-   *consuming).
+   *consuming).  CalculateMultipathRoutes is a much faster alternative.
    */
   static void
   CalculateAllPossibleRoutes();
 
+  /**
+   * @brief Calculate multipath routes and install up to \p k next hops per prefix origin
+   *
+   * Every neighbor whose shortest path to an origin does not lead back through the node (a
+   * loop-free alternate) becomes a next hop, with the cost of the path through it.  Unlike
+   * CalculateAllPossibleRoutes, which runs a shortest path search per node and face, this
+   * needs one reverse search per origin and per node, calculated in parallel (see
+   * SetRouteCalculationThreads).  Next hops that would only be reachable by looping back
+   * through the node are not installed.
+   *
+   * @param k           maximum number of next hops per node and origin, cheapest first;
+   *                    0 means all loop-free alternates
+   * @param maxNextHops maximum number of next hops per prefix, after routes towards all
+   *                    origins of the prefix are merged; 0 means no limit
+   */
+  static void
+  CalculateMultipathRoutes(uint32_t k, uint32_t maxNextHops = 0);
+
+  /**
+   * @brief Repair routes after the link between two nodes failed or was restored
+   *
+   * Only shortest path trees that contain the link (before a failure) or could use it (after a
+   * recovery) are recalculated, and the differences are applied to FIBs of their nodes: stale
+   * next hops are removed, new ones are added.  The resulting FIBs are the same as the routes
+   * that CalculateRoutes would install on a topology without the failed links.
+   *
+   * The link is identified as in LinkControlHelper (the first point-to-point link between the
+   * nodes).  Routes installed by the last CalculateRoutes call are updated; link status is
+   * kept until the next CalculateRoutes, which starts again with all links up.
+   *
+   * @param node1 one node
+   * @param node2 another node
+   * @param isUp  new status of the link
+   */
+  static void
+  UpdateRoutes(Ptr<Node> node1, Ptr<Node> node2, bool isUp);
+
 private:
   void
   Install(Ptr<Channel> channel);
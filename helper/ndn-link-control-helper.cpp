@@ -33,6 +33,7 @@
 
 #include "model/ndn-l3-protocol.hpp"
 #include "model/ndn-net-device-face.hpp"
+#include "helper/ndn-global-routing-helper.hpp"
 
 #include "fw/forwarder.hpp"
 
@@ -41,6 +42,14 @@ NS_LOG_COMPONENT_DEFINE("ndn.LinkControlHelper");
 namespace ns3 {
 namespace ndn {
 
+static bool g_updateGlobalRoutes = false;
+
+void
+LinkControlHelper::SetUpdateGlobalRoutes(bool updateGlobalRoutes)
+{
+  g_updateGlobalRoutes = updateGlobalRoutes;
+}
+
 void
 LinkControlHelper::setErrorRate(Ptr<Node> node1, Ptr<Node> node2, double errorRate)
 {
@@ -94,6 +103,10 @@ void
 LinkControlHelper::FailLink(Ptr<Node> node1, Ptr<Node> node2)
 {
   setErrorRate(node1, node2, 1.0);
+
+  if (g_updateGlobalRoutes) {
+    GlobalRoutingHelper::UpdateRoutes(node1, node2, false);
+  }
 }
 
 void
@@ -106,6 +119,10 @@ void
 LinkControlHelper::UpLink(Ptr<Node> node1, Ptr<Node> node2)
 {
   setErrorRate(node1, node2, -0.1); // this will ensure error model is disabled
+
+  if (g_updateGlobalRoutes) {
+    GlobalRoutingHelper::UpdateRoutes(node1, node2, true);
+  }
 }
 
 void
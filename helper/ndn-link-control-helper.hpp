@@ -95,6 +95,16 @@ public:
   static void
   UpLinkByName(const std::string& node1, const std::string& node2);
 
+  /**
+   * @brief Enable or disable repair of global routes on link status changes
+   *
+   * If enabled, FailLink and UpLink also update routes calculated by
+   * GlobalRoutingHelper::CalculateRoutes (see GlobalRoutingHelper::UpdateRoutes), instead of
+   * leaving stale FIB entries for forwarding strategies to deal with.  Disabled by default.
+   */
+  static void
+  SetUpdateGlobalRoutes(bool updateGlobalRoutes);
+
 private:
   static void
   setErrorRate(Ptr<Node> node1, Ptr<Node> node2, double errorRate);
@@ -29,10 +29,16 @@
 #include "utils/ndn-time.hpp"
 #include "utils/dummy-keychain.hpp"
 #include "model/cs/ndn-content-store.hpp"
+#include "model/cs/ndn-cache-placement.hpp"
 
 #include <limits>
 #include <map>
 #include <boost/lexical_cast.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#ifdef NS3_MPI
+#include "ns3/mpi-interface.h"
+#endif
 
 NS_LOG_COMPONENT_DEFINE("ndn.StackHelper");
 
@@ -42,6 +48,11 @@ namespace ndn {
 StackHelper::StackHelper()
   : m_needSetDefaultRoutes(false)
   , m_maxCsSize(100)
+  , m_maxCsBytes(0)
+  , m_csEngine("skip_list")
+  , m_csPolicy("lru")
+  , m_timerWheelTick(Seconds(0))
+  , m_isForwardingOnly(false)
 {
   setCustomNdnCxxClocks();
 
@@ -103,6 +114,7 @@ StackHelper::SetOldContentStore(const std::string& contentStore, const std::stri
                                 const std::string& value4)
 {
   m_maxCsSize = 0;
+  m_nfdConfig.reset();
 
   m_contentStoreFactory.SetTypeId(contentStore);
   if (attr1 != "")
@@ -115,10 +127,56 @@ StackHelper::SetOldContentStore(const std::string& contentStore, const std::stri
     m_contentStoreFactory.Set(attr4, StringValue(value4));
 }
 
+void
+StackHelper::SetCachePlacement(const std::string& placement, const std::string& attr1,
+                               const std::string& value1, const std::string& attr2,
+                               const std::string& value2, const std::string& attr3,
+                               const std::string& value3, const std::string& attr4,
+                               const std::string& value4)
+{
+  m_cachePlacementFactory.SetTypeId(placement);
+  if (attr1 != "")
+    m_cachePlacementFactory.Set(attr1, StringValue(value1));
+  if (attr2 != "")
+    m_cachePlacementFactory.Set(attr2, StringValue(value2));
+  if (attr3 != "")
+    m_cachePlacementFactory.Set(attr3, StringValue(value3));
+  if (attr4 != "")
+    m_cachePlacementFactory.Set(attr4, StringValue(value4));
+}
+
 void
 StackHelper::setCsSize(size_t maxSize)
 {
   m_maxCsSize = maxSize;
+  m_nfdConfig.reset();
+}
+
+void
+StackHelper::setCsByteLimit(size_t maxBytes)
+{
+  m_maxCsBytes = maxBytes;
+  m_nfdConfig.reset();
+}
+
+void
+StackHelper::setCsEngine(const std::string& engine, const std::string& policy)
+{
+  m_csEngine = engine;
+  m_csPolicy = policy;
+  m_nfdConfig.reset();
+}
+
+void
+StackHelper::setTimerWheelTick(const Time& tick)
+{
+  m_timerWheelTick = tick;
+}
+
+void
+StackHelper::setForwardingOnly(bool isForwardingOnly)
+{
+  m_isForwardingOnly = isForwardingOnly;
 }
 
 Ptr<FaceContainer>
@@ -137,6 +195,20 @@ StackHelper::InstallAll() const
   return Install(NodeContainer::GetGlobal());
 }
 
+shared_ptr<const nfd::ConfigSection>
+StackHelper::getNfdConfig() const
+{
+  if (m_nfdConfig == nullptr) {
+    auto config = make_shared<nfd::ConfigSection>(*L3Protocol::getDefaultConfig());
+    config->put("tables.cs_max_packets", (m_maxCsSize == 0) ? 1 : m_maxCsSize);
+    config->put("tables.cs_max_bytes", m_maxCsBytes);
+    config->put("tables.cs_engine", m_csEngine);
+    config->put("tables.cs_policy", m_csPolicy);
+    m_nfdConfig = config;
+  }
+  return m_nfdConfig;
+}
+
 Ptr<FaceContainer>
 StackHelper::Install(Ptr<Node> node) const
 {
@@ -150,7 +222,18 @@ StackHelper::Install(Ptr<Node> node) const
 
   Ptr<L3Protocol> ndn = m_ndnFactory.Create<L3Protocol>();
 
-  ndn->getConfig().put("tables.cs_max_packets", (m_maxCsSize == 0) ? 1 : m_maxCsSize);
+  bool isForwardingOnly = m_isForwardingOnly;
+#ifdef NS3_MPI
+  // nodes of other MPI partitions never process packets in this process, only their tables are
+  // populated by helpers, so they don't need NFD management
+  if (MpiInterface::IsEnabled() && node->GetSystemId() != MpiInterface::GetSystemId()) {
+    isForwardingOnly = true;
+  }
+#endif
+
+  ndn->setConfig(getNfdConfig());
+  ndn->setForwardingOnly(isForwardingOnly);
+  ndn->setTimerWheelTick(m_timerWheelTick);
 
   // NFD initialization
   ndn->initialize();
@@ -160,6 +243,10 @@ StackHelper::Install(Ptr<Node> node) const
     ndn->AggregateObject(m_contentStoreFactory.Create<ContentStore>());
   }
 
+  if (m_cachePlacementFactory.GetTypeId() != TypeId()) {
+    ndn->AggregateObject(m_cachePlacementFactory.Create<CachePlacement>());
+  }
+
   // Aggregate L3Protocol on node (must be after setting ndnSIM CS)
   node->AggregateObject(ndn);
 
@@ -31,6 +31,8 @@
 #include "ndn-fib-helper.hpp"
 #include "ndn-strategy-choice-helper.hpp"
 
+#include "ns3/ndnSIM/NFD/core/config-file.hpp"
+
 namespace ns3 {
 
 class Node;
@@ -75,6 +77,52 @@ public:
   void
   setCsSize(size_t maxSize);
 
+  /**
+   * @brief Set maximum size for NFD's Content Store (in bytes)
+   *
+   * Each cached packet is charged its wire-encoded size plus a fixed per-entry overhead.
+   * The byte limit is enforced in addition to the packet limit set with setCsSize.
+   * Zero (the default) disables the byte limit.
+   */
+  void
+  setCsByteLimit(size_t maxBytes);
+
+  /**
+   * @brief Select implementation of NFD's Content Store
+   * @param engine "skip_list" (default), or "indexed" for hash and ordered indexes
+   *               (the hash index serves only Interests with MaxSuffixComponents=1,
+   *               see nfd::IndexedCs)
+   * @param policy replacement policy of the indexed Content Store:
+   *               "lru" (default), "fifo", or "priority_fifo"
+   */
+  void
+  setCsEngine(const std::string& engine, const std::string& policy = "lru");
+
+  /**
+   * @brief Set tick interval of the timer wheel that drives NFD's PIT, Measurements, and
+   *        Dead Nonce List timers
+   *
+   * Timers are batched into ticks of this interval and fire up to one tick late.
+   * Zero (the default) disables the wheel, scheduling each timer as a separate ns-3 event.
+   */
+  void
+  setTimerWheelTick(const Time& tick);
+
+  /**
+   * @brief Install lean forwarding-only nodes, without NFD management plane
+   *
+   * Suited for core routers that never receive management commands: nodes get no internal
+   * face and no FIB, face, strategy choice, or status managers, and forwarding strategies
+   * other than the default one are created only when first chosen for a prefix.  Routes and
+   * strategies can still be set with FibHelper, GlobalRoutingHelper, and StrategyChoiceHelper,
+   * which update tables of these nodes directly.  Disabled by default.
+   *
+   * In MPI simulations, nodes that belong to other partitions are always installed as
+   * forwarding-only.
+   */
+  void
+  setForwardingOnly(bool isForwardingOnly);
+
   /**
    * @brief Set ndnSIM 1.0 content store implementation and its attributes
    * @param contentStoreClass string, representing class of the content store
@@ -88,6 +136,21 @@ public:
                   const std::string& value3 = "", const std::string& attr4 = "",
                   const std::string& value4 = "");
 
+  /**
+   * @brief Set cooperative cache placement scheme and its attributes
+   * @param placementClass string, representing class of the placement scheme, e.g.,
+   *        "ns3::ndn::cs::placement::HopCount"
+   *
+   * Placement decides, for every incoming Data, whether this node caches it, and applies to
+   * both NFD's and ndnSIM 1.0 content stores.  By default every node caches every Data.
+   */
+  void
+  SetCachePlacement(const std::string& placementClass, const std::string& attr1 = "",
+                    const std::string& value1 = "", const std::string& attr2 = "",
+                    const std::string& value2 = "", const std::string& attr3 = "",
+                    const std::string& value3 = "", const std::string& attr4 = "",
+                    const std::string& value4 = "");
+
   typedef Callback<shared_ptr<NetDeviceFace>, Ptr<Node>, Ptr<L3Protocol>, Ptr<NetDevice>>
     NetDeviceFaceCreateCallback;
 
@@ -222,6 +285,12 @@ private:
   shared_ptr<NetDeviceFace>
   createAndRegisterFace(Ptr<Node> node, Ptr<L3Protocol> ndn, Ptr<NetDevice> device) const;
 
+  /**
+   * @brief Get NFD config for installed nodes, prepared once and shared by all of them
+   */
+  shared_ptr<const nfd::ConfigSection>
+  getNfdConfig() const;
+
 public:
   void
   setCustomNdnCxxClocks();
@@ -229,9 +298,16 @@ public:
 private:
   ObjectFactory m_ndnFactory;
   ObjectFactory m_contentStoreFactory;
+  ObjectFactory m_cachePlacementFactory;
 
   bool m_needSetDefaultRoutes;
   size_t m_maxCsSize;
+  size_t m_maxCsBytes;
+  std::string m_csEngine;
+  std::string m_csPolicy;
+  Time m_timerWheelTick;
+  bool m_isForwardingOnly;
+  mutable shared_ptr<const nfd::ConfigSection> m_nfdConfig; ///< reset when CS settings change
 
   typedef std::list<std::pair<TypeId, NetDeviceFaceCreateCallback>> NetDeviceCallbackList;
   NetDeviceCallbackList m_netDeviceCallbacks;
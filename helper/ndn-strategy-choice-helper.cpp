@@ -31,6 +31,18 @@ NS_LOG_COMPONENT_DEFINE("ndn.StrategyChoiceHelper");
 void
 StrategyChoiceHelper::sendCommand(const ControlParameters& parameters, Ptr<Node> node)
 {
+  Ptr<L3Protocol> L3protocol = node->GetObject<L3Protocol>();
+  if (L3protocol->isForwardingOnly()) {
+    // no StrategyChoiceManager; create the strategy on first use and choose it directly
+    nfd::Forwarder& forwarder = *L3protocol->getForwarder();
+    if (!nfd::fw::installStrategy(forwarder, parameters.getStrategy())) {
+      NS_FATAL_ERROR("Unknown forwarding strategy " << parameters.getStrategy());
+    }
+    forwarder.getStrategyChoice().insert(parameters.getName(), parameters.getStrategy());
+    NS_LOG_DEBUG("Forwarding strategy installed in node " << node->GetId());
+    return;
+  }
+
   NS_LOG_DEBUG("Strategy choice command was initialized");
   Block encodedParameters(parameters.wireEncode());
 
@@ -40,7 +52,6 @@ StrategyChoiceHelper::sendCommand(const ControlParameters& parameters, Ptr<Node>
 
   shared_ptr<Interest> command(make_shared<Interest>(commandName));
   StackHelper::getKeyChain().sign(*command);
-  Ptr<L3Protocol> L3protocol = node->GetObject<L3Protocol>();
   auto strategyChoiceManager = L3protocol->getStrategyChoiceManager();
   strategyChoiceManager->onStrategyChoiceRequest(*command);
   NS_LOG_DEBUG("Forwarding strategy installed in node " << node->GetId());
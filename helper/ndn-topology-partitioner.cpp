@@ -0,0 +1,387 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-topology-partitioner.hpp"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <numeric>
+#include <queue>
+#include <unordered_map>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TopologyPartitioner");
+
+namespace ns3 {
+namespace ndn {
+
+const TopologyPartitioner::VertexId TopologyPartitioner::INVALID_VERTEX;
+
+static const uint32_t NO_SYSTEM = std::numeric_limits<uint32_t>::max();
+
+/// maximum number of passes that move boundary groups and vertices to reduce the cut
+static const int MAX_REFINEMENT_PASSES = 10;
+
+/**
+ * @brief Assignment of vertices and groups to systems while it is being built
+ */
+class TopologyPartitioner::State {
+public:
+  State(const TopologyPartitioner& partitioner, uint32_t nSystems, double maxLoad)
+    : m_weights(partitioner.m_weights)
+    , m_nSystems(nSystems)
+    , m_maxLoad(maxLoad)
+    , m_systems(m_weights.size(), NO_SYSTEM)
+    , m_loads(nSystems, 0.0)
+    , m_groupOf(m_weights.size())
+  {
+    // dense group numbers in the order of first appearance
+    std::unordered_map<uint32_t, size_t> groupIds;
+    for (size_t v = 0; v < m_weights.size(); ++v) {
+      auto group = groupIds.insert(std::make_pair(partitioner.m_groups[v], groupIds.size())).first;
+      m_groupOf[v] = group->second;
+    }
+    m_members.resize(groupIds.size());
+    m_groupWeights.resize(groupIds.size(), 0.0);
+    m_groupSystems.resize(groupIds.size(), NO_SYSTEM);
+    for (size_t v = 0; v < m_weights.size(); ++v) {
+      m_members[m_groupOf[v]].push_back(v);
+      m_groupWeights[m_groupOf[v]] += m_weights[v];
+    }
+
+    // adjacency in compressed sparse row form, both directions of every edge
+    m_offsets.assign(m_weights.size() + 1, 0);
+    for (const Edge& edge : partitioner.m_edges) {
+      ++m_offsets[edge.u + 1];
+      ++m_offsets[edge.v + 1];
+    }
+    std::partial_sum(m_offsets.begin(), m_offsets.end(), m_offsets.begin());
+
+    std::vector<size_t> next(m_offsets.begin(), m_offsets.end() - 1);
+    m_neighbors.resize(m_offsets.back());
+    m_linkWeights.resize(m_offsets.back());
+    for (const Edge& edge : partitioner.m_edges) {
+      m_neighbors[next[edge.u]] = edge.v;
+      m_linkWeights[next[edge.u]++] = edge.weight;
+      m_neighbors[next[edge.v]] = edge.u;
+      m_linkWeights[next[edge.v]++] = edge.weight;
+    }
+  }
+
+  /**
+   * @brief Assign whole groups, heaviest first, to the system with most links to the group
+   *        among systems that have room for it
+   * @return groups that did not fit on any system
+   */
+  std::vector<size_t>
+  assignGroups()
+  {
+    std::vector<size_t> order(m_members.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this] (size_t a, size_t b) {
+        return m_groupWeights[a] > m_groupWeights[b];
+      });
+
+    std::vector<size_t> unassigned;
+    for (size_t group : order) {
+      std::vector<double> links = getGroupLinks(group);
+
+      uint32_t best = NO_SYSTEM;
+      for (uint32_t system = 0; system < m_nSystems; ++system) {
+        if (m_loads[system] + m_groupWeights[group] > m_maxLoad) {
+          continue;
+        }
+        if (best == NO_SYSTEM || links[system] > links[best]
+            || (links[system] == links[best] && m_loads[system] < m_loads[best])) {
+          best = system;
+        }
+      }
+
+      if (best == NO_SYSTEM) {
+        unassigned.push_back(group);
+      }
+      else {
+        moveGroup(group, best);
+      }
+    }
+    return unassigned;
+  }
+
+  /**
+   * @brief Split group into connected pieces, filling the least loaded systems in turn
+   */
+  void
+  splitGroup(size_t group)
+  {
+    std::vector<size_t> order;
+    std::vector<bool> isSeen(m_weights.size(), false);
+    for (size_t start : m_members[group]) {
+      if (isSeen[start]) {
+        continue;
+      }
+      std::queue<size_t> queue;
+      queue.push(start);
+      isSeen[start] = true;
+      while (!queue.empty()) {
+        size_t v = queue.front();
+        queue.pop();
+        order.push_back(v);
+        for (size_t i = m_offsets[v]; i < m_offsets[v + 1]; ++i) {
+          size_t u = m_neighbors[i];
+          if (m_groupOf[u] == group && !isSeen[u]) {
+            isSeen[u] = true;
+            queue.push(u);
+          }
+        }
+      }
+    }
+
+    uint32_t system = getLeastLoaded();
+    for (size_t v : order) {
+      if (m_loads[system] + m_weights[v] > m_maxLoad) {
+        system = getLeastLoaded();
+      }
+      moveVertex(v, system);
+    }
+  }
+
+  /**
+   * @brief Move whole groups to other systems when that reduces the cut
+   * @return whether any group was moved
+   */
+  bool
+  refineGroups()
+  {
+    bool isMoved = false;
+    for (size_t group = 0; group < m_members.size(); ++group) {
+      uint32_t from = m_groupSystems[group];
+      if (from == NO_SYSTEM) {
+        continue;
+      }
+
+      std::vector<double> links = getGroupLinks(group);
+      uint32_t best = from;
+      double bestGain = 0;
+      for (uint32_t system = 0; system < m_nSystems; ++system) {
+        double gain = links[system] - links[from];
+        if (system != from && gain > bestGain
+            && m_loads[system] + m_groupWeights[group] <= m_maxLoad) {
+          best = system;
+          bestGain = gain;
+        }
+      }
+
+      if (best != from) {
+        moveGroup(group, best);
+        isMoved = true;
+      }
+    }
+    return isMoved;
+  }
+
+  /**
+   * @brief Move single vertices to other systems when that reduces the cut
+   * @return whether any vertex was moved
+   */
+  bool
+  refineVertices()
+  {
+    bool isMoved = false;
+    std::vector<double> links(m_nSystems, 0.0);
+    for (size_t v = 0; v < m_weights.size(); ++v) {
+      std::fill(links.begin(), links.end(), 0.0);
+      for (size_t i = m_offsets[v]; i < m_offsets[v + 1]; ++i) {
+        links[m_systems[m_neighbors[i]]] += m_linkWeights[i];
+      }
+
+      uint32_t from = m_systems[v];
+      uint32_t best = from;
+      double bestGain = 0;
+      for (uint32_t system = 0; system < m_nSystems; ++system) {
+        double gain = links[system] - links[from];
+        if (system != from && gain > bestGain && m_loads[system] + m_weights[v] <= m_maxLoad) {
+          best = system;
+          bestGain = gain;
+        }
+      }
+
+      if (best != from) {
+        moveVertex(v, best);
+        // the group is no longer on a single system
+        m_groupSystems[m_groupOf[v]] = NO_SYSTEM;
+        isMoved = true;
+      }
+    }
+    return isMoved;
+  }
+
+  const std::vector<uint32_t>&
+  getSystems() const
+  {
+    return m_systems;
+  }
+
+private:
+  /**
+   * @brief Get total weight of links between the group and other groups on every system
+   */
+  std::vector<double>
+  getGroupLinks(size_t group) const
+  {
+    std::vector<double> links(m_nSystems, 0.0);
+    for (size_t v : m_members[group]) {
+      for (size_t i = m_offsets[v]; i < m_offsets[v + 1]; ++i) {
+        size_t u = m_neighbors[i];
+        if (m_groupOf[u] != group && m_systems[u] != NO_SYSTEM) {
+          links[m_systems[u]] += m_linkWeights[i];
+        }
+      }
+    }
+    return links;
+  }
+
+  uint32_t
+  getLeastLoaded() const
+  {
+    return std::min_element(m_loads.begin(), m_loads.end()) - m_loads.begin();
+  }
+
+  void
+  moveGroup(size_t group, uint32_t system)
+  {
+    for (size_t v : m_members[group]) {
+      moveVertex(v, system);
+    }
+    m_groupSystems[group] = system;
+  }
+
+  void
+  moveVertex(size_t v, uint32_t system)
+  {
+    if (m_systems[v] != NO_SYSTEM) {
+      m_loads[m_systems[v]] -= m_weights[v];
+    }
+    m_systems[v] = system;
+    m_loads[system] += m_weights[v];
+  }
+
+private:
+  const std::vector<double>& m_weights;
+  uint32_t m_nSystems;
+  double m_maxLoad;
+
+  std::vector<uint32_t> m_systems;
+  std::vector<double> m_loads;
+
+  std::vector<size_t> m_groupOf;
+  std::vector<std::vector<size_t>> m_members;
+  std::vector<double> m_groupWeights;
+  std::vector<uint32_t> m_groupSystems;
+
+  // adjacency: links of vertex v are [m_offsets[v], m_offsets[v + 1])
+  std::vector<size_t> m_offsets;
+  std::vector<size_t> m_neighbors;
+  std::vector<double> m_linkWeights;
+};
+
+TopologyPartitioner::VertexId
+TopologyPartitioner::AddVertex(double weight, uint32_t group)
+{
+  NS_ASSERT_MSG(weight >= 0, "Vertex weight must not be negative");
+
+  m_weights.push_back(weight);
+  m_groups.push_back(group);
+  return m_weights.size() - 1;
+}
+
+void
+TopologyPartitioner::AddEdge(VertexId u, VertexId v, double weight)
+{
+  NS_ASSERT_MSG(u < m_weights.size() && v < m_weights.size(), "Unknown vertex");
+
+  if (u != v) {
+    m_edges.push_back(Edge{u, v, weight});
+  }
+}
+
+size_t
+TopologyPartitioner::GetNVertices() const
+{
+  return m_weights.size();
+}
+
+std::vector<uint32_t>
+TopologyPartitioner::Partition(uint32_t nSystems, double imbalance) const
+{
+  NS_ASSERT_MSG(nSystems > 0, "At least one system is required");
+
+  if (nSystems == 1) {
+    return std::vector<uint32_t>(m_weights.size(), 0);
+  }
+
+  double totalWeight = std::accumulate(m_weights.begin(), m_weights.end(), 0.0);
+  State state(*this, nSystems, (1 + imbalance) * totalWeight / nSystems);
+
+  std::vector<size_t> unassigned = state.assignGroups();
+  for (size_t group : unassigned) {
+    state.splitGroup(group);
+  }
+  NS_LOG_DEBUG(unassigned.size() << " groups split between systems");
+
+  for (int pass = 0; pass < MAX_REFINEMENT_PASSES; ++pass) {
+    bool isMoved = state.refineGroups();
+    isMoved = state.refineVertices() || isMoved;
+    if (!isMoved) {
+      break;
+    }
+  }
+
+  NS_LOG_DEBUG("Cut weight: " << GetCutWeight(state.getSystems()));
+  return state.getSystems();
+}
+
+std::vector<double>
+TopologyPartitioner::GetLoads(const std::vector<uint32_t>& systems, uint32_t nSystems) const
+{
+  NS_ASSERT(systems.size() == m_weights.size());
+
+  std::vector<double> loads(nSystems, 0.0);
+  for (size_t v = 0; v < systems.size(); ++v) {
+    NS_ASSERT(systems[v] < nSystems);
+    loads[systems[v]] += m_weights[v];
+  }
+  return loads;
+}
+
+double
+TopologyPartitioner::GetCutWeight(const std::vector<uint32_t>& systems) const
+{
+  NS_ASSERT(systems.size() == m_weights.size());
+
+  double cut = 0;
+  for (const Edge& edge : m_edges) {
+    if (systems[edge.u] != systems[edge.v]) {
+      cut += edge.weight;
+    }
+  }
+  return cut;
+}
+
+} // namespace ndn
+} // namespace ns3
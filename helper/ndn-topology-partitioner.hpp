@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_TOPOLOGY_PARTITIONER_H
+#define NDN_TOPOLOGY_PARTITIONER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <limits>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Weighted graph partitioner that assigns topology nodes to MPI systems
+ *
+ * Vertices are nodes with an estimate of their simulation load (e.g., one per router plus the
+ * expected number of applications on it) and a group, such as the AS of the node; edges are
+ * links.  Partition() assigns whole groups to systems where possible, so that cross-system
+ * links are mostly links between groups, and splits a group into connected pieces only when
+ * it does not fit on any system within the balance tolerance.  Boundary groups and vertices are
+ * then moved between systems as long as that reduces the number of cut links.
+ *
+ * The result depends only on the order of AddVertex and AddEdge calls, so that every MPI rank
+ * building the same topology computes the same assignment.
+ */
+class TopologyPartitioner {
+public:
+  typedef uint32_t VertexId;
+
+  static const VertexId INVALID_VERTEX = std::numeric_limits<VertexId>::max();
+
+  /**
+   * @brief Add vertex and return its ID (vertices are numbered consecutively from 0)
+   * @param weight expected load of the node, must not be negative
+   * @param group  group that should be kept on one system if possible (e.g., AS number)
+   */
+  VertexId
+  AddVertex(double weight, uint32_t group = 0);
+
+  /**
+   * @brief Add link between vertices \p u and \p v
+   * @param weight cost of cutting the link, e.g., 1 per link
+   */
+  void
+  AddEdge(VertexId u, VertexId v, double weight = 1.0);
+
+  size_t
+  GetNVertices() const;
+
+  /**
+   * @brief Assign every vertex to one of \p nSystems systems
+   * @param nSystems  number of systems (MPI ranks)
+   * @param imbalance allowed relative excess of the load of a system over the average load
+   * @return system ID of every vertex, indexed by vertex ID
+   */
+  std::vector<uint32_t>
+  Partition(uint32_t nSystems, double imbalance = 0.05) const;
+
+  /**
+   * @brief Get total load of every system for an assignment returned by Partition
+   */
+  std::vector<double>
+  GetLoads(const std::vector<uint32_t>& systems, uint32_t nSystems) const;
+
+  /**
+   * @brief Get total weight of edges between vertices on different systems
+   */
+  double
+  GetCutWeight(const std::vector<uint32_t>& systems) const;
+
+private:
+  class State;
+
+  struct Edge {
+    VertexId u;
+    VertexId v;
+    double weight;
+  };
+
+  std::vector<double> m_weights;
+  std::vector<uint32_t> m_groups;
+  std::vector<Edge> m_edges;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_TOPOLOGY_PARTITIONER_H
@@ -23,6 +23,7 @@
 #include "../../utils/trie/lru-policy.hpp"
 #include "../../utils/trie/fifo-policy.hpp"
 #include "../../utils/trie/lfu-policy.hpp"
+#include "../../utils/trie/bucket-lfu-policy.hpp"
 #include "../../utils/trie/multi-policy.hpp"
 #include "../../utils/trie/aggregate-stats-policy.hpp"
 
@@ -63,10 +64,35 @@ template class ContentStoreImpl<fifo_policy_traits>;
  **/
 template class ContentStoreImpl<lfu_policy_traits>;
 
+/**
+ * @brief ContentStore with Least Frequently Used (LFU) cache replacement policy using frequency
+ *        buckets (constant-time updates)
+ **/
+template class ContentStoreImpl<bucket_lfu_policy_traits>;
+
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, lru_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, random_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, fifo_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, lfu_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, bucket_lfu_policy_traits);
+
+/**
+ * @brief ContentStore that indexes entries with compact_trie
+ **/
+template<class Policy>
+using CompactContentStoreImpl = ContentStoreImpl<Policy, compact_trie>;
+
+template class ContentStoreImpl<lru_policy_traits, compact_trie>;
+template class ContentStoreImpl<random_policy_traits, compact_trie>;
+template class ContentStoreImpl<fifo_policy_traits, compact_trie>;
+template class ContentStoreImpl<lfu_policy_traits, compact_trie>;
+template class ContentStoreImpl<bucket_lfu_policy_traits, compact_trie>;
+
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(CompactContentStoreImpl, lru_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(CompactContentStoreImpl, random_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(CompactContentStoreImpl, fifo_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(CompactContentStoreImpl, lfu_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(CompactContentStoreImpl, bucket_lfu_policy_traits);
 
 typedef multi_policy_traits<boost::mpl::vector2<lru_policy_traits, aggregate_stats_policy_traits>>
   LruWithCountsTraits;
@@ -114,6 +140,45 @@ class Random : public ContentStoreImpl<random_policy_traits> {
  */
 class Lfu : public ContentStoreImpl<lfu_policy_traits> {
 };
+
+/**
+ * \brief Content Store implementing Least Frequently Used cache replacement policy with
+ *        constant-time updates
+ */
+class BucketLfu : public ContentStoreImpl<bucket_lfu_policy_traits> {
+};
+
+/**
+ * \brief Content Store implementing LRU cache replacement policy on top of compact_trie
+ */
+class Compact::Lru : public ContentStoreImpl<lru_policy_traits, compact_trie> {
+};
+
+/**
+ * \brief Content Store implementing FIFO cache replacement policy on top of compact_trie
+ */
+class Compact::Fifo : public ContentStoreImpl<fifo_policy_traits, compact_trie> {
+};
+
+/**
+ * \brief Content Store implementing Random cache replacement policy on top of compact_trie
+ */
+class Compact::Random : public ContentStoreImpl<random_policy_traits, compact_trie> {
+};
+
+/**
+ * \brief Content Store implementing Least Frequently Used cache replacement policy on top of
+ *        compact_trie
+ */
+class Compact::Lfu : public ContentStoreImpl<lfu_policy_traits, compact_trie> {
+};
+
+/**
+ * \brief Content Store implementing Least Frequently Used cache replacement policy with
+ *        constant-time updates on top of compact_trie
+ */
+class Compact::BucketLfu : public ContentStoreImpl<bucket_lfu_policy_traits, compact_trie> {
+};
 #endif
 
 } // namespace cs
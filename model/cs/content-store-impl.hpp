@@ -32,6 +32,7 @@
 #include "ns3/string.h"
 
 #include "../../utils/trie/trie-with-policy.hpp"
+#include "custom-policies/byte-budget-policy.hpp"
 
 namespace ns3 {
 namespace ndn {
@@ -74,30 +75,61 @@ private:
   typename CS::super::iterator item_;
 };
 
+/**
+ * @ingroup ndn-cs
+ * @brief Prefix of TypeId and log component names of content stores built on trie
+ *        implementation Trie (none for the original trie)
+ */
+template<template<typename, typename, typename> class Trie>
+struct TrieNamePrefix {
+  static std::string
+  Get(const std::string& separator)
+  {
+    return "";
+  }
+};
+
+template<>
+struct TrieNamePrefix<ndnSIM::compact_trie> {
+  static std::string
+  Get(const std::string& separator)
+  {
+    return "Compact" + separator;
+  }
+};
+
 /**
  * @ingroup ndn-cs
  * @brief Base implementation of NDN content store
+ *
+ * Capacity can be limited both in number of entries (MaxSize attribute) and in bytes
+ * (MaxBytes attribute). Eviction on either limit follows the replacement policy.
+ *
+ * Trie selects the trie implementation that indexes cached entries by name.  Content stores
+ * built on compact_trie are registered as ns3::ndn::cs::Compact::<policy>.
  */
-template<class Policy>
+template<class Policy, template<typename, typename, typename> class Trie = ndnSIM::trie>
 class ContentStoreImpl
   : public ContentStore,
     protected ndnSIM::
       trie_with_policy<Name,
-                       ndnSIM::smart_pointer_payload_traits<EntryImpl<ContentStoreImpl<Policy>>,
-                                                            Entry>,
-                       Policy> {
+                       ndnSIM::
+                         smart_pointer_payload_traits<EntryImpl<ContentStoreImpl<Policy, Trie>>,
+                                                      Entry>,
+                       ndnSIM::byte_budget_policy_traits<Policy>, Trie> {
 public:
   typedef ndnSIM::
-    trie_with_policy<Name, ndnSIM::smart_pointer_payload_traits<EntryImpl<ContentStoreImpl<Policy>>,
-                                                                Entry>,
-                     Policy> super;
+    trie_with_policy<Name,
+                     ndnSIM::smart_pointer_payload_traits<EntryImpl<ContentStoreImpl<Policy, Trie>>,
+                                                          Entry>,
+                     ndnSIM::byte_budget_policy_traits<Policy>, Trie> super;
 
-  typedef EntryImpl<ContentStoreImpl<Policy>> entry;
+  typedef EntryImpl<ContentStoreImpl<Policy, Trie>> entry;
 
   static TypeId
   GetTypeId();
 
-  ContentStoreImpl(){};
+  ContentStoreImpl();
   virtual ~ContentStoreImpl(){};
 
   // from ContentStore
@@ -117,6 +149,9 @@ public:
   virtual uint32_t
   GetSize() const;
 
+  virtual uint64_t
+  GetBytesInUse() const;
+
   virtual Ptr<Entry>
   Begin();
 
@@ -125,6 +160,9 @@ public:
 
   virtual Ptr<Entry> Next(Ptr<Entry>);
 
+  virtual void
+  ForEachInEvictionOrder(const std::function<void(Ptr<Entry>)>& visitor);
+
   const typename super::policy_container&
   GetPolicy() const
   {
@@ -144,44 +182,76 @@ private:
   uint32_t
   GetMaxSize() const;
 
+  void
+  SetMaxBytes(uint64_t maxBytes);
+
+  uint64_t
+  GetMaxBytes() const;
+
+  void
+  NotifyBytesInUse(uint64_t bytes);
+
 private:
   static LogComponent g_log; ///< @brief Logging variable
 
   /// @brief trace of for entry additions (fired every time entry is successfully added to the
   /// cache): first parameter is pointer to the CS entry
   TracedCallback<Ptr<const Entry>> m_didAddEntry;
+
+  /// @brief trace of bytes in use, fired every time the number changes
+  TracedCallback<uint64_t> m_bytesInUse;
 };
 
 //////////////////////////////////////////
 ////////// Implementation ////////////////
 //////////////////////////////////////////
 
-template<class Policy>
-LogComponent
-  ContentStoreImpl<Policy>::g_log = LogComponent(("ndn.cs." + Policy::GetName()).c_str());
+template<class Policy, template<typename, typename, typename> class Trie>
+LogComponent ContentStoreImpl<Policy, Trie>::g_log =
+  LogComponent(("ndn.cs." + TrieNamePrefix<Trie>::Get(".") + Policy::GetName()).c_str());
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename> class Trie>
 TypeId
-ContentStoreImpl<Policy>::GetTypeId()
+ContentStoreImpl<Policy, Trie>::GetTypeId()
 {
   static TypeId tid =
-    TypeId(("ns3::ndn::cs::" + Policy::GetName()).c_str())
+    TypeId(("ns3::ndn::cs::" + TrieNamePrefix<Trie>::Get("::") + Policy::GetName()).c_str())
       .SetGroupName("Ndn")
       .SetParent<ContentStore>()
-      .AddConstructor<ContentStoreImpl<Policy>>()
+      .AddConstructor<ContentStoreImpl<Policy, Trie>>()
       .AddAttribute("MaxSize",
                     "Set maximum number of entries in ContentStore. If 0, limit is not enforced",
-                    StringValue("100"), MakeUintegerAccessor(&ContentStoreImpl<Policy>::GetMaxSize,
-                                                             &ContentStoreImpl<Policy>::SetMaxSize),
+                    StringValue("100"),
+                    MakeUintegerAccessor(&ContentStoreImpl<Policy, Trie>::GetMaxSize,
+                                         &ContentStoreImpl<Policy, Trie>::SetMaxSize),
                     MakeUintegerChecker<uint32_t>())
 
+      .AddAttribute("MaxBytes",
+                    "Set maximum number of bytes in ContentStore, including per-entry overhead. "
+                    "If 0, limit is not enforced",
+                    StringValue("0"),
+                    MakeUintegerAccessor(&ContentStoreImpl<Policy, Trie>::GetMaxBytes,
+                                         &ContentStoreImpl<Policy, Trie>::SetMaxBytes),
+                    MakeUintegerChecker<uint64_t>())
+
       .AddTraceSource("DidAddEntry",
                       "Trace fired every time entry is successfully added to the cache",
-                      MakeTraceSourceAccessor(&ContentStoreImpl<Policy>::m_didAddEntry));
+                      MakeTraceSourceAccessor(&ContentStoreImpl<Policy, Trie>::m_didAddEntry))
+
+      .AddTraceSource("BytesInUse",
+                      "Trace fired every time number of bytes in use by the cache changes",
+                      MakeTraceSourceAccessor(&ContentStoreImpl<Policy, Trie>::m_bytesInUse));
 
   return tid;
 }
 
+template<class Policy, template<typename, typename, typename> class Trie>
+ContentStoreImpl<Policy, Trie>::ContentStoreImpl()
+{
+  this->getPolicy().set_bytes_callback(
+    MakeCallback(&ContentStoreImpl<Policy, Trie>::NotifyBytesInUse, this));
+}
+
 struct isNotExcluded {
   inline isNotExcluded(const Exclude& exclude)
     : m_exclude(exclude)
@@ -198,9 +268,9 @@ private:
   const Exclude& m_exclude;
 };
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename> class Trie>
 shared_ptr<Data>
-ContentStoreImpl<Policy>::Lookup(shared_ptr<const Interest> interest)
+ContentStoreImpl<Policy, Trie>::Lookup(shared_ptr<const Interest> interest)
 {
   NS_LOG_FUNCTION(this << interest->getName());
 
@@ -225,9 +295,9 @@ ContentStoreImpl<Policy>::Lookup(shared_ptr<const Interest> interest)
   }
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename> class Trie>
 bool
-ContentStoreImpl<Policy>::Add(shared_ptr<const Data> data)
+ContentStoreImpl<Policy, Trie>::Add(shared_ptr<const Data> data)
 {
   NS_LOG_FUNCTION(this << data->getName());
 
@@ -251,9 +321,9 @@ ContentStoreImpl<Policy>::Add(shared_ptr<const Data> data)
     return false; // cannot insert entry
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename> class Trie>
 void
-ContentStoreImpl<Policy>::Print(std::ostream& os) const
+ContentStoreImpl<Policy, Trie>::Print(std::ostream& os) const
 {
   for (typename super::policy_container::const_iterator item = this->getPolicy().begin();
        item != this->getPolicy().end(); item++) {
@@ -261,30 +331,58 @@ ContentStoreImpl<Policy>::Print(std::ostream& os) const
   }
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename> class Trie>
 void
-ContentStoreImpl<Policy>::SetMaxSize(uint32_t maxSize)
+ContentStoreImpl<Policy, Trie>::SetMaxSize(uint32_t maxSize)
 {
   this->getPolicy().set_max_size(maxSize);
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename> class Trie>
 uint32_t
-ContentStoreImpl<Policy>::GetMaxSize() const
+ContentStoreImpl<Policy, Trie>::GetMaxSize() const
 {
   return this->getPolicy().get_max_size();
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename> class Trie>
+void
+ContentStoreImpl<Policy, Trie>::SetMaxBytes(uint64_t maxBytes)
+{
+  this->getPolicy().set_max_bytes(maxBytes);
+}
+
+template<class Policy, template<typename, typename, typename> class Trie>
+uint64_t
+ContentStoreImpl<Policy, Trie>::GetMaxBytes() const
+{
+  return this->getPolicy().get_max_bytes();
+}
+
+template<class Policy, template<typename, typename, typename> class Trie>
+void
+ContentStoreImpl<Policy, Trie>::NotifyBytesInUse(uint64_t bytes)
+{
+  m_bytesInUse(bytes);
+}
+
+template<class Policy, template<typename, typename, typename> class Trie>
 uint32_t
-ContentStoreImpl<Policy>::GetSize() const
+ContentStoreImpl<Policy, Trie>::GetSize() const
 {
   return this->getPolicy().size();
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename> class Trie>
+uint64_t
+ContentStoreImpl<Policy, Trie>::GetBytesInUse() const
+{
+  return this->getPolicy().get_bytes();
+}
+
+template<class Policy, template<typename, typename, typename> class Trie>
 Ptr<Entry>
-ContentStoreImpl<Policy>::Begin()
+ContentStoreImpl<Policy, Trie>::Begin()
 {
   typename super::parent_trie::recursive_iterator item(super::getTrie()), end(0);
   for (; item != end; item++) {
@@ -299,16 +397,16 @@ ContentStoreImpl<Policy>::Begin()
     return item->payload();
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename> class Trie>
 Ptr<Entry>
-ContentStoreImpl<Policy>::End()
+ContentStoreImpl<Policy, Trie>::End()
 {
   return 0;
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename> class Trie>
 Ptr<Entry>
-ContentStoreImpl<Policy>::Next(Ptr<Entry> from)
+ContentStoreImpl<Policy, Trie>::Next(Ptr<Entry> from)
 {
   if (from == 0)
     return 0;
@@ -328,6 +426,18 @@ ContentStoreImpl<Policy>::Next(Ptr<Entry> from)
     return item->payload();
 }
 
+template<class Policy, template<typename, typename, typename> class Trie>
+void
+ContentStoreImpl<Policy, Trie>::ForEachInEvictionOrder(
+  const std::function<void(Ptr<Entry>)>& visitor)
+{
+  // the policy container is ordered by replacement priority, as used by Print
+  for (typename super::policy_container::iterator item = this->getPolicy().begin();
+       item != this->getPolicy().end(); item++) {
+    visitor(item->payload());
+  }
+}
+
 } // namespace cs
 } // namespace ndn
 } // namespace ns3
@@ -0,0 +1,238 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CONTENT_STORE_WITH_FRESHNESS_WHEEL_H_
+#define NDN_CONTENT_STORE_WITH_FRESHNESS_WHEEL_H_
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "content-store-impl.hpp"
+
+#include "../../utils/trie/multi-policy.hpp"
+#include "custom-policies/freshness-wheel-policy.hpp"
+#include "ns3/uinteger.h"
+#include "ns3/nstime.h"
+
+namespace ns3 {
+namespace ndn {
+namespace cs {
+
+/**
+ * @ingroup ndn-cs
+ * @brief Content store realization that honors Freshness parameter in Data packets using a
+ *        coarse time wheel
+ *
+ * Compared to ContentStoreWithFreshness, no event is scheduled or removed when Data packets are
+ * added.  Stale entries are removed by a single periodic sweep (every Granularity, only while
+ * there are entries with finite freshness), which may be up to one Granularity late.  A stale
+ * entry found by a lookup before the sweep got to it is removed at lookup time, so stale Data
+ * is never returned.
+ */
+template<class Policy>
+class ContentStoreWithFreshnessWheel
+  : public ContentStoreImpl<ndnSIM::
+                              multi_policy_traits<boost::mpl::
+                                                    vector2<Policy,
+                                                            ndnSIM::
+                                                              freshness_wheel_policy_traits>>> {
+public:
+  typedef ContentStoreImpl<ndnSIM::
+                             multi_policy_traits<boost::mpl::
+                                                   vector2<Policy,
+                                                           ndnSIM::freshness_wheel_policy_traits>>>
+    super;
+
+  typedef typename super::policy_container::template index<1>::type freshness_policy_container;
+
+  static TypeId
+  GetTypeId();
+
+  virtual inline void
+  Print(std::ostream& os) const;
+
+  virtual inline shared_ptr<Data>
+  Lookup(shared_ptr<const Interest> interest);
+
+  virtual inline bool
+  Add(shared_ptr<const Data> data);
+
+private:
+  inline void
+  Sweep();
+
+  void
+  SetGranularity(Time granularity)
+  {
+    freshness_policy_container& freshness =
+      this->getPolicy().template get<freshness_policy_container>();
+    freshness.configure(granularity, freshness.get_slots());
+  }
+
+  Time
+  GetGranularity() const
+  {
+    return this->getPolicy().template get<freshness_policy_container>().get_granularity();
+  }
+
+  void
+  SetSlots(uint32_t nSlots)
+  {
+    freshness_policy_container& freshness =
+      this->getPolicy().template get<freshness_policy_container>();
+    freshness.configure(freshness.get_granularity(), nSlots);
+  }
+
+  uint32_t
+  GetSlots() const
+  {
+    return this->getPolicy().template get<freshness_policy_container>().get_slots();
+  }
+
+private:
+  static LogComponent g_log; ///< @brief Logging variable
+
+  EventId m_sweepEvent;
+};
+
+//////////////////////////////////////////
+////////// Implementation ////////////////
+//////////////////////////////////////////
+
+template<class Policy>
+LogComponent ContentStoreWithFreshnessWheel<Policy>::g_log =
+  LogComponent(("ndn.cs.FreshnessWheel." + Policy::GetName()).c_str());
+
+template<class Policy>
+TypeId
+ContentStoreWithFreshnessWheel<Policy>::GetTypeId()
+{
+  static TypeId tid =
+    TypeId(("ns3::ndn::cs::FreshnessWheel::" + Policy::GetName()).c_str())
+      .SetGroupName("Ndn")
+      .SetParent<super>()
+      .template AddConstructor<ContentStoreWithFreshnessWheel<Policy>>()
+
+      .AddAttribute("Granularity",
+                    "Duration of one tick of the expiration wheel (period of stale entry sweep)",
+                    TimeValue(MilliSeconds(10)),
+                    MakeTimeAccessor(&ContentStoreWithFreshnessWheel<Policy>::SetGranularity,
+                                     &ContentStoreWithFreshnessWheel<Policy>::GetGranularity),
+                    MakeTimeChecker(NanoSeconds(1)))
+
+      .AddAttribute("Slots", "Number of slots in the expiration wheel (rounded up to power of 2)",
+                    UintegerValue(1024),
+                    MakeUintegerAccessor(&ContentStoreWithFreshnessWheel<Policy>::GetSlots,
+                                         &ContentStoreWithFreshnessWheel<Policy>::SetSlots),
+                    MakeUintegerChecker<uint32_t>(1));
+
+  return tid;
+}
+
+template<class Policy>
+inline shared_ptr<Data>
+ContentStoreWithFreshnessWheel<Policy>::Lookup(shared_ptr<const Interest> interest)
+{
+  NS_LOG_FUNCTION(this << interest->getName());
+
+  Time now = Simulator::Now();
+  typename super::iterator node;
+  while (true) {
+    if (interest->getExclude().empty()) {
+      node = this->deepest_prefix_match(interest->getName());
+    }
+    else {
+      node = this->deepest_prefix_match_if_next_level(interest->getName(),
+                                                      isNotExcluded(interest->getExclude()));
+    }
+
+    if (node == this->end() || !freshness_policy_container::is_stale(node, now))
+      break;
+
+    // the sweep has not reached this entry yet
+    NS_LOG_DEBUG(node->payload()->GetName() << " is stale, removing");
+    super::erase(node);
+  }
+
+  if (node != this->end()) {
+    this->m_cacheHitsTrace(interest, node->payload()->GetData());
+
+    shared_ptr<Data> copy = make_shared<Data>(*node->payload()->GetData());
+    return copy;
+  }
+  else {
+    this->m_cacheMissesTrace(interest);
+    return 0;
+  }
+}
+
+template<class Policy>
+inline bool
+ContentStoreWithFreshnessWheel<Policy>::Add(shared_ptr<const Data> data)
+{
+  bool ok = super::Add(data);
+  if (!ok)
+    return false;
+
+  NS_LOG_DEBUG(data->getName() << " added to cache");
+  if (!m_sweepEvent.IsRunning()
+      && !this->getPolicy().template get<freshness_policy_container>().empty()) {
+    m_sweepEvent = Simulator::Schedule(GetGranularity(),
+                                       &ContentStoreWithFreshnessWheel<Policy>::Sweep, this);
+  }
+  return true;
+}
+
+template<class Policy>
+inline void
+ContentStoreWithFreshnessWheel<Policy>::Sweep()
+{
+  freshness_policy_container& freshness =
+    this->getPolicy().template get<freshness_policy_container>();
+
+  freshness.expire(Simulator::Now());
+
+  if (!freshness.empty()) {
+    m_sweepEvent = Simulator::Schedule(freshness.get_granularity(),
+                                       &ContentStoreWithFreshnessWheel<Policy>::Sweep, this);
+  }
+}
+
+template<class Policy>
+void
+ContentStoreWithFreshnessWheel<Policy>::Print(std::ostream& os) const
+{
+  for (typename super::policy_container::const_iterator item = this->getPolicy().begin();
+       item != this->getPolicy().end(); item++) {
+    time::milliseconds freshness = item->payload()->GetData()->getFreshnessPeriod();
+    if (freshness > time::milliseconds::zero()) {
+      Time ttl =
+        freshness_policy_container::policy_base::get_freshness(&(*item)) - Simulator::Now();
+      os << item->payload()->GetName() << "(left: " << ttl.ToDouble(Time::S) << "s)" << std::endl;
+    }
+    else {
+      os << item->payload()->GetName() << std::endl;
+    }
+  }
+}
+
+} // namespace cs
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONTENT_STORE_WITH_FRESHNESS_WHEEL_H_
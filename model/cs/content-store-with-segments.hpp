@@ -0,0 +1,795 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CONTENT_STORE_WITH_SEGMENTS_H_
+#define NDN_CONTENT_STORE_WITH_SEGMENTS_H_
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "content-store-impl.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+namespace cs {
+
+/**
+ * @ingroup ndn-cs
+ * @brief Cache entry that holds all cached chunks of one object
+ *
+ * Chunks are Data packets whose last name component is a sequence number, as requested by
+ * FileConsumer and its DASH descendants.  Wire encodings of the chunks are appended to a slab
+ * made of append-only pages, while a bitmap and a location table, indexed by sequence number,
+ * locate them.  A Data packet named exactly as the object prefix can be kept in the same entry.
+ *
+ * The entry stores only the object prefix and the wire encodings, and is not a cs::Entry itself.
+ * ContentStoreWithSegments exposes each cached packet as a separate cs::Entry when iterating.
+ */
+class ObjectEntry : public SimpleRefCount<ObjectEntry> {
+public:
+  /// @brief maximum distance between the lowest and the highest chunk of an entry
+  static const uint64_t MAX_SPAN = 1 << 20;
+
+  /// @brief maximum size of a slab page, unless a single chunk is larger
+  static const size_t MAX_PAGE_SIZE = 256 * 1024;
+
+  explicit ObjectEntry(const Name& prefix)
+    : m_prefix(prefix)
+    , m_firstSeqNo(0)
+    , m_nChunks(0)
+    , m_nSlabBytes(0)
+  {
+  }
+
+  /**
+   * @brief Get prefix of the object
+   */
+  const Name&
+  GetName() const
+  {
+    return m_prefix;
+  }
+
+  /**
+   * @brief Check whether the chunk falls into the range that the entry can index
+   */
+  bool
+  CanHoldChunk(uint64_t seqNo) const
+  {
+    return m_nChunks == 0 || (seqNo >= m_firstSeqNo && seqNo - m_firstSeqNo < MAX_SPAN);
+  }
+
+  bool
+  HasChunk(uint64_t seqNo) const
+  {
+    if (m_nChunks == 0 || seqNo < m_firstSeqNo || seqNo - m_firstSeqNo >= m_locations.size())
+      return false;
+
+    size_t index = seqNo - m_firstSeqNo;
+    return (m_bitmap[index / 64] & (uint64_t(1) << (index % 64))) != 0;
+  }
+
+  /**
+   * @brief Find the lowest cached chunk with sequence number not less than @p seqNo
+   * @returns false if there is no such chunk
+   */
+  bool
+  FindChunkFrom(uint64_t seqNo, uint64_t& found) const
+  {
+    size_t index = seqNo > m_firstSeqNo ? seqNo - m_firstSeqNo : 0;
+    for (size_t word = index / 64; word < m_bitmap.size(); ++word) {
+      uint64_t bits = m_bitmap[word];
+      if (word == index / 64)
+        bits &= ~uint64_t(0) << (index % 64);
+
+      if (bits != 0) {
+        size_t bit = 0;
+        while ((bits & (uint64_t(1) << bit)) == 0)
+          ++bit;
+        found = m_firstSeqNo + word * 64 + bit;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Copy wire encoding of a chunk into the entry
+   * @returns false if the chunk is already cached
+   */
+  bool
+  AddChunk(uint64_t seqNo, const Data& data)
+  {
+    NS_ASSERT(CanHoldChunk(seqNo));
+
+    if (HasChunk(seqNo))
+      return false;
+
+    if (m_nChunks == 0) {
+      // most objects are numbered from zero or one, large numbers start their own range
+      m_firstSeqNo = (seqNo < MAX_SPAN) ? 0 : seqNo;
+    }
+
+    size_t index = seqNo - m_firstSeqNo;
+    if (index >= m_locations.size()) {
+      m_locations.resize(index + 1);
+      m_bitmap.resize(index / 64 + 1, 0);
+    }
+
+    const Block& wire = data.wireEncode();
+    ::ndn::Buffer& page = AllocatePage(wire.size());
+
+    ChunkLocation& location = m_locations[index];
+    location.page = m_pages.size() - 1;
+    location.offset = page.size();
+    location.size = wire.size();
+
+    // the page has enough capacity, so it is never reallocated and Blocks returned by
+    // GetChunk stay valid
+    page.insert(page.end(), wire.wire(), wire.wire() + wire.size());
+    m_nSlabBytes += wire.size();
+
+    m_bitmap[index / 64] |= uint64_t(1) << (index % 64);
+    ++m_nChunks;
+    return true;
+  }
+
+  /**
+   * @brief Get a cached chunk
+   *
+   * The returned Data is decoded from a Block that shares the slab page, so the wire encoding
+   * is not copied.
+   *
+   * @returns the chunk, or nullptr if it is not cached
+   */
+  shared_ptr<Data>
+  GetChunk(uint64_t seqNo) const
+  {
+    if (!HasChunk(seqNo))
+      return nullptr;
+
+    const ChunkLocation& location = m_locations[seqNo - m_firstSeqNo];
+    const shared_ptr< ::ndn::Buffer>& page = m_pages[location.page];
+    ::ndn::Buffer::const_iterator begin = page->begin() + location.offset;
+    return make_shared<Data>(Block(page, begin, begin + location.size));
+  }
+
+  /**
+   * @brief Store a Data packet named exactly as the object prefix
+   * @returns false if such packet is already cached
+   */
+  bool
+  SetWhole(shared_ptr<const Data> data)
+  {
+    if (m_whole != nullptr)
+      return false;
+
+    m_whole = data;
+    return true;
+  }
+
+  /**
+   * @brief Get the Data packet named exactly as the object prefix, if cached
+   */
+  shared_ptr<const Data>
+  GetWhole() const
+  {
+    return m_whole;
+  }
+
+  /**
+   * @brief Get any cached Data of the object: the one named as the object prefix if present,
+   *        otherwise the lowest cached chunk
+   */
+  shared_ptr<Data>
+  GetAny() const
+  {
+    if (m_whole != nullptr)
+      return make_shared<Data>(*m_whole);
+
+    uint64_t seqNo = 0;
+    if (FindChunkFrom(m_firstSeqNo, seqNo))
+      return GetChunk(seqNo);
+
+    return nullptr;
+  }
+
+  /**
+   * @brief Get number of Data packets in the entry
+   */
+  size_t
+  GetNPackets() const
+  {
+    return m_nChunks + (m_whole != nullptr ? 1 : 0);
+  }
+
+  /**
+   * @brief Get number of bytes used by the entry, including allocated but unused page space
+   */
+  uint64_t
+  GetBytes() const
+  {
+    uint64_t bytes = sizeof(*this) + m_bitmap.capacity() * sizeof(uint64_t)
+                     + m_locations.capacity() * sizeof(ChunkLocation)
+                     + m_pages.capacity() * sizeof(shared_ptr< ::ndn::Buffer>);
+    for (const auto& page : m_pages) {
+      bytes += sizeof(::ndn::Buffer) + page->capacity();
+    }
+    if (m_whole != nullptr) {
+      bytes += sizeof(Data) + m_whole->wireEncode().size();
+    }
+    return bytes;
+  }
+
+private:
+  /**
+   * @brief Get the last page, after making sure that it can hold @p size more bytes
+   *
+   * Pages grow geometrically with the amount of cached data, so that small objects waste little
+   * space and large objects need few pages.
+   */
+  ::ndn::Buffer&
+  AllocatePage(size_t size)
+  {
+    if (m_pages.empty() || m_pages.back()->capacity() - m_pages.back()->size() < size) {
+      size_t maxPageSize = MAX_PAGE_SIZE;
+      auto page = make_shared< ::ndn::Buffer>();
+      page->reserve(std::max(size, std::min(maxPageSize, m_nSlabBytes)));
+      m_pages.push_back(page);
+    }
+    return *m_pages.back();
+  }
+
+private:
+  struct ChunkLocation {
+    uint32_t page;
+    uint32_t offset;
+    uint32_t size;
+  };
+
+  Name m_prefix;
+  uint64_t m_firstSeqNo;
+  size_t m_nChunks;
+  size_t m_nSlabBytes;
+  std::vector<uint64_t> m_bitmap;
+  std::vector<ChunkLocation> m_locations;
+  std::vector<shared_ptr< ::ndn::Buffer>> m_pages;
+  shared_ptr<const Data> m_whole;
+};
+
+/**
+ * @ingroup ndn-cs
+ * @brief Content store entry that represents one Data packet of an ObjectEntry
+ *
+ * Created on demand when the content store is iterated, and remembers its position in the
+ * object, so that iteration can continue from it.
+ */
+template<class CS>
+class ChunkEntry : public Entry {
+public:
+  ChunkEntry(Ptr<ContentStore> cs, shared_ptr<const Data> data,
+             typename CS::super::iterator item, bool isWhole, uint64_t seqNo)
+    : Entry(cs, data)
+    , m_item(item)
+    , m_isWhole(isWhole)
+    , m_seqNo(seqNo)
+  {
+  }
+
+  typename CS::super::iterator
+  to_iterator() const
+  {
+    return m_item;
+  }
+
+  bool
+  IsWhole() const
+  {
+    return m_isWhole;
+  }
+
+  uint64_t
+  GetSeqNo() const
+  {
+    return m_seqNo;
+  }
+
+private:
+  typename CS::super::iterator m_item;
+  bool m_isWhole;
+  uint64_t m_seqNo;
+};
+
+/**
+ * @ingroup ndn-cs
+ * @brief Content store that groups chunks of the same object into a single entry
+ *
+ * Each cached object occupies one trie node and one position in the replacement policy, so that
+ * the whole object is evicted at once.  MaxSize limits the number of cached Data packets and
+ * MaxBytes limits the bytes used by objects, including per-object overhead.
+ * Data packets whose name does not end with a sequence number are cached individually.
+ *
+ * Begin() and Next() enumerate every cached Data packet, not every object.
+ */
+template<class Policy>
+class ContentStoreWithSegments
+  : public ContentStore,
+    protected ndnSIM::
+      trie_with_policy<Name,
+                       ndnSIM::smart_pointer_payload_traits<ObjectEntry>,
+                       Policy> {
+public:
+  typedef ndnSIM::
+    trie_with_policy<Name,
+                     ndnSIM::smart_pointer_payload_traits<ObjectEntry>,
+                     Policy> super;
+
+  typedef ObjectEntry entry;
+  typedef ChunkEntry<ContentStoreWithSegments<Policy>> chunk_entry;
+
+  static TypeId
+  GetTypeId();
+
+  ContentStoreWithSegments();
+  virtual ~ContentStoreWithSegments(){};
+
+  // from ContentStore
+
+  virtual inline shared_ptr<Data>
+  Lookup(shared_ptr<const Interest> interest);
+
+  virtual inline bool
+  Add(shared_ptr<const Data> data);
+
+  virtual inline void
+  Print(std::ostream& os) const;
+
+  virtual uint32_t
+  GetSize() const;
+
+  virtual uint64_t
+  GetBytesInUse() const;
+
+  virtual Ptr<Entry>
+  Begin();
+
+  virtual Ptr<Entry>
+  End();
+
+  virtual Ptr<Entry> Next(Ptr<Entry>);
+
+  virtual void
+  ForEachInEvictionOrder(const std::function<void(Ptr<Entry>)>& visitor);
+
+private:
+  static bool
+  IsChunk(const Name& name, uint64_t& seqNo);
+
+  /**
+   * @brief Get number of bytes charged to an object, including its trie node
+   */
+  static uint64_t
+  GetObjectBytes(typename super::const_iterator node);
+
+  /**
+   * @brief Create iteration entry for the first Data packet of the object at @p node,
+   *        or the first packet following the one at (@p isWhole, @p seqNo)
+   */
+  Ptr<Entry>
+  MakeChunkEntry(typename super::iterator node, bool isAfter, bool isWhole, uint64_t seqNo);
+
+  /**
+   * @brief Evict whole objects, except for the one that was just updated, until the number of
+   *        cached Data packets is within MaxSize and the number of bytes is within MaxBytes
+   */
+  void
+  EvictExcept(typename super::iterator keep);
+
+  void
+  SetMaxSize(uint32_t maxSize);
+
+  uint32_t
+  GetMaxSize() const;
+
+  void
+  SetMaxBytes(uint64_t maxBytes);
+
+  uint64_t
+  GetMaxBytes() const;
+
+  void
+  SetBytesInUse(uint64_t bytes);
+
+private:
+  static LogComponent g_log; ///< @brief Logging variable
+
+  uint32_t m_maxSize;
+  uint32_t m_nPackets;
+  uint64_t m_maxBytes;
+  uint64_t m_nBytes;
+
+  /// @brief trace of for entry additions (fired every time a new object is added to the cache):
+  /// first parameter is pointer to the CS entry of the Data packet that created the object
+  TracedCallback<Ptr<const Entry>> m_didAddEntry;
+
+  /// @brief trace of bytes in use, fired every time the number changes
+  TracedCallback<uint64_t> m_bytesInUse;
+};
+
+//////////////////////////////////////////
+////////// Implementation ////////////////
+//////////////////////////////////////////
+
+template<class Policy>
+LogComponent ContentStoreWithSegments<Policy>::g_log = LogComponent(("ndn.cs.Segments."
+                                                                     + Policy::GetName()).c_str());
+
+template<class Policy>
+TypeId
+ContentStoreWithSegments<Policy>::GetTypeId()
+{
+  static TypeId tid =
+    TypeId(("ns3::ndn::cs::Segments::" + Policy::GetName()).c_str())
+      .SetGroupName("Ndn")
+      .SetParent<ContentStore>()
+      .template AddConstructor<ContentStoreWithSegments<Policy>>()
+      .AddAttribute("MaxSize",
+                    "Set maximum number of Data packets in ContentStore. If 0, limit is not "
+                    "enforced",
+                    StringValue("100"),
+                    MakeUintegerAccessor(&ContentStoreWithSegments<Policy>::GetMaxSize,
+                                         &ContentStoreWithSegments<Policy>::SetMaxSize),
+                    MakeUintegerChecker<uint32_t>())
+
+      .AddAttribute("MaxBytes",
+                    "Set maximum number of bytes in ContentStore, including per-object overhead. "
+                    "If 0, limit is not enforced",
+                    StringValue("0"),
+                    MakeUintegerAccessor(&ContentStoreWithSegments<Policy>::GetMaxBytes,
+                                         &ContentStoreWithSegments<Policy>::SetMaxBytes),
+                    MakeUintegerChecker<uint64_t>())
+
+      .AddTraceSource("DidAddEntry",
+                      "Trace fired every time a new object is added to the cache",
+                      MakeTraceSourceAccessor(&ContentStoreWithSegments<Policy>::m_didAddEntry))
+
+      .AddTraceSource("BytesInUse",
+                      "Trace fired every time number of bytes in use by the cache changes",
+                      MakeTraceSourceAccessor(&ContentStoreWithSegments<Policy>::m_bytesInUse));
+
+  return tid;
+}
+
+template<class Policy>
+ContentStoreWithSegments<Policy>::ContentStoreWithSegments()
+  : m_maxSize(100)
+  , m_nPackets(0)
+  , m_maxBytes(0)
+  , m_nBytes(0)
+{
+  // the policy orders objects, while the limits apply to packets and bytes
+  this->getPolicy().set_max_size(0);
+}
+
+template<class Policy>
+bool
+ContentStoreWithSegments<Policy>::IsChunk(const Name& name, uint64_t& seqNo)
+{
+  if (name.empty() || !name.get(-1).isSequenceNumber())
+    return false;
+
+  seqNo = name.get(-1).toSequenceNumber();
+  return true;
+}
+
+template<class Policy>
+uint64_t
+ContentStoreWithSegments<Policy>::GetObjectBytes(typename super::const_iterator node)
+{
+  return node->payload()->GetBytes() + sizeof(typename super::parent_trie);
+}
+
+template<class Policy>
+shared_ptr<Data>
+ContentStoreWithSegments<Policy>::Lookup(shared_ptr<const Interest> interest)
+{
+  NS_LOG_FUNCTION(this << interest->getName());
+
+  const Name& name = interest->getName();
+  shared_ptr<Data> data;
+
+  uint64_t seqNo = 0;
+  if (IsChunk(name, seqNo)) {
+    typename super::iterator node = this->find_exact(name.getPrefix(-1));
+    if (node != this->end()) {
+      data = node->payload()->GetChunk(seqNo);
+      if (data != nullptr) {
+        this->getPolicy().lookup(node);
+      }
+    }
+  }
+
+  if (data == nullptr) {
+    typename super::iterator node;
+    if (interest->getExclude().empty()) {
+      node = this->deepest_prefix_match(name);
+    }
+    else {
+      node = this->deepest_prefix_match_if_next_level(name, isNotExcluded(interest->getExclude()));
+    }
+
+    if (node != this->end()) {
+      data = node->payload()->GetAny();
+    }
+  }
+
+  if (data != nullptr) {
+    this->m_cacheHitsTrace(interest, data);
+  }
+  else {
+    this->m_cacheMissesTrace(interest);
+  }
+  return data;
+}
+
+template<class Policy>
+bool
+ContentStoreWithSegments<Policy>::Add(shared_ptr<const Data> data)
+{
+  NS_LOG_FUNCTION(this << data->getName());
+
+  uint64_t seqNo = 0;
+  bool isChunk = IsChunk(data->getName(), seqNo);
+  Name key = isChunk ? data->getName().getPrefix(-1) : data->getName();
+
+  typename super::iterator node = this->find_exact(key);
+  if (isChunk && node != this->end() && !node->payload()->CanHoldChunk(seqNo)) {
+    // too far from the other chunks of the object, cache individually
+    isChunk = false;
+    key = data->getName();
+    node = this->find_exact(key);
+  }
+
+  uint64_t oldBytes = 0;
+  if (node == this->end()) {
+    if (m_maxBytes != 0 && data->wireEncode().size() > m_maxBytes)
+      return false; // packet alone exceeds the budget
+
+    Ptr<entry> newEntry = Create<entry>(key);
+    std::pair<typename super::iterator, bool> result = super::insert(key, newEntry);
+    if (result.first == super::end() || !result.second)
+      return false; // cannot insert entry
+
+    node = result.first;
+    m_didAddEntry(Create<chunk_entry>(this, data, node, !isChunk, seqNo));
+  }
+  else if (m_maxSize != 0 && node->payload()->GetNPackets() >= m_maxSize) {
+    return false; // object alone fills the cache
+  }
+  else if (m_maxBytes != 0 && GetObjectBytes(node) + data->wireEncode().size() > m_maxBytes) {
+    return false; // object alone fills the byte budget
+  }
+  else {
+    oldBytes = GetObjectBytes(node);
+  }
+
+  bool isAdded = isChunk ? node->payload()->AddChunk(seqNo, *data)
+                         : node->payload()->SetWhole(data);
+  if (!isAdded)
+    return false;
+
+  ++m_nPackets;
+  SetBytesInUse(m_nBytes - oldBytes + GetObjectBytes(node));
+  this->getPolicy().update(node);
+  EvictExcept(node);
+  return true;
+}
+
+template<class Policy>
+void
+ContentStoreWithSegments<Policy>::EvictExcept(typename super::iterator keep)
+{
+  while ((m_maxSize != 0 && m_nPackets > m_maxSize)
+         || (m_maxBytes != 0 && m_nBytes > m_maxBytes)) {
+    typename super::policy_container::iterator victim = this->getPolicy().begin();
+    if (victim != this->getPolicy().end() && &(*victim) == keep) {
+      ++victim;
+    }
+    if (victim == this->getPolicy().end())
+      break;
+
+    NS_LOG_DEBUG("Evicting " << victim->payload()->GetNPackets() << " packets of "
+                             << victim->payload()->GetName());
+    m_nPackets -= victim->payload()->GetNPackets();
+    SetBytesInUse(m_nBytes - GetObjectBytes(&(*victim)));
+    super::erase(&(*victim));
+  }
+}
+
+template<class Policy>
+void
+ContentStoreWithSegments<Policy>::Print(std::ostream& os) const
+{
+  for (typename super::policy_container::const_iterator item = this->getPolicy().begin();
+       item != this->getPolicy().end(); item++) {
+    const entry& object = *item->payload();
+    if (object.GetWhole() != nullptr) {
+      os << object.GetName() << std::endl;
+    }
+
+    uint64_t seqNo = 0;
+    for (bool hasChunk = object.FindChunkFrom(0, seqNo); hasChunk;
+         hasChunk = object.FindChunkFrom(seqNo + 1, seqNo)) {
+      os << Name(object.GetName()).appendSequenceNumber(seqNo) << std::endl;
+    }
+  }
+}
+
+template<class Policy>
+void
+ContentStoreWithSegments<Policy>::SetMaxSize(uint32_t maxSize)
+{
+  m_maxSize = maxSize;
+  EvictExcept(super::end());
+}
+
+template<class Policy>
+uint32_t
+ContentStoreWithSegments<Policy>::GetMaxSize() const
+{
+  return m_maxSize;
+}
+
+template<class Policy>
+void
+ContentStoreWithSegments<Policy>::SetMaxBytes(uint64_t maxBytes)
+{
+  m_maxBytes = maxBytes;
+  EvictExcept(super::end());
+}
+
+template<class Policy>
+uint64_t
+ContentStoreWithSegments<Policy>::GetMaxBytes() const
+{
+  return m_maxBytes;
+}
+
+template<class Policy>
+void
+ContentStoreWithSegments<Policy>::SetBytesInUse(uint64_t bytes)
+{
+  m_nBytes = bytes;
+  m_bytesInUse(m_nBytes);
+}
+
+template<class Policy>
+uint32_t
+ContentStoreWithSegments<Policy>::GetSize() const
+{
+  return m_nPackets;
+}
+
+template<class Policy>
+uint64_t
+ContentStoreWithSegments<Policy>::GetBytesInUse() const
+{
+  return m_nBytes;
+}
+
+template<class Policy>
+Ptr<Entry>
+ContentStoreWithSegments<Policy>::MakeChunkEntry(typename super::iterator node, bool isAfter,
+                                                 bool isWhole, uint64_t seqNo)
+{
+  const entry& object = *node->payload();
+
+  if (!isAfter && object.GetWhole() != nullptr) {
+    return Create<chunk_entry>(this, object.GetWhole(), node, true, 0);
+  }
+
+  uint64_t from = 0;
+  if (isAfter && !isWhole) {
+    from = seqNo + 1;
+    if (from == 0)
+      return End(); // wrapped around after the largest sequence number
+  }
+
+  uint64_t found = 0;
+  if (object.FindChunkFrom(from, found)) {
+    return Create<chunk_entry>(this, object.GetChunk(found), node, false, found);
+  }
+  return End();
+}
+
+template<class Policy>
+Ptr<Entry>
+ContentStoreWithSegments<Policy>::Begin()
+{
+  typename super::parent_trie::recursive_iterator item(super::getTrie()), end(0);
+  for (; item != end; item++) {
+    if (item->payload() == 0)
+      continue;
+
+    Ptr<Entry> first = MakeChunkEntry(&(*item), false, false, 0);
+    if (first != End())
+      return first;
+  }
+
+  return End();
+}
+
+template<class Policy>
+Ptr<Entry>
+ContentStoreWithSegments<Policy>::End()
+{
+  return 0;
+}
+
+template<class Policy>
+Ptr<Entry>
+ContentStoreWithSegments<Policy>::Next(Ptr<Entry> from)
+{
+  if (from == 0)
+    return 0;
+
+  Ptr<chunk_entry> current = StaticCast<chunk_entry>(from);
+  Ptr<Entry> next = MakeChunkEntry(current->to_iterator(), true, current->IsWhole(),
+                                   current->GetSeqNo());
+  if (next != End())
+    return next;
+
+  typename super::parent_trie::recursive_iterator item(*current->to_iterator()), end(0);
+  for (item++; item != end; item++) {
+    if (item->payload() == 0)
+      continue;
+
+    next = MakeChunkEntry(&(*item), false, false, 0);
+    if (next != End())
+      return next;
+  }
+
+  return End();
+}
+
+template<class Policy>
+void
+ContentStoreWithSegments<Policy>::ForEachInEvictionOrder(
+  const std::function<void(Ptr<Entry>)>& visitor)
+{
+  // objects in the order of the policy, packets of each object in the order of Next()
+  for (typename super::policy_container::iterator item = this->getPolicy().begin();
+       item != this->getPolicy().end(); item++) {
+    Ptr<Entry> chunk = MakeChunkEntry(&(*item), false, false, 0);
+    while (chunk != End()) {
+      visitor(chunk);
+
+      Ptr<chunk_entry> current = StaticCast<chunk_entry>(chunk);
+      chunk = MakeChunkEntry(&(*item), true, current->IsWhole(), current->GetSeqNo());
+    }
+  }
+}
+
+} // namespace cs
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONTENT_STORE_WITH_SEGMENTS_H_
@@ -0,0 +1,103 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CONTENT_STORE_WITH_TINYLFU_H_
+#define NDN_CONTENT_STORE_WITH_TINYLFU_H_
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "content-store-impl.hpp"
+
+#include "../../utils/trie/multi-policy.hpp"
+#include "custom-policies/tinylfu-policy.hpp"
+#include "ns3/uinteger.h"
+#include "ns3/type-id.h"
+
+namespace ns3 {
+namespace ndn {
+namespace cs {
+
+/**
+ * @ingroup ndn-cs
+ * @brief Special content store realization that admits data packet into CS only if it is
+ *        estimated to be accessed more frequently than the packet it would replace (TinyLFU
+ *        admission policy)
+ */
+template<class Policy>
+class ContentStoreWithTinyLfu
+  : public ContentStoreImpl<ndnSIM::multi_policy_traits<boost::mpl::
+                                                          vector2<Policy,
+                                                                  ndnSIM::tinylfu_policy_traits>>> {
+public:
+  typedef ContentStoreImpl<ndnSIM::multi_policy_traits<boost::mpl::
+                                                         vector2<Policy,
+                                                                 ndnSIM::tinylfu_policy_traits>>>
+    super;
+
+  typedef typename super::policy_container::template index<1>::type tinylfu_policy_container;
+
+  ContentStoreWithTinyLfu(){};
+
+  static TypeId
+  GetTypeId();
+
+private:
+  void
+  SetSampleFactor(uint32_t sampleFactor)
+  {
+    this->getPolicy().template get<tinylfu_policy_container>().set_sample_factor(sampleFactor);
+  }
+
+  uint32_t
+  GetSampleFactor() const
+  {
+    return this->getPolicy().template get<tinylfu_policy_container>().get_sample_factor();
+  }
+};
+
+//////////////////////////////////////////
+////////// Implementation ////////////////
+//////////////////////////////////////////
+
+template<class Policy>
+TypeId
+ContentStoreWithTinyLfu<Policy>::GetTypeId()
+{
+  static TypeId tid =
+    TypeId(("ns3::ndn::cs::TinyLfu::" + Policy::GetName()).c_str())
+      .SetGroupName("Ndn")
+      .SetParent<super>()
+      .template AddConstructor<ContentStoreWithTinyLfu<Policy>>()
+
+      .AddAttribute("SampleFactor",
+                    "Number of recorded accesses, as a multiple of MaxSize, after which "
+                    "frequency estimates are halved",
+                    UintegerValue(10),
+                    MakeUintegerAccessor(&ContentStoreWithTinyLfu<Policy>::GetSampleFactor,
+                                         &ContentStoreWithTinyLfu<Policy>::SetSampleFactor),
+                    MakeUintegerChecker<uint32_t>(1));
+
+  return tid;
+}
+
+} // namespace cs
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONTENT_STORE_WITH_TINYLFU_H_
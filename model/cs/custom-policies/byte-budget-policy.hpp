@@ -0,0 +1,178 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef BYTE_BUDGET_POLICY_H_
+#define BYTE_BUDGET_POLICY_H_
+
+/// @cond include_hidden
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <ns3/callback.h>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits that add byte accounting to another replacement policy
+ *
+ * Each item is charged the wire-encoded size of its Data packet plus the size of its trie node,
+ * cache entry, and Data object. When the byte budget is exceeded, items are evicted from the
+ * front of the wrapped policy, that is, in the same order as the wrapped policy evicts
+ * on its packet limit.
+ */
+template<class Policy>
+struct byte_budget_policy_traits {
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string
+  GetName()
+  {
+    return Policy::GetName();
+  }
+
+  typedef typename Policy::policy_hook_type policy_hook_type;
+
+  template<class Container>
+  struct container_hook {
+    typedef typename Policy::template container_hook<Container>::type type;
+  };
+
+  template<class Base, class Container, class Hook>
+  struct policy {
+    typedef typename Policy::template policy<Base, Container, Hook>::type policy_container;
+
+    class type : public policy_container {
+    public:
+      typedef Container parent_trie;
+
+      type(Base& base)
+        : policy_container(base)
+        , base_(base)
+        , max_bytes_(0)
+        , bytes_(0)
+      {
+      }
+
+      inline bool
+      insert(typename parent_trie::iterator item)
+      {
+        size_t itemBytes = get_item_bytes(item);
+        if (max_bytes_ != 0 && itemBytes > max_bytes_)
+          return false;
+
+        if (!policy_container::insert(item))
+          return false;
+
+        set_bytes(bytes_ + itemBytes);
+
+        // the new item is the only one that fits into the budget on its own, so it is never
+        // chosen for eviction
+        while (max_bytes_ != 0 && bytes_ > max_bytes_) {
+          typename policy_container::iterator victim = policy_container::begin();
+          if (&(*victim) == item) {
+            ++victim;
+          }
+          base_.erase(&(*victim));
+        }
+        return true;
+      }
+
+      inline void
+      erase(typename parent_trie::iterator item)
+      {
+        set_bytes(bytes_ - get_item_bytes(item));
+        policy_container::erase(item);
+      }
+
+      inline void
+      clear()
+      {
+        set_bytes(0);
+        policy_container::clear();
+      }
+
+      inline void
+      set_max_bytes(uint64_t max_bytes)
+      {
+        max_bytes_ = max_bytes;
+
+        while (max_bytes_ != 0 && bytes_ > max_bytes_) {
+          base_.erase(&(*policy_container::begin()));
+        }
+      }
+
+      inline uint64_t
+      get_max_bytes() const
+      {
+        return max_bytes_;
+      }
+
+      inline uint64_t
+      get_bytes() const
+      {
+        return bytes_;
+      }
+
+      /**
+       * @brief Set callback invoked with the new number of bytes every time it changes
+       */
+      inline void
+      set_bytes_callback(const Callback<void, uint64_t>& callback)
+      {
+        bytes_callback_ = callback;
+      }
+
+    private:
+      static uint64_t
+      get_item_bytes(typename parent_trie::iterator item)
+      {
+        return item->payload()->GetData()->wireEncode().size() + sizeof(parent_trie)
+               + sizeof(typename parent_trie::payload_traits::payload_type) + sizeof(Data);
+      }
+
+      inline void
+      set_bytes(uint64_t bytes)
+      {
+        bytes_ = bytes;
+        if (!bytes_callback_.IsNull()) {
+          bytes_callback_(bytes_);
+        }
+      }
+
+    private:
+      type()
+        : base_(*((Base*)0)){};
+
+    private:
+      Base& base_;
+      uint64_t max_bytes_;
+      uint64_t bytes_;
+      Callback<void, uint64_t> bytes_callback_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // BYTE_BUDGET_POLICY_H_
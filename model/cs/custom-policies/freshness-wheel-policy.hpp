@@ -0,0 +1,290 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef FRESHNESS_WHEEL_POLICY_H_
+#define FRESHNESS_WHEEL_POLICY_H_
+
+/// @cond include_hidden
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+
+#include <ns3/nstime.h>
+#include <ns3/simulator.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for freshness policy that keeps entries in a coarse time wheel
+ *
+ * Unlike freshness_policy_traits, entries are not ordered by expiration time.  An entry is
+ * appended to the slot of the first wheel tick at or after its expiration, and the owner is
+ * expected to call expire() periodically (once per tick) to remove stale entries.  Entries
+ * expiring more than one wheel revolution ahead stay in their slot until a later revolution.
+ */
+struct freshness_wheel_policy_traits {
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string
+  GetName()
+  {
+    return "FreshnessWheel";
+  }
+
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> {
+    Time timeWhenShouldExpire;
+    uint32_t slot;
+  };
+
+  template<class Container>
+  struct container_hook {
+    typedef boost::intrusive::member_hook<Container, policy_hook_type, &Container::policy_hook_>
+      type;
+  };
+
+  template<class Base, class Container, class Hook>
+  struct policy {
+    typedef boost::intrusive::list<Container, Hook> policy_container;
+
+    static policy_hook_type&
+    get_hook(typename Container::iterator item)
+    {
+      return *static_cast<typename policy_container::value_traits::hook_type*>(
+        policy_container::value_traits::to_node_ptr(*item));
+    }
+
+    static Time&
+    get_freshness(typename Container::iterator item)
+    {
+      return get_hook(item).timeWhenShouldExpire;
+    }
+
+    static const Time&
+    get_freshness(typename Container::const_iterator item)
+    {
+      return static_cast<const typename policy_container::value_traits::hook_type*>(
+               policy_container::value_traits::to_node_ptr(*item))->timeWhenShouldExpire;
+    }
+
+    class type {
+    public:
+      typedef policy policy_base; // to get access to get_freshness methods from outside
+      typedef Container parent_trie;
+
+      type(Base& base)
+        : base_(base)
+        , max_size_(100)
+        , size_(0)
+      {
+        configure(MilliSeconds(10), 1024);
+      }
+
+      inline void
+      update(typename parent_trie::iterator item)
+      {
+        // do nothing
+      }
+
+      inline bool
+      insert(typename parent_trie::iterator item)
+      {
+        time::milliseconds freshness = item->payload()->GetData()->getFreshnessPeriod();
+        if (freshness > time::milliseconds::zero()) {
+          // as in freshness_policy_traits, only entries with finite freshness are tracked
+          get_freshness(item) = Simulator::Now() + MilliSeconds(freshness.count());
+          place(item);
+          ++size_;
+        }
+
+        return true;
+      }
+
+      inline void
+      lookup(typename parent_trie::iterator item)
+      {
+        // do nothing
+      }
+
+      inline void
+      erase(typename parent_trie::iterator item)
+      {
+        time::milliseconds freshness = item->payload()->GetData()->getFreshnessPeriod();
+        if (freshness > time::milliseconds::zero()) {
+          policy_container& slot = slots_[get_hook(item).slot];
+          slot.erase(slot.iterator_to(*item));
+          --size_;
+        }
+      }
+
+      inline void
+      clear()
+      {
+        for (policy_container& slot : slots_) {
+          slot.clear();
+        }
+        size_ = 0;
+      }
+
+      /**
+       * @brief Remove all entries that are stale at time now
+       *
+       * Visits the slots of all ticks elapsed since the previous call (each slot at most once).
+       */
+      inline void
+      expire(const Time& now)
+      {
+        int64_t nowTick = now.GetTimeStep() / granularity_.GetTimeStep();
+        if (nowTick <= lastTick_)
+          return;
+
+        int64_t firstTick = std::max(lastTick_ + 1, nowTick - static_cast<int64_t>(mask_));
+        lastTick_ = nowTick;
+
+        for (int64_t tick = firstTick; tick <= nowTick; ++tick) {
+          policy_container& slot = slots_[tick & mask_];
+          for (typename policy_container::iterator entry = slot.begin(); entry != slot.end();) {
+            typename parent_trie::iterator item = &*entry;
+            ++entry; // item is going to be unlinked from the slot
+            if (get_freshness(item) <= now) {
+              base_.erase(item);
+            }
+          }
+        }
+      }
+
+      /**
+       * @brief Check if entry is stale (without waiting for the next expire())
+       */
+      static inline bool
+      is_stale(typename parent_trie::const_iterator item, const Time& now)
+      {
+        time::milliseconds freshness = item->payload()->GetData()->getFreshnessPeriod();
+        return freshness > time::milliseconds::zero() && get_freshness(item) <= now;
+      }
+
+      /**
+       * @brief Change tick duration and number of slots of the wheel
+       *
+       * Number of slots is rounded up to a power of two.  Entries already in the wheel are
+       * redistributed.
+       */
+      inline void
+      configure(const Time& granularity, uint32_t nSlots)
+      {
+        policy_container entries;
+        for (policy_container& slot : slots_) {
+          entries.splice(entries.end(), slot);
+        }
+
+        uint32_t size = 1;
+        while (size < nSlots) {
+          size *= 2;
+        }
+
+        granularity_ = granularity;
+        mask_ = size - 1;
+        lastTick_ = Simulator::Now().GetTimeStep() / granularity_.GetTimeStep();
+        std::vector<policy_container>(size).swap(slots_);
+
+        while (!entries.empty()) {
+          typename parent_trie::iterator item = &entries.front();
+          entries.pop_front();
+          place(item);
+        }
+      }
+
+      inline const Time&
+      get_granularity() const
+      {
+        return granularity_;
+      }
+
+      inline uint32_t
+      get_slots() const
+      {
+        return mask_ + 1;
+      }
+
+      /// @brief Number of entries with finite freshness
+      inline size_t
+      size() const
+      {
+        return size_;
+      }
+
+      inline bool
+      empty() const
+      {
+        return size_ == 0;
+      }
+
+      inline void
+      set_max_size(size_t max_size)
+      {
+        max_size_ = max_size;
+      }
+
+      inline size_t
+      get_max_size() const
+      {
+        return max_size_;
+      }
+
+    private:
+      type()
+        : base_(*((Base*)0)){};
+
+      void
+      place(typename parent_trie::iterator item)
+      {
+        int64_t step = granularity_.GetTimeStep();
+        int64_t tick = (get_freshness(item).GetTimeStep() + step - 1) / step;
+        // ticks up to lastTick_ have already been visited
+        tick = std::max(tick, lastTick_ + 1);
+
+        get_hook(item).slot = static_cast<uint32_t>(tick & mask_);
+        slots_[get_hook(item).slot].push_back(*item);
+      }
+
+    private:
+      Base& base_;
+      size_t max_size_;
+
+      Time granularity_;
+      uint32_t mask_;
+      int64_t lastTick_; ///< @brief last tick visited by expire()
+      std::vector<policy_container> slots_;
+      size_t size_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // FRESHNESS_WHEEL_POLICY_H_
@@ -0,0 +1,251 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef TINYLFU_POLICY_H_
+#define TINYLFU_POLICY_H_
+
+/// @cond include_hidden
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for TinyLFU admission policy
+ *
+ * The policy estimates access frequency of names with a count-min sketch of 4-bit counters,
+ * packed two per byte.
+ * Every cache hit and every insertion attempt is recorded.  When the cache is full, a new item
+ * is admitted only if its estimated frequency is higher than the frequency of the item that the
+ * replacement policy would evict, which keeps one-hit-wonders out of the cache.  After
+ * SampleFactor * MaxSize recorded accesses, all counters are halved, so that the sketch follows
+ * changes in popularity.
+ *
+ * The policy must be the last one in multi_policy_traits, so that admission is decided before
+ * the replacement policy makes room for the new item, and the replacement policy must be the
+ * first one, as its order determines the eviction victim.
+ */
+struct tinylfu_policy_traits {
+  static std::string
+  GetName()
+  {
+    return "TinyLfuImpl";
+  }
+
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> {
+    uint64_t hash;
+  };
+
+  template<class Container>
+  struct container_hook {
+    typedef boost::intrusive::member_hook<Container, policy_hook_type, &Container::policy_hook_>
+      type;
+  };
+
+  template<class Base, class Container, class Hook>
+  struct policy {
+    static uint64_t&
+    get_hash(typename Container::iterator item)
+    {
+      return static_cast<typename policy_container::value_traits::hook_type*>(
+               policy_container::value_traits::to_node_ptr(*item))->hash;
+    }
+
+    typedef typename boost::intrusive::list<Container, Hook> policy_container;
+
+    class type : public policy_container {
+    public:
+      typedef policy policy_base; // to get access to get_hash methods from outside
+      typedef Container parent_trie;
+
+      static const size_t DEPTH = 4;
+      static const uint8_t MAX_COUNT = 15;
+
+      type(Base& base)
+        : base_(base)
+        , max_size_(100)
+        , sample_factor_(10)
+        , n_additions_(0)
+      {
+        resize_sketch();
+      }
+
+      inline void
+      update(typename parent_trie::iterator item)
+      {
+      }
+
+      inline bool
+      insert(typename parent_trie::iterator item)
+      {
+        uint64_t hash = compute_hash(item);
+        record(hash);
+
+        if (max_size_ != 0 && base_.getPolicy().size() >= max_size_) {
+          typename parent_trie::iterator victim = &(*base_.getPolicy().begin());
+          if (estimate(hash) <= estimate(get_hash(victim))) {
+            // don't allow caching
+            return false;
+          }
+        }
+
+        get_hash(item) = hash;
+        policy_container::push_back(*item);
+        return true;
+      }
+
+      inline void
+      lookup(typename parent_trie::iterator item)
+      {
+        record(get_hash(item));
+      }
+
+      inline void
+      erase(typename parent_trie::iterator item)
+      {
+        policy_container::erase(policy_container::s_iterator_to(*item));
+      }
+
+      inline void
+      clear()
+      {
+        policy_container::clear();
+      }
+
+      inline void
+      set_max_size(size_t max_size)
+      {
+        max_size_ = max_size;
+        resize_sketch();
+      }
+
+      inline size_t
+      get_max_size() const
+      {
+        return max_size_;
+      }
+
+      inline void
+      set_sample_factor(uint32_t sample_factor)
+      {
+        sample_factor_ = sample_factor;
+      }
+
+      inline uint32_t
+      get_sample_factor() const
+      {
+        return sample_factor_;
+      }
+
+    private:
+      static uint64_t
+      compute_hash(typename parent_trie::iterator item)
+      {
+        const Block& wire = item->payload()->GetName().wireEncode();
+        uint64_t hash = boost::hash_range(wire.wire(), wire.wire() + wire.size());
+        return hash * 0x9E3779B97F4A7C15ULL; // spread bits for the double hashing below
+      }
+
+      inline size_t
+      get_index(uint64_t hash, size_t row) const
+      {
+        uint32_t h1 = static_cast<uint32_t>(hash);
+        uint32_t h2 = static_cast<uint32_t>(hash >> 32) | 1;
+        return row * width_ + ((h1 + row * h2) & (width_ - 1));
+      }
+
+      inline uint8_t
+      estimate(uint64_t hash) const
+      {
+        uint8_t count = MAX_COUNT;
+        for (size_t row = 0; row < DEPTH; ++row) {
+          count = std::min(count, get_counter(get_index(hash, row)));
+        }
+        return count;
+      }
+
+      inline uint8_t
+      get_counter(size_t index) const
+      {
+        return (counters_[index / 2] >> (index % 2 * 4)) & MAX_COUNT;
+      }
+
+      inline void
+      record(uint64_t hash)
+      {
+        for (size_t row = 0; row < DEPTH; ++row) {
+          size_t index = get_index(hash, row);
+          if (get_counter(index) < MAX_COUNT) {
+            counters_[index / 2] += 1 << (index % 2 * 4);
+          }
+        }
+
+        if (++n_additions_ >= sample_factor_ * std::max<size_t>(max_size_, 1)) {
+          // halve both counters of a byte at once; the mask drops the bit shifted between them
+          for (uint8_t& counters : counters_) {
+            counters = (counters >> 1) & 0x77;
+          }
+          n_additions_ /= 2;
+        }
+      }
+
+      inline void
+      resize_sketch()
+      {
+        // about one counter per cached item in each row, rounded up to a power of two
+        width_ = 16;
+        while (width_ < max_size_) {
+          width_ <<= 1;
+        }
+        counters_.assign(DEPTH * width_ / 2, 0);
+        n_additions_ = 0;
+      }
+
+    private:
+      type()
+        : base_(*((Base*)0)){};
+
+    private:
+      Base& base_;
+      size_t max_size_;
+      uint32_t sample_factor_;
+
+      size_t width_;
+      std::vector<uint8_t> counters_; // two 4-bit counters per byte, low nibble first
+      size_t n_additions_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // TINYLFU_POLICY_H_
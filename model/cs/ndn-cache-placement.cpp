@@ -0,0 +1,200 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-cache-placement.hpp"
+
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/channel.h"
+#include "ns3/uinteger.h"
+#include "ns3/integer.h"
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("ndn.cs.CachePlacement");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(CachePlacement);
+
+TypeId
+CachePlacement::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::CachePlacement")
+      .SetGroupName("Ndn")
+      .SetParent<Object>()
+
+      .AddTraceSource("DeclinedData",
+                      "Trace called every time placement keeps Data out of the Content Store",
+                      MakeTraceSourceAccessor(&CachePlacement::m_declinedTrace));
+
+  return tid;
+}
+
+CachePlacement::~CachePlacement()
+{
+}
+
+bool
+CachePlacement::ShouldCache(const Data& data, uint32_t hopCount)
+{
+  if (DoShouldCache(data, hopCount))
+    return true;
+
+  NS_LOG_DEBUG("Not caching " << data.getName() << " (hops " << hopCount << ")");
+  m_declinedTrace(data.shared_from_this(), hopCount);
+  return false;
+}
+
+namespace cs {
+namespace placement {
+
+NS_OBJECT_ENSURE_REGISTERED(HopCount);
+
+TypeId
+HopCount::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::cs::placement::HopCount")
+      .SetGroupName("Ndn")
+      .SetParent<CachePlacement>()
+      .AddConstructor<HopCount>()
+
+      .AddAttribute("MinHops", "Minimum distance from the source at which Data is cached",
+                    UintegerValue(1), MakeUintegerAccessor(&HopCount::m_minHops),
+                    MakeUintegerChecker<uint32_t>())
+
+      .AddAttribute("MaxHops", "Maximum distance from the source at which Data is cached",
+                    UintegerValue(1), MakeUintegerAccessor(&HopCount::m_maxHops),
+                    MakeUintegerChecker<uint32_t>());
+
+  return tid;
+}
+
+HopCount::HopCount()
+  : m_minHops(1)
+  , m_maxHops(1)
+{
+}
+
+bool
+HopCount::DoShouldCache(const Data& data, uint32_t hopCount)
+{
+  return hopCount >= m_minHops && hopCount <= m_maxHops;
+}
+
+NS_OBJECT_ENSURE_REGISTERED(NameHash);
+
+TypeId
+NameHash::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::cs::placement::NameHash")
+      .SetGroupName("Ndn")
+      .SetParent<CachePlacement>()
+      .AddConstructor<NameHash>()
+
+      .AddAttribute("Partitions", "Number of routers among which chunks are partitioned",
+                    UintegerValue(1), MakeUintegerAccessor(&NameHash::m_partitions),
+                    MakeUintegerChecker<uint32_t>(1))
+
+      .AddAttribute("Index", "Partition cached by this router. If negative, it is derived "
+                             "from the topology, so that neighbors cache different partitions",
+                    IntegerValue(-1), MakeIntegerAccessor(&NameHash::m_index),
+                    MakeIntegerChecker<int32_t>());
+
+  return tid;
+}
+
+NameHash::NameHash()
+  : m_partitions(1)
+  , m_index(-1)
+  , m_topologyIndex(0)
+  , m_topologyPartitions(0)
+{
+}
+
+bool
+NameHash::DoShouldCache(const Data& data, uint32_t hopCount)
+{
+  if (m_partitions == 1)
+    return true;
+
+  uint32_t index = static_cast<uint32_t>(m_index);
+  if (m_index < 0) {
+    if (m_topologyPartitions != m_partitions) {
+      m_topologyIndex = ColorTopology();
+      m_topologyPartitions = m_partitions;
+    }
+    index = m_topologyIndex;
+  }
+
+  // FNV-1a over the name's wire encoding, so partitioning does not depend on the platform
+  const Block& wire = data.getName().wireEncode();
+  uint32_t hash = 2166136261u;
+  for (Block::const_iterator i = wire.begin(); i != wire.end(); ++i) {
+    hash = (hash ^ static_cast<uint8_t>(*i)) * 16777619u;
+  }
+
+  return hash % m_partitions == index % m_partitions;
+}
+
+uint32_t
+NameHash::ColorTopology() const
+{
+  Ptr<Node> self = GetObject<Node>();
+  NS_ASSERT_MSG(self != nullptr, "NameHash placement must be aggregated to a node");
+
+  // color of a node depends only on nodes with lower IDs, so coloring stops at this node
+  std::vector<uint32_t> colors(self->GetId() + 1, m_partitions);
+  std::vector<bool> isTaken(m_partitions);
+  for (uint32_t id = 0; id <= self->GetId(); ++id) {
+    Ptr<Node> node = NodeList::GetNode(id);
+
+    std::fill(isTaken.begin(), isTaken.end(), false);
+    for (uint32_t i = 0; i < node->GetNDevices(); ++i) {
+      Ptr<Channel> channel = node->GetDevice(i)->GetChannel();
+      if (channel == nullptr)
+        continue;
+
+      for (uint32_t j = 0; j < channel->GetNDevices(); ++j) {
+        uint32_t neighbor = channel->GetDevice(j)->GetNode()->GetId();
+        if (neighbor < id) {
+          isTaken[colors[neighbor]] = true;
+        }
+      }
+    }
+
+    std::vector<bool>::iterator free = std::find(isTaken.begin(), isTaken.end(), false);
+    colors[id] = free != isTaken.end() ? free - isTaken.begin() : id % m_partitions;
+  }
+
+  NS_LOG_DEBUG("Node " << self->GetId() << " caches partition " << colors.back() << " of "
+                       << m_partitions);
+  return colors.back();
+}
+
+} // namespace placement
+} // namespace cs
+
+} // namespace ndn
+} // namespace ns3
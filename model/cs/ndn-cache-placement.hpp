@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CACHE_PLACEMENT_H
+#define NDN_CACHE_PLACEMENT_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include "ns3/traced-callback.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-cs
+ * @brief Base class for cooperative cache placement
+ *
+ * Placement is consulted by the forwarder's Data pipeline before every Content Store insertion
+ * and applies to both NFD's and ndnSIM 1.0 content stores.  Unlike replacement policies, which
+ * decide what a single cache keeps, placement coordinates the routers along a delivery path so
+ * that a chunk is not duplicated in every cache it passes through.
+ *
+ * Hop count is the number of links the Data traversed since it left the producer or the cache
+ * that satisfied the Interest, as recorded by FwHopCountTag; it is 0 for Data from a local app.
+ */
+class CachePlacement : public Object {
+public:
+  static TypeId
+  GetTypeId();
+
+  virtual ~CachePlacement();
+
+  /**
+   * @brief Decide whether this node caches the Data
+   * @param data Data about to be inserted into the Content Store
+   * @param hopCount number of hops the Data traversed since its source
+   */
+  bool
+  ShouldCache(const Data& data, uint32_t hopCount);
+
+protected:
+  /**
+   * @brief Placement decision to be implemented by particular schemes
+   */
+  virtual bool
+  DoShouldCache(const Data& data, uint32_t hopCount) = 0;
+
+protected:
+  TracedCallback<shared_ptr<const Data>, uint32_t> m_declinedTrace; ///< @brief trace of Data not cached
+};
+
+namespace cs {
+namespace placement {
+
+/**
+ * @ingroup ndn-cs
+ * @brief Placement that caches Data only within a window of hop distances from its source
+ *
+ * With default attributes (MinHops = MaxHops = 1) this is Leave Copy Down: only the router
+ * right below the hit location keeps a copy, so a popular chunk moves one level closer to
+ * consumers with every request that reaches its current location.
+ */
+class HopCount : public CachePlacement {
+public:
+  static TypeId
+  GetTypeId();
+
+  HopCount();
+
+protected:
+  virtual bool
+  DoShouldCache(const Data& data, uint32_t hopCount);
+
+private:
+  uint32_t m_minHops;
+  uint32_t m_maxHops;
+};
+
+/**
+ * @ingroup ndn-cs
+ * @brief Placement that partitions chunks among neighboring routers by hash of the Data name
+ *
+ * A router caches a chunk only if the hash of its full name (including the segment number)
+ * modulo Partitions equals the router's Index.  Routers of one neighborhood configured with
+ * distinct indexes therefore hold disjoint sets of segments.
+ *
+ * Unless Index is set, it is derived from the topology on first use by greedy coloring: nodes
+ * are visited in node ID order, and each takes the smallest index not taken by an already
+ * visited neighbor (node ID modulo Partitions if all are taken).  Directly connected routers
+ * thus get distinct indexes whenever each has fewer than Partitions neighbors.  Links added
+ * after the first Data reached the router are not taken into account.
+ */
+class NameHash : public CachePlacement {
+public:
+  static TypeId
+  GetTypeId();
+
+  NameHash();
+
+protected:
+  virtual bool
+  DoShouldCache(const Data& data, uint32_t hopCount);
+
+private:
+  /**
+   * @brief Get index of this node in greedy coloring of the topology with m_partitions colors
+   */
+  uint32_t
+  ColorTopology() const;
+
+private:
+  uint32_t m_partitions;
+  int32_t m_index;
+
+  uint32_t m_topologyIndex;
+  uint32_t m_topologyPartitions; ///< @brief Partitions used for m_topologyIndex, 0 if not derived
+};
+
+} // namespace placement
+} // namespace cs
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CACHE_PLACEMENT_H
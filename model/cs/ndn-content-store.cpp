@@ -21,6 +21,7 @@
 
 #include "ns3/log.h"
 #include "ns3/packet.h"
+#include "ns3/simulator.h"
 
 NS_LOG_COMPONENT_DEFINE("ndn.cs.ContentStore");
 
@@ -50,6 +51,20 @@ ContentStore::~ContentStore()
 {
 }
 
+uint64_t
+ContentStore::GetBytesInUse() const
+{
+  return 0;
+}
+
+void
+ContentStore::ForEachInEvictionOrder(const std::function<void(Ptr<cs::Entry>)>& visitor)
+{
+  for (Ptr<cs::Entry> entry = Begin(); entry != End(); entry = Next(entry)) {
+    visitor(entry);
+  }
+}
+
 namespace cs {
 
 //////////////////////////////////////////////////////////////////////
@@ -57,6 +72,7 @@ namespace cs {
 Entry::Entry(Ptr<ContentStore> cs, shared_ptr<const Data> data)
   : m_cs(cs)
   , m_data(data)
+  , m_creationTime(Simulator::Now())
 {
 }
 
@@ -72,6 +88,12 @@ Entry::GetData() const
   return m_data;
 }
 
+Time
+Entry::GetCreationTime() const
+{
+  return m_creationTime;
+}
+
 Ptr<ContentStore>
 Entry::GetContentStore()
 {
@@ -24,8 +24,10 @@
 
 #include "ns3/object.h"
 #include "ns3/ptr.h"
+#include "ns3/nstime.h"
 #include "ns3/traced-callback.h"
 
+#include <functional>
 #include <tuple>
 
 namespace ns3 {
@@ -78,6 +80,15 @@ public:
   shared_ptr<const Data>
   GetData() const;
 
+  /**
+   * @brief Get simulation time when the entry was created
+   *
+   * This is the time the Data was added, unless the content store creates entries only when
+   * they are enumerated.
+   */
+  Time
+  GetCreationTime() const;
+
   /**
    * @brief Get pointer to access store, to which this entry is added
    */
@@ -87,6 +98,7 @@ public:
 private:
   Ptr<ContentStore> m_cs;        ///< \brief content store to which entry is added
   shared_ptr<const Data> m_data; ///< \brief non-modifiable Data
+  Time m_creationTime;
 };
 
 } // namespace cs
@@ -156,6 +168,14 @@ public:
   virtual uint32_t
   GetSize() const = 0;
 
+  /**
+   * @brief Get number of bytes charged to entries in content store, including per-entry overhead
+   *
+   * Implementations that do not account bytes return 0.
+   */
+  virtual uint64_t
+  GetBytesInUse() const;
+
   /**
    * @brief Return first element of content store (no order guaranteed)
    */
@@ -173,6 +193,16 @@ public:
    */
   virtual Ptr<cs::Entry> Next(Ptr<cs::Entry>) = 0;
 
+  /**
+   * @brief Call @p visitor for every entry, starting with the entry to be evicted first
+   *
+   * Adding the entries to an empty content store in the visiting order restores the replacement
+   * order of policies that depend only on the order of insertions and lookups (e.g., LRU and
+   * FIFO).  The default implementation visits entries in the order of Begin() and Next().
+   */
+  virtual void
+  ForEachInEvictionOrder(const std::function<void(Ptr<cs::Entry>)>& visitor);
+
   ////////////////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////
@@ -35,10 +35,12 @@
 #include "ndn-net-device-face.hpp"
 #include "../helper/ndn-stack-helper.hpp"
 #include "cs/ndn-content-store.hpp"
+#include "cs/ndn-cache-placement.hpp"
 
 #include <boost/property_tree/info_parser.hpp>
 
 #include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/available-strategies.hpp"
 #include "ns3/ndnSIM/NFD/daemon/mgmt/internal-face.hpp"
 #include "ns3/ndnSIM/NFD/daemon/mgmt/fib-manager.hpp"
 #include "ns3/ndnSIM/NFD/daemon/mgmt/face-manager.hpp"
@@ -49,6 +51,7 @@
 #include "ns3/ndnSIM/NFD/core/config-file.hpp"
 #include "ns3/ndnSIM/NFD/daemon/mgmt/general-config-section.hpp"
 #include "ns3/ndnSIM/NFD/daemon/mgmt/tables-config-section.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/cs-indexed.hpp"
 
 NS_LOG_COMPONENT_DEFINE("ndn.L3Protocol");
 
@@ -85,14 +88,21 @@ L3Protocol::GetTypeId(void)
                       MakeTraceSourceAccessor(&L3Protocol::m_satisfiedInterests))
       .AddTraceSource("TimedOutInterests", "TimedOutInterests",
                       MakeTraceSourceAccessor(&L3Protocol::m_timedOutInterests))
+
+      ////////////////////////////////////////////////////////////////////
+
+      .AddTraceSource("CsBytesInUse",
+                      "Number of bytes in use by NFD's Content Store, fired when it changes",
+                      MakeTraceSourceAccessor(&L3Protocol::m_csBytesInUse))
     ;
   return tid;
 }
 
-class L3Protocol::Impl {
-private:
-  Impl()
-  {
+shared_ptr<const nfd::ConfigSection>
+L3Protocol::getDefaultConfig()
+{
+  // parsed on first use only; nodes share it until they modify their config
+  static shared_ptr<const nfd::ConfigSection> config = [] {
     // Do not modify initial config file. Use helpers to set specific NFD parameters
     std::string initialConfig =
       "general\n"
@@ -143,7 +153,27 @@ private:
       "\n";
 
     std::istringstream input(initialConfig);
-    boost::property_tree::read_info(input, m_config);
+    auto parsed = make_shared<nfd::ConfigSection>();
+    boost::property_tree::read_info(input, *parsed);
+    return shared_ptr<const nfd::ConfigSection>(parsed);
+  }();
+
+  return config;
+}
+
+class L3Protocol::Impl {
+private:
+  Impl()
+    : m_sharedConfig(getDefaultConfig())
+    , m_isForwardingOnly(false)
+    , m_timerWheelTick(Seconds(0))
+  {
+  }
+
+  const nfd::ConfigSection&
+  getConfig() const
+  {
+    return m_config != nullptr ? *m_config : *m_sharedConfig;
   }
 
   friend class L3Protocol;
@@ -156,9 +186,15 @@ private:
   shared_ptr<nfd::StrategyChoiceManager> m_strategyChoiceManager;
   shared_ptr<nfd::StatusServer> m_statusServer;
 
-  nfd::ConfigSection m_config;
+  shared_ptr<const nfd::ConfigSection> m_sharedConfig;
+  std::unique_ptr<nfd::ConfigSection> m_config; ///< @brief private copy, if modified by getConfig()
+
+  bool m_isForwardingOnly;
+  Time m_timerWheelTick;
 
   Ptr<ContentStore> m_csFromNdnSim;
+
+  nfd::signal::ScopedConnection m_csBytesInUseConn;
 };
 
 L3Protocol::L3Protocol()
@@ -175,14 +211,28 @@ L3Protocol::~L3Protocol()
 void
 L3Protocol::initialize()
 {
-  m_impl->m_forwarder = make_shared<nfd::Forwarder>();
+  // forwarding-only nodes create strategies on first use
+  m_impl->m_forwarder =
+    make_shared<nfd::Forwarder>(!m_impl->m_isForwardingOnly,
+                                nfd::time::nanoseconds(m_impl->m_timerWheelTick.GetNanoSeconds()));
+
+  initializeContentStore();
 
-  initializeManagement();
+  if (m_impl->m_isForwardingOnly) {
+    initializeTables();
+  }
+  else {
+    initializeManagement();
+  }
 
   m_impl->m_forwarder->getFaceTable().addReserved(make_shared<nfd::NullFace>(), nfd::FACEID_NULL);
 
   m_impl->m_forwarder->beforeSatisfyInterest.connect(std::ref(m_satisfiedInterests));
   m_impl->m_forwarder->beforeExpirePendingInterest.connect(std::ref(m_timedOutInterests));
+
+  // disconnected before the forwarder is destroyed, as the trace source may be gone by then
+  m_impl->m_csBytesInUseConn =
+    m_impl->m_forwarder->getCs().afterBytesInUseChange.connect(std::ref(m_csBytesInUse));
 }
 
 class IgnoreSections
@@ -206,6 +256,29 @@ private:
   std::vector<std::string> m_ignored;
 };
 
+void
+L3Protocol::initializeContentStore()
+{
+  // CS limit is applied later by TablesConfigSection
+  std::string csEngine = m_impl->getConfig().get<std::string>("tables.cs_engine", "skip_list");
+  if (csEngine == "skip_list") {
+    return;
+  }
+
+  if (csEngine != "indexed") {
+    NS_FATAL_ERROR("Unknown NFD CS engine " << csEngine);
+  }
+
+  std::string csPolicy = m_impl->getConfig().get<std::string>("tables.cs_policy", "lru");
+  try {
+    nfd::IndexedCs::Policy policy = nfd::IndexedCs::parsePolicy(csPolicy);
+    m_impl->m_forwarder->setCs(std::unique_ptr<nfd::Cs>(new nfd::IndexedCs(10, policy)));
+  }
+  catch (const std::invalid_argument& e) {
+    NS_FATAL_ERROR(e.what());
+  }
+}
+
 void
 L3Protocol::initializeManagement()
 {
@@ -248,7 +321,7 @@ L3Protocol::initializeManagement()
   m_impl->m_faceManager->setConfigFile(config);
 
   // apply config
-  config.parse(m_impl->m_config, false, "ndnSIM.conf");
+  config.parse(m_impl->getConfig(), false, "ndnSIM.conf");
 
   tablesConfig.ensureTablesAreConfigured();
 
@@ -257,6 +330,36 @@ L3Protocol::initializeManagement()
   entry->addNextHop(m_impl->m_internalFace, 0);
 }
 
+void
+L3Protocol::initializeTables()
+{
+  auto& forwarder = m_impl->m_forwarder;
+  using namespace nfd;
+
+  // strategies referenced by the config are the only ones created upfront
+  boost::optional<const ConfigSection&> strategyChoiceSection =
+    m_impl->getConfig().get_child_optional("tables.strategy_choice");
+  if (strategyChoiceSection) {
+    for (const auto& prefixAndStrategy : *strategyChoiceSection) {
+      fw::installStrategy(*forwarder, Name(prefixAndStrategy.second.get_value<std::string>()));
+    }
+  }
+
+  ConfigFile config((IgnoreSections({"general", "log", "rib", "authorizations", "face_system"})));
+
+  TablesConfigSection tablesConfig(forwarder->getCs(),
+                                   forwarder->getPit(),
+                                   forwarder->getFib(),
+                                   forwarder->getStrategyChoice(),
+                                   forwarder->getMeasurements());
+  tablesConfig.setConfigFile(config);
+
+  // apply config
+  config.parse(m_impl->getConfig(), false, "ndnSIM.conf");
+
+  tablesConfig.ensureTablesAreConfigured();
+}
+
 shared_ptr<nfd::Forwarder>
 L3Protocol::getForwarder()
 {
@@ -275,10 +378,41 @@ L3Protocol::getStrategyChoiceManager()
   return m_impl->m_strategyChoiceManager;
 }
 
+void
+L3Protocol::setForwardingOnly(bool isForwardingOnly)
+{
+  NS_ASSERT_MSG(m_impl->m_forwarder == nullptr, "NFD is already initialized");
+  m_impl->m_isForwardingOnly = isForwardingOnly;
+}
+
+bool
+L3Protocol::isForwardingOnly() const
+{
+  return m_impl->m_isForwardingOnly;
+}
+
+void
+L3Protocol::setTimerWheelTick(const Time& tick)
+{
+  NS_ASSERT_MSG(m_impl->m_forwarder == nullptr, "NFD is already initialized");
+  m_impl->m_timerWheelTick = tick;
+}
+
 nfd::ConfigSection&
 L3Protocol::getConfig()
 {
-  return m_impl->m_config;
+  if (m_impl->m_config == nullptr) {
+    m_impl->m_config.reset(new nfd::ConfigSection(*m_impl->m_sharedConfig));
+  }
+  return *m_impl->m_config;
+}
+
+void
+L3Protocol::setConfig(shared_ptr<const nfd::ConfigSection> config)
+{
+  NS_ASSERT(config != nullptr);
+  m_impl->m_sharedConfig = config;
+  m_impl->m_config.reset();
 }
 
 /*
@@ -296,6 +430,10 @@ L3Protocol::NotifyNewAggregate()
       if (m_impl->m_csFromNdnSim != nullptr) {
         m_impl->m_forwarder->setCsFromNdnSim(m_impl->m_csFromNdnSim);
       }
+      Ptr<CachePlacement> placement = GetObject<CachePlacement>();
+      if (placement != nullptr) {
+        m_impl->m_forwarder->setCachePlacement(placement);
+      }
     }
   }
 
@@ -104,6 +104,30 @@ public:
   shared_ptr<nfd::Forwarder>
   getForwarder();
 
+  /**
+   * \brief Make the node forwarding-only, must be called before initialize()
+   *
+   * A forwarding-only node has no NFD management plane: no internal face, FibManager,
+   * FaceManager, StrategyChoiceManager, or StatusServer, so getFibManager() and
+   * getStrategyChoiceManager() return nullptr.  Besides the default strategy, forwarding
+   * strategies are only created when they are chosen for a prefix.  FibHelper and
+   * StrategyChoiceHelper update tables of such nodes directly.
+   */
+  void
+  setForwardingOnly(bool isForwardingOnly);
+
+  bool
+  isForwardingOnly() const;
+
+  /**
+   * \brief Set tick interval of the forwarder's timer wheel, must be called before initialize()
+   *
+   * Zero (the default) disables the wheel.  The tick is passed to nfd::Forwarder when it is
+   * created, so that timers armed while the tables are constructed use the wheel as well.
+   */
+  void
+  setTimerWheelTick(const Time& tick);
+
   /**
    * \brief Get smart pointer to nfd::FibManager, used by node's NFD
    */
@@ -150,10 +174,27 @@ public:
 
   /**
    * \brief Get NFD config (boost::property_tree)
+   *
+   * If the config is shared with other nodes (see setConfig), a private copy is made first.
    */
   nfd::ConfigSection&
   getConfig();
 
+  /**
+   * \brief Use NFD config shared with other nodes, must be called before initialize()
+   *
+   * Lets StackHelper prepare the config once for all nodes, instead of each node parsing and
+   * modifying its own copy of the default config.
+   */
+  void
+  setConfig(shared_ptr<const nfd::ConfigSection> config);
+
+  /**
+   * \brief Get default NFD config, parsed once per process
+   */
+  static shared_ptr<const nfd::ConfigSection>
+  getDefaultConfig();
+
 public: // Workaround for python bindings
   static Ptr<L3Protocol>
   getL3Protocol(Ptr<Object> node);
@@ -172,9 +213,21 @@ protected:
   NotifyNewAggregate();
 
 private:
+  /**
+   * \brief Replace NFD's Content Store according to tables.cs_engine config option
+   */
+  void
+  initializeContentStore();
+
   void
   initializeManagement();
 
+  /**
+   * \brief Apply tables section of NFD config on a forwarding-only node
+   */
+  void
+  initializeTables();
+
 private:
   class Impl;
   std::unique_ptr<Impl> m_impl;
@@ -192,6 +245,8 @@ private:
 
   TracedCallback<const nfd::pit::Entry&, const Face&/*in face*/, const Data&> m_satisfiedInterests;
   TracedCallback<const nfd::pit::Entry&> m_timedOutInterests;
+
+  TracedCallback<size_t> m_csBytesInUse; ///< @brief trace of bytes in use by NFD's Content Store
 };
 
 } // namespace ndn
@@ -23,6 +23,8 @@
 #include "ns3/ndnSIM/helper/ndn-stack-helper.hpp"
 #include "ns3/ndnSIM/helper/ndn-app-helper.hpp"
 #include "ns3/ndnSIM/helper/ndn-global-routing-helper.hpp"
+#include "ns3/ndnSIM/helper/ndn-global-routing-graph.hpp"
+#include "ns3/ndnSIM/helper/ndn-topology-partitioner.hpp"
 // #include "ns3/ndnSIM/helper/ndn-ip-faces-helper.hpp"
 // #include "ns3/ndnSIM/helper/ndn-link-control-helper.hpp"
 
@@ -32,9 +34,12 @@
 #include "ns3/ndnSIM/utils/tracers/l2-rate-tracer.hpp"
 #include "ns3/ndnSIM/utils/tracers/ndn-app-delay-tracer.hpp"
 #include "ns3/ndnSIM/utils/tracers/ndn-cs-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-mem-tracer.hpp"
 #include "ns3/ndnSIM/utils/tracers/ndn-l3-rate-tracer.hpp"
 #include "ns3/ndnSIM/utils/tracers/ndn-fileconsumer-tracer.hpp"
 #include "ns3/ndnSIM/utils/tracers/ndn-fileconsumer-log-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-tracer-output.hpp"
+#include "ns3/ndnSIM/utils/ndn-local-node.hpp"
 
 // #include "ns3/ndnSIM/model/ndn-app-face.hpp"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
@@ -0,0 +1,185 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-cs-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/NFD/daemon/table/cs.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/cs-indexed.hpp"
+
+#include <sys/time.h>
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+
+namespace ns3 {
+
+/**
+ * This program measures the wall-clock cost of inserting Data packets into an NFD Content
+ * Store and looking them up, comparing the skip list engine with the indexed engine under
+ * each of its replacement policies:
+ *
+ *     ./waf --run "ndn-cs-benchmark --engine=skip_list --entries=100000"
+ *     ./waf --run "ndn-cs-benchmark --engine=indexed --policy=lru --entries=100000"
+ *
+ * The Content Store is created with capacity of --entries packets. The benchmark first fills
+ * it, then looks up --lookups random existing names and --lookups missing names, and finally
+ * inserts another --entries packets to measure insertion with eviction.
+ */
+class CsBenchmark {
+public:
+  CsBenchmark()
+    : m_engine("skip_list")
+    , m_policy("lru")
+    , m_nEntries(100000)
+    , m_nLookups(100000)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  std::unique_ptr<nfd::Cs>
+  makeCs() const;
+
+  static shared_ptr<ndn::Data>
+  makeData(const ndn::Name& name);
+
+  static double
+  getRealTime();
+
+private:
+  std::string m_engine;
+  std::string m_policy;
+  uint32_t m_nEntries;
+  uint32_t m_nLookups;
+};
+
+std::unique_ptr<nfd::Cs>
+CsBenchmark::makeCs() const
+{
+  if (m_engine == "indexed") {
+    return std::unique_ptr<nfd::Cs>(new nfd::IndexedCs(m_nEntries,
+                                                       nfd::IndexedCs::parsePolicy(m_policy)));
+  }
+  return std::unique_ptr<nfd::Cs>(new nfd::SkipListCs(m_nEntries));
+}
+
+shared_ptr<ndn::Data>
+CsBenchmark::makeData(const ndn::Name& name)
+{
+  auto data = make_shared<ndn::Data>(name);
+  data->setFreshnessPeriod(::ndn::time::seconds(3600));
+  data->setContent(make_shared< ::ndn::Buffer>(1024));
+
+  // same fake signature as ndn::Producer, so that Data has wire encoding and full name
+  ndn::Signature signature;
+  ndn::SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+  signature.setInfo(signatureInfo);
+  signature.setValue(::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+  data->setSignature(signature);
+
+  data->wireEncode();
+  return data;
+}
+
+double
+CsBenchmark::getRealTime()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+int
+CsBenchmark::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("engine", "Content Store engine (skip_list or indexed)", m_engine);
+  cmd.AddValue("policy", "Replacement policy of indexed engine (lru, fifo, priority_fifo)",
+               m_policy);
+  cmd.AddValue("entries", "Content Store capacity and number of Data packets to insert",
+               m_nEntries);
+  cmd.AddValue("lookups", "Number of hit and of miss lookups", m_nLookups);
+  cmd.Parse(argc, argv);
+
+  std::unique_ptr<nfd::Cs> cs = makeCs();
+
+  // Data packets are prepared in advance, so that only CS operations are timed
+  std::vector<shared_ptr<ndn::Data>> dataset;
+  dataset.reserve(2 * m_nEntries);
+  for (uint32_t i = 0; i < 2 * m_nEntries; ++i) {
+    dataset.push_back(makeData(ndn::Name("/prefix").appendNumber(i % 100).appendNumber(i)));
+  }
+
+  std::vector<ndn::Interest> hits;
+  std::vector<ndn::Interest> misses;
+  Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable>();
+  for (uint32_t i = 0; i < m_nLookups; ++i) {
+    uint32_t seq = rand->GetInteger(0, m_nEntries - 1);
+    hits.push_back(ndn::Interest(ndn::Name("/prefix").appendNumber(seq % 100).appendNumber(seq)));
+    misses.push_back(ndn::Interest(ndn::Name("/missing").appendNumber(i)));
+  }
+
+  double beginRealTime = getRealTime();
+  for (uint32_t i = 0; i < m_nEntries; ++i) {
+    cs->insert(*dataset[i]);
+  }
+  double insertTime = getRealTime() - beginRealTime;
+
+  uint32_t nFound = 0;
+  beginRealTime = getRealTime();
+  for (const ndn::Interest& interest : hits) {
+    nFound += cs->find(interest) != nullptr;
+  }
+  double hitTime = getRealTime() - beginRealTime;
+
+  beginRealTime = getRealTime();
+  for (const ndn::Interest& interest : misses) {
+    nFound += cs->find(interest) != nullptr;
+  }
+  double missTime = getRealTime() - beginRealTime;
+
+  beginRealTime = getRealTime();
+  for (uint32_t i = m_nEntries; i < 2 * m_nEntries; ++i) {
+    cs->insert(*dataset[i]);
+  }
+  double evictTime = getRealTime() - beginRealTime;
+
+  std::cout << "Engine" << "\t" << "Policy" << "\t" << "Entries" << "\t"
+            << "Insert" << "\t" << "Hit" << "\t" << "Miss" << "\t" << "InsertWithEviction" << "\t"
+            << "Found" << "\t" << "Memory" << "\n";
+  std::cout << m_engine << "\t" << (m_engine == "indexed" ? m_policy : "-") << "\t"
+            << m_nEntries << "\t"
+            << insertTime << "\t" << hitTime << "\t" << missTime << "\t" << evictTime << "\t"
+            << nFound << "\t"
+            << MemUsage::Get() / 1024.0 / 1024.0 << "MiB\n";
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::CsBenchmark benchmark;
+  return benchmark.run(argc, argv);
+}
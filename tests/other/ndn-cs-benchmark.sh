@@ -0,0 +1,16 @@
+#!/bin/bash
+
+lookups=100000
+
+# compare the skip list Content Store against the indexed one with each replacement policy
+for entries in 10000 100000 1000000; do
+  echo "Number of entries = " $entries
+
+  ../../../waf --run ndn-cs-benchmark --command-template="%s --engine=skip_list --entries=${entries} --lookups=${lookups}"
+
+  for policy in lru fifo priority_fifo; do
+    ../../../waf --run ndn-cs-benchmark --command-template="%s --engine=indexed --policy=${policy} --entries=${entries} --lookups=${lookups}"
+  done
+
+  echo
+done
@@ -0,0 +1,164 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-lfu-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <sys/time.h>
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+
+namespace ns3 {
+
+/**
+ * This program measures the wall-clock cost of the LFU content stores of ndnSIM, comparing the
+ * ordered multiset version (ns3::ndn::cs::Lfu) with the frequency bucket version
+ * (ns3::ndn::cs::BucketLfu):
+ *
+ *     ./waf --run "ndn-lfu-benchmark --cs=ns3::ndn::cs::Lfu --entries=100000"
+ *     ./waf --run "ndn-lfu-benchmark --cs=ns3::ndn::cs::BucketLfu --entries=100000"
+ *
+ * The content store is created with capacity of --entries packets. The benchmark first fills
+ * it, then performs --lookups lookups of existing names drawn from a Zipf distribution (each
+ * hit updates the frequency of the entry), and finally inserts another --entries packets to
+ * measure insertion with eviction.
+ */
+class LfuBenchmark {
+public:
+  LfuBenchmark()
+    : m_cs("ns3::ndn::cs::BucketLfu")
+    , m_nEntries(100000)
+    , m_nLookups(1000000)
+    , m_s(0.8)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  static shared_ptr<ndn::Data>
+  makeData(const ndn::Name& name);
+
+  static double
+  getRealTime();
+
+private:
+  std::string m_cs;
+  uint32_t m_nEntries;
+  uint32_t m_nLookups;
+  double m_s;
+};
+
+shared_ptr<ndn::Data>
+LfuBenchmark::makeData(const ndn::Name& name)
+{
+  auto data = make_shared<ndn::Data>(name);
+  data->setContent(make_shared< ::ndn::Buffer>(1024));
+
+  // same fake signature as ndn::Producer, so that Data has wire encoding and full name
+  ndn::Signature signature;
+  ndn::SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+  signature.setInfo(signatureInfo);
+  signature.setValue(::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+  data->setSignature(signature);
+
+  data->wireEncode();
+  return data;
+}
+
+double
+LfuBenchmark::getRealTime()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+int
+LfuBenchmark::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("cs", "Content store implementation", m_cs);
+  cmd.AddValue("entries", "Content store capacity and number of Data packets to insert",
+               m_nEntries);
+  cmd.AddValue("lookups", "Number of lookups of cached names", m_nLookups);
+  cmd.AddValue("s", "Zipf exponent of the lookup popularity", m_s);
+  cmd.Parse(argc, argv);
+
+  ObjectFactory factory(m_cs);
+  factory.Set("MaxSize", UintegerValue(m_nEntries));
+  Ptr<ndn::ContentStore> cs = factory.Create<ndn::ContentStore>();
+
+  // Data packets and Interests are prepared in advance, so that only CS operations are timed
+  std::vector<shared_ptr<ndn::Data>> dataset;
+  dataset.reserve(2 * m_nEntries);
+  for (uint32_t i = 0; i < 2 * m_nEntries; ++i) {
+    dataset.push_back(makeData(ndn::Name("/prefix").appendNumber(i % 100).appendNumber(i)));
+  }
+
+  Ptr<ZipfRandomVariable> zipf = CreateObject<ZipfRandomVariable>();
+  zipf->SetAttribute("N", IntegerValue(m_nEntries));
+  zipf->SetAttribute("Alpha", DoubleValue(m_s));
+
+  std::vector<shared_ptr<const ndn::Interest>> lookups;
+  lookups.reserve(m_nLookups);
+  for (uint32_t i = 0; i < m_nLookups; ++i) {
+    uint32_t seq = zipf->GetInteger() - 1;
+    lookups.push_back(
+      make_shared<ndn::Interest>(ndn::Name("/prefix").appendNumber(seq % 100).appendNumber(seq)));
+  }
+
+  double beginRealTime = getRealTime();
+  for (uint32_t i = 0; i < m_nEntries; ++i) {
+    cs->Add(dataset[i]);
+  }
+  double insertTime = getRealTime() - beginRealTime;
+
+  uint32_t nFound = 0;
+  beginRealTime = getRealTime();
+  for (const shared_ptr<const ndn::Interest>& interest : lookups) {
+    nFound += cs->Lookup(interest) != nullptr;
+  }
+  double lookupTime = getRealTime() - beginRealTime;
+
+  beginRealTime = getRealTime();
+  for (uint32_t i = m_nEntries; i < 2 * m_nEntries; ++i) {
+    cs->Add(dataset[i]);
+  }
+  double evictTime = getRealTime() - beginRealTime;
+
+  std::cout << "ContentStore" << "\t" << "Entries" << "\t" << "Insert" << "\t" << "Lookup" << "\t"
+            << "InsertWithEviction" << "\t" << "Found" << "\t" << "Memory" << "\n";
+  std::cout << m_cs << "\t" << m_nEntries << "\t" << insertTime << "\t" << lookupTime << "\t"
+            << evictTime << "\t" << nFound << "\t" << MemUsage::Get() / 1024.0 / 1024.0
+            << "MiB\n";
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::LfuBenchmark benchmark;
+  return benchmark.run(argc, argv);
+}
@@ -0,0 +1,14 @@
+#!/bin/bash
+
+lookups=1000000
+
+# compare the multiset LFU content store against the frequency bucket one
+for entries in 10000 100000 1000000; do
+  echo "Number of entries = " $entries
+
+  for cs in ns3::ndn::cs::Lfu ns3::ndn::cs::BucketLfu; do
+    ../../../waf --run ndn-lfu-benchmark --command-template="%s --cs=${cs} --entries=${entries} --lookups=${lookups}"
+  done
+
+  echo
+done
@@ -0,0 +1,10 @@
+#!/bin/bash
+
+entries=100000
+
+# memory per PIT entry and PIT insert/satisfy rate for common in-record/out-record counts
+for downstreams in 1 2 4; do
+  for upstreams in 1 2; do
+    ../../../waf --run ndn-pit-benchmark --command-template="%s --entries=${entries} --downstreams=${downstreams} --upstreams=${upstreams}"
+  done
+done
@@ -0,0 +1,184 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-routing-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/model/ndn-global-router.hpp"
+#include "ns3/ndnSIM/helper/ndn-global-routing-graph.hpp"
+#include "ns3/ndnSIM/helper/ndn-brite-topology-helper.hpp"
+#include "ns3/ndnSIM/utils/topology/rocketfuel-map-reader.hpp"
+
+#include <sys/time.h>
+#include <thread>
+
+namespace ns3 {
+
+/**
+ * This program measures the wall-clock time of global route calculation on a Rocketfuel map
+ * (.cch) or a BRITE-generated topology, for an increasing number of threads:
+ *
+ *     ./waf --run "ndn-routing-benchmark --topology=rocketfuel --file=1755.r0.cch"
+ *     ./waf --run "ndn-routing-benchmark --topology=brite --file=brite.conf --max-threads=8"
+ *
+ * Every node originates its own prefix.  For each thread count the shortest path trees of all
+ * nodes are calculated on a single router graph snapshot; afterwards the full
+ * GlobalRoutingHelper::CalculateRoutes, including FIB installation, is timed once.
+ */
+class RoutingBenchmark {
+public:
+  RoutingBenchmark()
+    : m_topology("rocketfuel")
+    , m_maxThreads(std::max(std::thread::hardware_concurrency(), 1u))
+    , m_nRuns(3)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  void
+  readTopology();
+
+  static double
+  getRealTime();
+
+private:
+  std::string m_topology;
+  std::string m_file;
+  uint32_t m_maxThreads;
+  uint32_t m_nRuns;
+
+  // topology readers own the created nodes and devices
+  std::unique_ptr<ndn::NDNBriteTopologyHelper> m_brite;
+  std::unique_ptr<RocketfuelMapReader> m_rocketfuel;
+};
+
+void
+RoutingBenchmark::readTopology()
+{
+  if (m_topology == "brite") {
+    m_brite.reset(new ndn::NDNBriteTopologyHelper(m_file));
+    m_brite->AssignStreams(1);
+    m_brite->BuildBriteTopology();
+  }
+  else {
+    RocketfuelParams params;
+    params.averageRtt = 2; // s
+    params.clientNodeDegrees = 2;
+    params.minb2bBandwidth = params.maxb2bBandwidth = "100Mbps";
+    params.minb2bDelay = params.maxb2bDelay = "5ms";
+    params.minb2gBandwidth = params.maxb2gBandwidth = "10Mbps";
+    params.minb2gDelay = params.maxb2gDelay = "5ms";
+    params.ming2cBandwidth = params.maxg2cBandwidth = "1Mbps";
+    params.ming2cDelay = params.maxg2cDelay = "10ms";
+
+    m_rocketfuel.reset(new RocketfuelMapReader(""));
+    m_rocketfuel->SetFileName(m_file);
+    m_rocketfuel->Read(params);
+  }
+}
+
+double
+RoutingBenchmark::getRealTime()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+int
+RoutingBenchmark::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("topology", "Topology type (rocketfuel or brite)", m_topology);
+  cmd.AddValue("file", "Rocketfuel map (.cch) or BRITE configuration file", m_file);
+  cmd.AddValue("max-threads", "Largest number of threads to measure", m_maxThreads);
+  cmd.AddValue("runs", "Number of calculations for each number of threads", m_nRuns);
+  cmd.Parse(argc, argv);
+
+  if (m_file.empty()) {
+    std::cerr << "--file is required" << std::endl;
+    return 1;
+  }
+
+  readTopology();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::GlobalRoutingHelper routingHelper;
+  routingHelper.InstallAll();
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    routingHelper.AddOrigin("/node" + std::to_string((*node)->GetId()), *node);
+  }
+
+  double beginRealTime = getRealTime();
+  ndn::GlobalRoutingGraph graph;
+  double snapshotTime = getRealTime() - beginRealTime;
+
+  std::vector<ndn::GlobalRoutingGraph::Source> sources;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    sources.push_back(graph.GetVertex((*node)->GetObject<ndn::GlobalRouter>()));
+  }
+
+  std::cout << "Topology" << "\t" << "Nodes" << "\t" << "Vertices" << "\t" << "Snapshot" << "\n";
+  std::cout << m_topology << "\t" << NodeList::GetNNodes() << "\t" << graph.GetNVertices()
+            << "\t" << snapshotTime << "\n\n";
+
+  std::cout << "Threads" << "\t" << "Time" << "\t" << "Speedup" << "\t" << "Routes" << "\n";
+  double sequentialTime = 0;
+  for (uint32_t nThreads = 1; nThreads <= m_maxThreads; nThreads *= 2) {
+    size_t nRoutes = 0;
+    beginRealTime = getRealTime();
+    for (uint32_t run = 0; run < m_nRuns; ++run) {
+      for (const auto& routes : graph.CalculateRoutes(sources, nThreads)) {
+        nRoutes += routes.size();
+      }
+    }
+    double time = (getRealTime() - beginRealTime) / m_nRuns;
+    if (nThreads == 1)
+      sequentialTime = time;
+
+    std::cout << nThreads << "\t" << time << "\t" << sequentialTime / time << "\t"
+              << nRoutes / m_nRuns << "\n";
+  }
+
+  ndn::GlobalRoutingHelper::SetRouteCalculationThreads(m_maxThreads);
+  beginRealTime = getRealTime();
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  std::cout << "\nCalculateRoutes with " << m_maxThreads << " threads, including FIB installation: "
+            << getRealTime() - beginRealTime << "\n";
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::RoutingBenchmark benchmark;
+  return benchmark.run(argc, argv);
+}
@@ -0,0 +1,11 @@
+#!/bin/bash
+
+# usage: ./ndn-routing-benchmark.sh <rocketfuel .cch map> <BRITE configuration file>
+rocketfuel=${1:-1755.r0.cch}
+brite=${2:-brite.conf}
+max_threads=$(nproc)
+
+# route calculation time against number of threads on Rocketfuel and BRITE topologies
+../../../waf --run ndn-routing-benchmark --command-template="%s --topology=rocketfuel --file=${rocketfuel} --max-threads=${max_threads}"
+echo
+../../../waf --run ndn-routing-benchmark --command-template="%s --topology=brite --file=${brite} --max-threads=${max_threads}"
@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-stack-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * This program measures the time and memory that ndn::StackHelper::Install takes per node on a
+ * chain of point-to-point connected nodes, optionally for forwarding-only nodes:
+ *
+ *     ./waf --run "ndn-stack-benchmark --nodes=10000"
+ *     ./waf --run "ndn-stack-benchmark --nodes=10000 --forwarding-only=1"
+ */
+class StackBenchmark {
+public:
+  StackBenchmark()
+    : m_nNodes(1000)
+    , m_isForwardingOnly(false)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  static double
+  getRealTime();
+
+private:
+  uint32_t m_nNodes;
+  bool m_isForwardingOnly;
+};
+
+double
+StackBenchmark::getRealTime()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+int
+StackBenchmark::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("nodes", "Number of nodes", m_nNodes);
+  cmd.AddValue("forwarding-only", "Install nodes without NFD management", m_isForwardingOnly);
+  cmd.Parse(argc, argv);
+
+  NodeContainer nodes;
+  nodes.Create(m_nNodes);
+
+  PointToPointHelper p2p;
+  for (uint32_t i = 1; i < m_nNodes; ++i) {
+    p2p.Install(nodes.Get(i - 1), nodes.Get(i));
+  }
+
+  double topologyMemory = MemUsage::Get() / 1024.0 / 1024.0;
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.setForwardingOnly(m_isForwardingOnly);
+  double beginRealTime = getRealTime();
+  ndnHelper.InstallAll();
+  double installTime = getRealTime() - beginRealTime;
+
+  double memory = MemUsage::Get() / 1024.0 / 1024.0;
+
+  std::cout << "Nodes" << "\t" << "Mode" << "\t" << "Install" << "\t" << "PerNode" << "\t"
+            << "Memory" << "\t" << "PerNode" << "\n";
+  std::cout << m_nNodes << "\t" << (m_isForwardingOnly ? "forwarding-only" : "full") << "\t"
+            << installTime << "\t" << installTime / m_nNodes << "\t" << memory << "MiB" << "\t"
+            << (memory - topologyMemory) * 1024 / m_nNodes << "KiB\n";
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::StackBenchmark benchmark;
+  return benchmark.run(argc, argv);
+}
@@ -0,0 +1,8 @@
+#!/bin/bash
+
+# time and memory of ndn::StackHelper::Install per node, with and without NFD management
+for nodes in 1000 10000; do
+  for forwarding_only in 0 1; do
+    ../../../waf --run ndn-stack-benchmark --command-template="%s --nodes=${nodes} --forwarding-only=${forwarding_only}"
+  done
+done
@@ -52,3 +52,10 @@ echo
 echo "Using best route forwarding strategy.."
 
 ../../../waf --run ndn-test --command-template="%s --cs-size=${size} --rate=${rate} --strategy="/localhost/nfd/strategy/best-route" --sim-time=${sim_time}"
+
+echo
+
+# using NCC forwarding strategy, which keeps StrategyInfo on PIT and Measurements entries
+echo "Using NCC forwarding strategy.."
+
+../../../waf --run ndn-test --command-template="%s --cs-size=${size} --rate=${rate} --strategy="/localhost/nfd/strategy/ncc" --sim-time=${sim_time}"
@@ -0,0 +1,184 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-timer-wheel-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <sys/time.h>
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+
+namespace ns3 {
+
+/**
+ * This scenario measures the wall-clock cost of NFD timers (PIT unsatisfy and straggler
+ * timers, Dead Nonce List, Measurements) on the topologies of the ndn-grid and
+ * ndn-tree-tracers examples.
+ *
+ * Run once with --tick=0s to schedule every timer as a separate ns-3 event,
+ * and once with a non-zero tick to batch timers on the forwarder's timer wheel:
+ *
+ *     ./waf --run "ndn-timer-wheel-benchmark --topology=grid --tick=0s"
+ *     ./waf --run "ndn-timer-wheel-benchmark --topology=grid --tick=1ms"
+ */
+class TimerWheelBenchmark {
+public:
+  TimerWheelBenchmark()
+    : m_topology("grid")
+    , m_gridSize(10)
+    , m_interestRate(1000)
+    , m_tick(Seconds(0))
+    , m_simulationTime(Seconds(20))
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  void
+  buildGrid(NodeContainer& consumers, Ptr<Node>& producer);
+
+  void
+  buildTree(NodeContainer& consumers, Ptr<Node>& producer);
+
+  static double
+  getRealTime();
+
+private:
+  std::string m_topology;
+  uint32_t m_gridSize;
+  double m_interestRate;
+  Time m_tick;
+  Time m_simulationTime;
+};
+
+void
+TimerWheelBenchmark::buildGrid(NodeContainer& consumers, Ptr<Node>& producer)
+{
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(m_gridSize, m_gridSize, p2p);
+  grid.BoundingBox(100, 100, 200, 200);
+
+  for (uint32_t col = 0; col < m_gridSize; ++col) {
+    consumers.Add(grid.GetNode(0, col));
+  }
+  producer = grid.GetNode(m_gridSize - 1, m_gridSize - 1);
+}
+
+void
+TimerWheelBenchmark::buildTree(NodeContainer& consumers, Ptr<Node>& producer)
+{
+  AnnotatedTopologyReader topologyReader("", 1);
+  topologyReader.SetFileName("src/ndnSIM/examples/topologies/topo-tree.txt");
+  topologyReader.Read();
+
+  for (int i = 1; i <= 4; ++i) {
+    consumers.Add(Names::Find<Node>("leaf-" + std::to_string(i)));
+  }
+  producer = Names::Find<Node>("root");
+}
+
+double
+TimerWheelBenchmark::getRealTime()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+int
+TimerWheelBenchmark::run(int argc, char* argv[])
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Gbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("1000"));
+
+  CommandLine cmd;
+  cmd.AddValue("topology", "Topology to use (grid or tree)", m_topology);
+  cmd.AddValue("grid-size", "Number of nodes on each side of the grid", m_gridSize);
+  cmd.AddValue("rate", "Interest rate of each consumer", m_interestRate);
+  cmd.AddValue("tick", "Timer wheel tick interval (0s disables the wheel)", m_tick);
+  cmd.AddValue("sim-time", "Simulation time", m_simulationTime);
+  cmd.Parse(argc, argv);
+
+  NodeContainer consumers;
+  Ptr<Node> producer;
+  if (m_topology == "tree") {
+    buildTree(consumers, producer);
+  }
+  else {
+    buildGrid(consumers, producer);
+  }
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.setTimerWheelTick(m_tick);
+  ndnHelper.InstallAll();
+
+  ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/best-route");
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  // each consumer requests unique names, so that every Interest creates PIT entries end to end
+  for (NodeContainer::Iterator node = consumers.Begin(); node != consumers.End(); ++node) {
+    ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+    consumerHelper.SetAttribute("Frequency", DoubleValue(m_interestRate));
+    consumerHelper.SetPrefix("/prefix/" + std::to_string((*node)->GetId()));
+    consumerHelper.Install(*node);
+  }
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(producer);
+
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", producer);
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  Simulator::Stop(m_simulationTime);
+
+  double beginRealTime = getRealTime();
+  Simulator::Run();
+  double realTime = getRealTime() - beginRealTime;
+
+  std::cout << "Topology" << "\t" << "Tick" << "\t" << "RealTime" << "\t"
+            << "NumberOfInterests (per real time)" << "\t" << "Memory" << "\n";
+  double nInterests = m_interestRate * consumers.GetN() * m_simulationTime.ToDouble(Time::S);
+  std::cout << m_topology << "\t" << m_tick << "\t" << realTime << "\t"
+            << nInterests / realTime << "\t"
+            << MemUsage::Get() / 1024.0 / 1024.0 << "MiB\n";
+
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::TimerWheelBenchmark benchmark;
+  return benchmark.run(argc, argv);
+}
@@ -0,0 +1,17 @@
+#!/bin/bash
+
+rate=1000
+sim_time=20
+
+# compare per-timer ns-3 events against the timer wheel with several tick intervals
+for topology in grid tree; do
+  echo "Topology = " $topology, "interest rate = " $rate
+
+  for tick in 0s 100us 1ms 10ms; do
+    echo "Timer wheel tick = " $tick
+
+    ../../../waf --run ndn-timer-wheel-benchmark --command-template="%s --topology=${topology} --rate=${rate} --tick=${tick} --sim-time=${sim_time}"
+
+    echo
+  done
+done
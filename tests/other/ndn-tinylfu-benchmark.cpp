@@ -0,0 +1,192 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-tinylfu-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <sys/time.h>
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+
+namespace ns3 {
+
+/**
+ * This scenario compares hit ratio and cost of an edge cache with and without TinyLFU admission
+ * under Zipf-Mandelbrot workload:
+ *
+ *   (consumer 1) --+
+ *   (consumer 2) --+-- (edge router) ---- (producer)
+ *        ...       |
+ *   (consumer N) --+
+ *
+ * Only the edge router caches Data, using the selected ndnSIM content store:
+ *
+ *     ./waf --run "ndn-tinylfu-benchmark --cs=ns3::ndn::cs::Lru"
+ *     ./waf --run "ndn-tinylfu-benchmark --cs=ns3::ndn::cs::TinyLfu::Lru"
+ */
+class TinyLfuBenchmark {
+public:
+  TinyLfuBenchmark()
+    : m_cs("ns3::ndn::cs::TinyLfu::Lru")
+    , m_csSize(100)
+    , m_nConsumers(10)
+    , m_nContents(10000)
+    , m_q(0.7)
+    , m_s(0.7)
+    , m_interestRate(100)
+    , m_simulationTime(Seconds(100))
+    , m_nHits(0)
+    , m_nMisses(0)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  void
+  onCacheHit(shared_ptr<const ndn::Interest> interest, shared_ptr<const ndn::Data> data)
+  {
+    ++m_nHits;
+  }
+
+  void
+  onCacheMiss(shared_ptr<const ndn::Interest> interest)
+  {
+    ++m_nMisses;
+  }
+
+  static double
+  getRealTime();
+
+private:
+  std::string m_cs;
+  uint32_t m_csSize;
+  uint32_t m_nConsumers;
+  uint32_t m_nContents;
+  double m_q;
+  double m_s;
+  double m_interestRate;
+  Time m_simulationTime;
+
+  uint64_t m_nHits;
+  uint64_t m_nMisses;
+};
+
+double
+TinyLfuBenchmark::getRealTime()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+int
+TinyLfuBenchmark::run(int argc, char* argv[])
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Gbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("1000"));
+
+  CommandLine cmd;
+  cmd.AddValue("cs", "Content store of the edge router", m_cs);
+  cmd.AddValue("cs-size", "Maximum number of packets in the edge router's cache", m_csSize);
+  cmd.AddValue("consumers", "Number of consumers", m_nConsumers);
+  cmd.AddValue("contents", "Number of different contents", m_nContents);
+  cmd.AddValue("q", "Zipf-Mandelbrot q parameter", m_q);
+  cmd.AddValue("s", "Zipf-Mandelbrot s parameter", m_s);
+  cmd.AddValue("rate", "Interest rate of each consumer", m_interestRate);
+  cmd.AddValue("sim-time", "Simulation time", m_simulationTime);
+  cmd.Parse(argc, argv);
+
+  NodeContainer consumers;
+  consumers.Create(m_nConsumers);
+  Ptr<Node> router = CreateObject<Node>();
+  Ptr<Node> producer = CreateObject<Node>();
+
+  PointToPointHelper p2p;
+  for (NodeContainer::Iterator node = consumers.Begin(); node != consumers.End(); ++node) {
+    p2p.Install(*node, router);
+  }
+  p2p.Install(router, producer);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetOldContentStore("ns3::ndn::cs::Nocache");
+  ndnHelper.Install(consumers);
+  ndnHelper.Install(producer);
+
+  ndnHelper.SetOldContentStore(m_cs, "MaxSize", std::to_string(m_csSize));
+  ndnHelper.Install(router);
+
+  ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/best-route");
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerZipfMandelbrot");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", DoubleValue(m_interestRate));
+  consumerHelper.SetAttribute("NumberOfContents", UintegerValue(m_nContents));
+  consumerHelper.SetAttribute("q", DoubleValue(m_q));
+  consumerHelper.SetAttribute("s", DoubleValue(m_s));
+  consumerHelper.Install(consumers);
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(producer);
+
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", producer);
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  Ptr<ndn::ContentStore> cs = router->GetObject<ndn::ContentStore>();
+  cs->TraceConnectWithoutContext("CacheHits", MakeCallback(&TinyLfuBenchmark::onCacheHit, this));
+  cs->TraceConnectWithoutContext("CacheMisses",
+                                 MakeCallback(&TinyLfuBenchmark::onCacheMiss, this));
+
+  Simulator::Stop(m_simulationTime);
+
+  double beginRealTime = getRealTime();
+  Simulator::Run();
+  double realTime = getRealTime() - beginRealTime;
+
+  uint64_t nLookups = m_nHits + m_nMisses;
+  std::cout << "ContentStore" << "\t" << "CsSize" << "\t" << "HitRatio" << "\t" << "RealTime"
+            << "\t" << "Lookups (per real time)" << "\t" << "Memory" << "\n";
+  std::cout << m_cs << "\t" << m_csSize << "\t"
+            << (nLookups > 0 ? static_cast<double>(m_nHits) / nLookups : 0.0) << "\t"
+            << realTime << "\t" << nLookups / realTime << "\t"
+            << MemUsage::Get() / 1024.0 / 1024.0 << "MiB\n";
+
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::TinyLfuBenchmark benchmark;
+  return benchmark.run(argc, argv);
+}
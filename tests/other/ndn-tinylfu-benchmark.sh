@@ -0,0 +1,17 @@
+#!/bin/bash
+
+contents=10000
+sim_time=100
+
+# compare replacement policies with and without TinyLFU admission at several cache sizes
+for cs_size in 100 1000; do
+  echo "CS size = " $cs_size, "number of contents = " $contents
+
+  for policy in Lru Lfu Fifo Random; do
+    for cs in ns3::ndn::cs::${policy} ns3::ndn::cs::TinyLfu::${policy}; do
+      ../../../waf --run ndn-tinylfu-benchmark --command-template="%s --cs=${cs} --cs-size=${cs_size} --contents=${contents} --sim-time=${sim_time}"
+    done
+  done
+
+  echo
+done
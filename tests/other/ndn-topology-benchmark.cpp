@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-topology-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/topology/rocketfuel-map-reader.hpp"
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * This program measures the time and memory needed to load a topology: an annotated topology
+ * file or a binary topology file (both with AnnotatedTopologyReader), or a Rocketfuel map:
+ *
+ *     ./waf --run "ndn-topology-benchmark --file=topo.txt"
+ *     ./waf --run "ndn-topology-benchmark --file=topo.bin"
+ *     ./waf --run "ndn-topology-benchmark --format=rocketfuel --file=1755.r0.cch"
+ *
+ * Binary files are created with the ndn-topology-converter example.
+ */
+class TopologyBenchmark {
+public:
+  TopologyBenchmark()
+    : m_format("annotated")
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  static double
+  getRealTime();
+
+private:
+  std::string m_format;
+  std::string m_file;
+};
+
+double
+TopologyBenchmark::getRealTime()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+int
+TopologyBenchmark::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("format", "Topology format (annotated, also for binary files, or rocketfuel)",
+               m_format);
+  cmd.AddValue("file", "Topology file", m_file);
+  cmd.Parse(argc, argv);
+
+  if (m_file.empty()) {
+    std::cerr << "--file is required" << std::endl;
+    return 1;
+  }
+
+  std::unique_ptr<AnnotatedTopologyReader> reader;
+  double beginRealTime = getRealTime();
+  if (m_format == "rocketfuel") {
+    RocketfuelParams params;
+    params.averageRtt = 2; // s
+    params.clientNodeDegrees = 2;
+    params.minb2bBandwidth = params.maxb2bBandwidth = "100Mbps";
+    params.minb2bDelay = params.maxb2bDelay = "5ms";
+    params.minb2gBandwidth = params.maxb2gBandwidth = "10Mbps";
+    params.minb2gDelay = params.maxb2gDelay = "5ms";
+    params.ming2cBandwidth = params.maxg2cBandwidth = "1Mbps";
+    params.ming2cDelay = params.maxg2cDelay = "10ms";
+
+    RocketfuelMapReader* rocketfuel = new RocketfuelMapReader("");
+    reader.reset(rocketfuel);
+    rocketfuel->SetFileName(m_file);
+    rocketfuel->Read(params);
+  }
+  else {
+    reader.reset(new AnnotatedTopologyReader(""));
+    reader->SetFileName(m_file);
+    reader->Read();
+  }
+  double loadTime = getRealTime() - beginRealTime;
+
+  std::cout << "File" << "\t" << "Nodes" << "\t" << "Links" << "\t" << "Load" << "\t"
+            << "Memory" << "\n";
+  std::cout << m_file << "\t" << reader->GetNodes().GetN() << "\t" << reader->GetLinks().size()
+            << "\t" << loadTime << "\t" << MemUsage::Get() / 1024.0 / 1024.0 << "MiB\n";
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::TopologyBenchmark benchmark;
+  return benchmark.run(argc, argv);
+}
@@ -0,0 +1,15 @@
+#!/bin/bash
+
+# usage: ./ndn-topology-benchmark.sh <annotated topology file> <rocketfuel .cch map>
+annotated=${1:-topo.txt}
+rocketfuel=${2:-1755.r0.cch}
+
+# load time of text topologies against the same topologies in binary format
+../../../waf --run ndn-topology-converter --command-template="%s --input=${annotated} --output=annotated.bin"
+../../../waf --run ndn-topology-converter --command-template="%s --format=rocketfuel --input=${rocketfuel} --output=rocketfuel.bin"
+
+../../../waf --run ndn-topology-benchmark --command-template="%s --file=${annotated}"
+../../../waf --run ndn-topology-benchmark --command-template="%s --file=annotated.bin"
+echo
+../../../waf --run ndn-topology-benchmark --command-template="%s --format=rocketfuel --file=${rocketfuel}"
+../../../waf --run ndn-topology-benchmark --command-template="%s --file=rocketfuel.bin"
@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+// ndn-trie-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/trie/trie-with-policy.hpp"
+#include "ns3/ndnSIM/utils/trie/lru-policy.hpp"
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * This program compares the original trie of ndnSIM with compact_trie, both used through
+ * trie_with_policy with LRU replacement (as in ns3::ndn::cs::Lru):
+ *
+ *     ./waf --run "ndn-trie-benchmark --trie=trie --entries=100000"
+ *     ./waf --run "ndn-trie-benchmark --trie=compact --entries=100000"
+ *
+ * The trie is limited to --entries payloads.  The benchmark first fills it, then performs
+ * --lookups exact lookups of existing names, and finally inserts another --entries names to
+ * measure insertion with eviction.  Memory is the growth of the process while the trie is filled.
+ */
+class TrieBenchmark {
+public:
+  TrieBenchmark()
+    : m_trie("compact")
+    , m_nEntries(100000)
+    , m_nLookups(1000000)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  struct Payload : public SimpleRefCount<Payload> {
+  };
+
+  template<template<typename, typename, typename> class Trie>
+  void
+  measure(const std::vector<ndn::Name>& names);
+
+  static double
+  getRealTime();
+
+private:
+  std::string m_trie;
+  uint32_t m_nEntries;
+  uint32_t m_nLookups;
+};
+
+double
+TrieBenchmark::getRealTime()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+template<template<typename, typename, typename> class Trie>
+void
+TrieBenchmark::measure(const std::vector<ndn::Name>& names)
+{
+  typedef ndn::ndnSIM::trie_with_policy<ndn::Name,
+                                        ndn::ndnSIM::smart_pointer_payload_traits<Payload>,
+                                        ndn::ndnSIM::lru_policy_traits, Trie> trie_type;
+
+  trie_type trie;
+  trie.getPolicy().set_max_size(m_nEntries);
+  Ptr<Payload> payload = Create<Payload>();
+
+  int64_t memoryBefore = MemUsage::Get();
+  double beginRealTime = getRealTime();
+  for (uint32_t i = 0; i < m_nEntries; ++i) {
+    trie.insert(names[i], payload);
+  }
+  double insertTime = getRealTime() - beginRealTime;
+  int64_t memory = MemUsage::Get() - memoryBefore;
+
+  uint32_t nFound = 0;
+  beginRealTime = getRealTime();
+  for (uint32_t i = 0; i < m_nLookups; ++i) {
+    nFound += trie.find_exact(names[i % m_nEntries]) != trie.end();
+  }
+  double lookupTime = getRealTime() - beginRealTime;
+
+  beginRealTime = getRealTime();
+  for (uint32_t i = m_nEntries; i < 2 * m_nEntries; ++i) {
+    trie.insert(names[i], payload);
+  }
+  double evictTime = getRealTime() - beginRealTime;
+
+  std::cout << "Trie" << "\t" << "Entries" << "\t" << "Insert" << "\t" << "Lookup" << "\t"
+            << "InsertWithEviction" << "\t" << "Found" << "\t" << "Memory" << "\n";
+  std::cout << m_trie << "\t" << m_nEntries << "\t" << insertTime << "\t" << lookupTime << "\t"
+            << evictTime << "\t" << nFound << "\t" << memory / 1024.0 / 1024.0 << "MiB\n";
+}
+
+int
+TrieBenchmark::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("trie", "Trie implementation: trie or compact", m_trie);
+  cmd.AddValue("entries", "Trie capacity and number of names to insert", m_nEntries);
+  cmd.AddValue("lookups", "Number of lookups of inserted names", m_nLookups);
+  cmd.Parse(argc, argv);
+
+  // names are prepared in advance, so that only trie operations are timed
+  std::vector<ndn::Name> names;
+  names.reserve(2 * m_nEntries);
+  for (uint32_t i = 0; i < 2 * m_nEntries; ++i) {
+    names.push_back(ndn::Name("/prefix").appendNumber(i % 100).appendNumber(i));
+  }
+
+  if (m_trie == "trie") {
+    measure<ndn::ndnSIM::trie>(names);
+  }
+  else if (m_trie == "compact") {
+    measure<ndn::ndnSIM::compact_trie>(names);
+  }
+  else {
+    std::cerr << "Unknown trie implementation " << m_trie << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::TrieBenchmark benchmark;
+  return benchmark.run(argc, argv);
+}
@@ -0,0 +1,14 @@
+#!/bin/bash
+
+lookups=1000000
+
+# compare the original trie against compact_trie
+for entries in 10000 100000 1000000; do
+  echo "Number of entries = " $entries
+
+  for trie in trie compact; do
+    ../../../waf --run ndn-trie-benchmark --command-template="%s --trie=${trie} --entries=${entries} --lookups=${lookups}"
+  done
+
+  echo
+done
@@ -0,0 +1,162 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "NFD/core/memory-pool.hpp"
+
+#include "../../tests-common.hpp"
+
+#include <algorithm>
+#include <array>
+#include <set>
+
+namespace ns3 {
+namespace ndn {
+
+struct PoolItem
+{
+  explicit
+  PoolItem(int value)
+    : value(value)
+  {
+  }
+
+  int value;
+  char payload[20];
+};
+
+BOOST_FIXTURE_TEST_SUITE(NfdCoreMemoryPool, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Allocate)
+{
+  nfd::MemoryPool pool(4);
+  nfd::MemoryPool::Occupancy occupancy = pool.getOccupancy();
+  BOOST_CHECK_EQUAL(occupancy.blockSize, 0);
+  BOOST_CHECK_EQUAL(occupancy.nInUse, 0);
+  BOOST_CHECK_EQUAL(occupancy.nFree, 0);
+  BOOST_CHECK_EQUAL(occupancy.nChunks, 0);
+
+  // block size is set by the first allocation
+  BOOST_CHECK(pool.canAllocate(24));
+  BOOST_CHECK(pool.canAllocate(64));
+  std::set<void*> blocks;
+  blocks.insert(pool.allocate(24));
+  BOOST_CHECK(pool.canAllocate(24));
+  BOOST_CHECK(!pool.canAllocate(64));
+
+  occupancy = pool.getOccupancy();
+  BOOST_CHECK_GE(occupancy.blockSize, 24);
+  BOOST_CHECK_EQUAL(occupancy.nInUse, 1);
+  BOOST_CHECK_EQUAL(occupancy.nFree, 3);
+  BOOST_CHECK_EQUAL(occupancy.nChunks, 1);
+
+  for (int i = 0; i < 3; ++i) {
+    blocks.insert(pool.allocate(24));
+  }
+  occupancy = pool.getOccupancy();
+  BOOST_CHECK_EQUAL(occupancy.nInUse, 4);
+  BOOST_CHECK_EQUAL(occupancy.nFree, 0);
+  BOOST_CHECK_EQUAL(occupancy.nChunks, 1);
+
+  // a full pool obtains another chunk
+  blocks.insert(pool.allocate(24));
+  BOOST_CHECK_EQUAL(blocks.size(), 5);
+  occupancy = pool.getOccupancy();
+  BOOST_CHECK_EQUAL(occupancy.nInUse, 5);
+  BOOST_CHECK_EQUAL(occupancy.nFree, 3);
+  BOOST_CHECK_EQUAL(occupancy.nChunks, 2);
+
+  for (void* block : blocks) {
+    pool.deallocate(block);
+  }
+  occupancy = pool.getOccupancy();
+  BOOST_CHECK_EQUAL(occupancy.nInUse, 0);
+  BOOST_CHECK_EQUAL(occupancy.nFree, 8);
+  BOOST_CHECK_EQUAL(occupancy.nChunks, 2);
+}
+
+BOOST_AUTO_TEST_CASE(FreeListReuse)
+{
+  nfd::MemoryPool pool(4);
+  void* a = pool.allocate(sizeof(PoolItem));
+  void* b = pool.allocate(sizeof(PoolItem));
+  std::fill_n(static_cast<char*>(a), sizeof(PoolItem), 'a');
+  std::fill_n(static_cast<char*>(b), sizeof(PoolItem), 'b');
+
+  // the most recently released block is reused first, without a new chunk
+  pool.deallocate(a);
+  void* c = pool.allocate(sizeof(PoolItem));
+  BOOST_CHECK(c == a);
+  BOOST_CHECK_EQUAL(static_cast<char*>(b)[sizeof(PoolItem) - 1], 'b');
+  BOOST_CHECK_EQUAL(pool.getOccupancy().nChunks, 1);
+
+  pool.deallocate(b);
+  pool.deallocate(c);
+
+  // released blocks serve later allocations until the chunk is used up
+  std::vector<void*> blocks;
+  for (int i = 0; i < 4; ++i) {
+    blocks.push_back(pool.allocate(sizeof(PoolItem)));
+  }
+  BOOST_CHECK_EQUAL(pool.getOccupancy().nChunks, 1);
+  BOOST_CHECK_EQUAL(pool.getOccupancy().nFree, 0);
+  BOOST_CHECK_EQUAL(pool.getOccupancy().nInUse, 4);
+
+  for (void* block : blocks) {
+    pool.deallocate(block);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(AllocateShared)
+{
+  shared_ptr<nfd::MemoryPool> pool = make_shared<nfd::MemoryPool>();
+  std::weak_ptr<nfd::MemoryPool> weakPool = pool;
+
+  shared_ptr<PoolItem> a = std::allocate_shared<PoolItem>(nfd::PoolAllocator<PoolItem>(pool), 1);
+  shared_ptr<PoolItem> b = std::allocate_shared<PoolItem>(nfd::PoolAllocator<PoolItem>(pool), 2);
+
+  // object and control block share one block
+  nfd::MemoryPool::Occupancy occupancy = pool->getOccupancy();
+  BOOST_CHECK_GT(occupancy.blockSize, sizeof(PoolItem));
+  BOOST_CHECK_EQUAL(occupancy.nInUse, 2);
+
+  // another type does not fit the block size and is allocated from the heap
+  typedef std::array<char, 256> LargeItem;
+  shared_ptr<LargeItem> large =
+    std::allocate_shared<LargeItem>(nfd::PoolAllocator<LargeItem>(pool));
+  BOOST_CHECK_EQUAL(pool->getOccupancy().nInUse, 2);
+
+  // objects keep the pool alive after its owner releases it
+  pool.reset();
+  BOOST_CHECK(!weakPool.expired());
+  BOOST_CHECK_EQUAL(a->value, 1);
+
+  a.reset();
+  BOOST_CHECK_EQUAL(weakPool.lock()->getOccupancy().nInUse, 1);
+  BOOST_CHECK_EQUAL(weakPool.lock()->getOccupancy().nFree, occupancy.nFree + 1);
+
+  large.reset();
+  BOOST_CHECK(!weakPool.expired());
+  b.reset();
+  BOOST_CHECK(weakPool.expired());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
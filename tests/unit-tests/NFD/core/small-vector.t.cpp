@@ -0,0 +1,175 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "NFD/core/small-vector.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+typedef nfd::SmallVector<int, 2> IntVector;
+
+/**
+ * @brief SmallVector of shared pointers, so that tests can check that every element is
+ *        destroyed exactly once through use_count() of the pointees
+ */
+typedef nfd::SmallVector<shared_ptr<int>, 2> PtrVector;
+
+BOOST_FIXTURE_TEST_SUITE(NfdCoreSmallVector, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Inline)
+{
+  IntVector v;
+  BOOST_CHECK(v.empty());
+  BOOST_CHECK(v.isInline());
+  BOOST_CHECK_EQUAL(v.capacity(), 2);
+
+  v.push_back(1);
+  v.emplace_back(2);
+  BOOST_CHECK(v.isInline());
+  BOOST_CHECK_EQUAL(v.size(), 2);
+  BOOST_CHECK_EQUAL(v.front(), 1);
+  BOOST_CHECK_EQUAL(v.back(), 2);
+
+  // inline elements are stored within the container object
+  const char* object = reinterpret_cast<const char*>(&v);
+  const char* first = reinterpret_cast<const char*>(&v[0]);
+  BOOST_CHECK(first >= object && first < object + sizeof(v));
+}
+
+BOOST_AUTO_TEST_CASE(SpillToHeap)
+{
+  IntVector v;
+  for (int i = 0; i < 5; ++i) {
+    v.push_back(i);
+  }
+  BOOST_CHECK(!v.isInline());
+  BOOST_CHECK_EQUAL(v.size(), 5);
+  BOOST_CHECK_GE(v.capacity(), 5);
+
+  std::vector<int> expected = {0, 1, 2, 3, 4};
+  BOOST_CHECK_EQUAL_COLLECTIONS(v.begin(), v.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(v.at(4), 4);
+  BOOST_CHECK_THROW(v.at(5), std::out_of_range);
+
+  // an argument referring to an existing element stays valid while the storage grows
+  IntVector w;
+  w.push_back(7);
+  w.push_back(8);
+  w.push_back(w[0]);
+  std::vector<int> expectedW = {7, 8, 7};
+  BOOST_CHECK_EQUAL_COLLECTIONS(w.begin(), w.end(), expectedW.begin(), expectedW.end());
+}
+
+BOOST_AUTO_TEST_CASE(Erase)
+{
+  IntVector v;
+  for (int i = 0; i < 4; ++i) {
+    v.push_back(i);
+  }
+
+  // erasure preserves the order of remaining elements
+  IntVector::iterator next = v.erase(v.begin() + 1);
+  BOOST_CHECK_EQUAL(*next, 2);
+  std::vector<int> expected = {0, 2, 3};
+  BOOST_CHECK_EQUAL_COLLECTIONS(v.begin(), v.end(), expected.begin(), expected.end());
+
+  next = v.erase(v.end() - 1);
+  BOOST_CHECK(next == v.end());
+  v.pop_back();
+  v.erase(v.begin());
+  BOOST_CHECK(v.empty());
+
+  // storage is kept until the container is destroyed
+  BOOST_CHECK(!v.isInline());
+}
+
+BOOST_AUTO_TEST_CASE(Iteration)
+{
+  IntVector v;
+  for (int i = 0; i < 3; ++i) {
+    v.push_back(i);
+  }
+
+  int sum = 0;
+  for (int& i : v) {
+    i *= 10;
+    sum += i;
+  }
+  BOOST_CHECK_EQUAL(sum, 30);
+
+  const IntVector& cv = v;
+  std::vector<int> reversed(cv.rbegin(), cv.rend());
+  std::vector<int> expected = {20, 10, 0};
+  BOOST_CHECK_EQUAL_COLLECTIONS(reversed.begin(), reversed.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(std::distance(cv.begin(), cv.end()), 3);
+}
+
+BOOST_AUTO_TEST_CASE(CopyAndMove)
+{
+  shared_ptr<int> item = make_shared<int>(1);
+  {
+    PtrVector small;
+    small.push_back(item);
+
+    PtrVector large;
+    for (int i = 0; i < 3; ++i) {
+      large.push_back(item);
+    }
+    BOOST_CHECK_EQUAL(item.use_count(), 5);
+
+    PtrVector copy(large);
+    BOOST_CHECK_EQUAL(copy.size(), 3);
+    BOOST_CHECK_EQUAL(item.use_count(), 8);
+
+    // moving heap storage transfers the buffer
+    const shared_ptr<int>* buffer = large.begin();
+    PtrVector movedLarge(std::move(large));
+    BOOST_CHECK(movedLarge.begin() == buffer);
+    BOOST_CHECK(large.empty());
+    BOOST_CHECK(large.isInline());
+
+    // moving inline storage moves the elements
+    PtrVector movedSmall(std::move(small));
+    BOOST_CHECK(movedSmall.isInline());
+    BOOST_CHECK_EQUAL(movedSmall.size(), 1);
+    BOOST_CHECK(small.empty());
+    BOOST_CHECK_EQUAL(item.use_count(), 8);
+
+    copy = movedSmall;
+    BOOST_CHECK_EQUAL(copy.size(), 1);
+    BOOST_CHECK_EQUAL(item.use_count(), 6);
+
+    movedSmall = std::move(movedLarge);
+    BOOST_CHECK_EQUAL(movedSmall.size(), 3);
+    BOOST_CHECK_EQUAL(item.use_count(), 5);
+
+    copy.clear();
+    BOOST_CHECK_EQUAL(item.use_count(), 4);
+  }
+
+  // every element has been destroyed exactly once
+  BOOST_CHECK_EQUAL(item.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
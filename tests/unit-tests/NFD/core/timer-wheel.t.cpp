@@ -0,0 +1,238 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "NFD/core/timer-wheel.hpp"
+
+#include "../../tests-common.hpp"
+
+#include <map>
+
+namespace ns3 {
+namespace ndn {
+
+class TimerWheelFixture : public CleanupFixture
+{
+public:
+  TimerWheelFixture()
+    : m_wheel(time::milliseconds(1))
+  {
+  }
+
+  /**
+   * @brief Schedule timer @p id on the wheel, to fire @p after from now
+   */
+  void
+  schedule(int id, Time after)
+  {
+    m_events[id] = m_wheel.schedule(time::nanoseconds(after.GetNanoSeconds()),
+                                    std::bind(&TimerWheelFixture::fire, this, id));
+  }
+
+  void
+  cancel(int id)
+  {
+    nfd::scheduler::cancel(m_events[id]);
+  }
+
+  /**
+   * @brief Schedule timer @p id to fire every @p interval, @p nTimes in total
+   */
+  void
+  rearm(int id, Time interval, int nTimes)
+  {
+    m_events[id] = m_wheel.schedule(time::nanoseconds(interval.GetNanoSeconds()),
+                                    std::bind(&TimerWheelFixture::fireAndRearm, this,
+                                              id, interval, nTimes - 1));
+  }
+
+  void
+  fireAndRearm(int id, Time interval, int nLeft)
+  {
+    m_firings[id].push_back(Simulator::Now());
+    if (nLeft > 0) {
+      rearm(id, interval, nLeft);
+    }
+  }
+
+  void
+  fire(int id)
+  {
+    BOOST_CHECK_MESSAGE(m_fired.count(id) == 0, "timer " << id << " fired twice");
+    m_fired[id] = Simulator::Now();
+  }
+
+  /**
+   * @brief First tick boundary not earlier than @p t
+   */
+  static Time
+  roundUp(Time t)
+  {
+    int64_t tick = MilliSeconds(1).GetNanoSeconds();
+    return NanoSeconds((t.GetNanoSeconds() + tick - 1) / tick * tick);
+  }
+
+protected:
+  nfd::TimerWheel m_wheel;
+  std::map<int, nfd::EventId> m_events;
+  std::map<int, Time> m_fired;
+  std::map<int, std::vector<Time>> m_firings;
+};
+
+BOOST_FIXTURE_TEST_SUITE(NfdCoreTimerWheel, TimerWheelFixture)
+
+BOOST_AUTO_TEST_CASE(Disabled)
+{
+  nfd::TimerWheel disabled;
+  BOOST_CHECK(!disabled.isEnabled());
+
+  // every timer is a separate ns-3 event that fires exactly on time
+  m_events[1] = disabled.schedule(time::microseconds(1500),
+                                  std::bind(&TimerWheelFixture::fire, this, 1));
+  BOOST_CHECK_EQUAL(disabled.size(), 0);
+
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(m_fired[1], MicroSeconds(1500));
+}
+
+BOOST_AUTO_TEST_CASE(RoundUpToTick)
+{
+  BOOST_CHECK(m_wheel.isEnabled());
+
+  schedule(1, Seconds(0));
+  schedule(2, MicroSeconds(1));
+  schedule(3, MicroSeconds(999));
+  schedule(4, MilliSeconds(1));
+  schedule(5, MicroSeconds(1001));
+  schedule(6, MicroSeconds(2500));
+  BOOST_CHECK_EQUAL(m_wheel.size(), 6);
+
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(m_wheel.size(), 0);
+  BOOST_CHECK_EQUAL(m_fired[1], Seconds(0));
+  BOOST_CHECK_EQUAL(m_fired[2], MilliSeconds(1));
+  BOOST_CHECK_EQUAL(m_fired[3], MilliSeconds(1));
+  BOOST_CHECK_EQUAL(m_fired[4], MilliSeconds(1));
+  BOOST_CHECK_EQUAL(m_fired[5], MilliSeconds(2));
+  BOOST_CHECK_EQUAL(m_fired[6], MilliSeconds(3));
+}
+
+BOOST_AUTO_TEST_CASE(LevelBoundaries)
+{
+  // delays in ticks around the ranges of the levels: 256 ticks for level 0,
+  // 256^2 for level 1, 256^3 for level 2
+  std::vector<int64_t> delays = {1, 255, 256, 257, 300, 511, 512, 65535, 65536, 65537, 70000,
+                                 16777215, 16777216, 16777217, 20000000};
+
+  // start in the middle of a tick, so that timers are not aligned with rotations
+  Time start = MicroSeconds(100300);
+  for (size_t i = 0; i < delays.size(); ++i) {
+    Simulator::Schedule(start, &TimerWheelFixture::schedule, this,
+                        static_cast<int>(i), MilliSeconds(delays[i]));
+  }
+
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(m_wheel.size(), 0);
+  for (size_t i = 0; i < delays.size(); ++i) {
+    BOOST_CHECK_EQUAL(m_fired[i], roundUp(start + MilliSeconds(delays[i])));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Cancel)
+{
+  schedule(1, MilliSeconds(10));
+  schedule(2, MilliSeconds(300));
+  schedule(3, Seconds(70));
+  schedule(4, MilliSeconds(5));
+  m_events[5] = m_wheel.schedule(time::milliseconds(5),
+                                 std::bind(&TimerWheelFixture::cancel, this, 1));
+  BOOST_CHECK_EQUAL(m_wheel.size(), 5);
+
+  // timers on level 1 and 2
+  cancel(2);
+  cancel(3);
+  BOOST_CHECK_EQUAL(m_wheel.size(), 3);
+
+  // timers of one tick cancel each other, whichever of them runs first
+  m_events[6] = m_wheel.schedule(time::milliseconds(7),
+                                 std::bind(&TimerWheelFixture::cancel, this, 7));
+  m_events[7] = m_wheel.schedule(time::milliseconds(7),
+                                 std::bind(&TimerWheelFixture::cancel, this, 6));
+
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(m_wheel.size(), 0);
+  BOOST_CHECK_EQUAL(m_fired.size(), 1);
+  BOOST_CHECK_EQUAL(m_fired[4], MilliSeconds(5));
+
+  // cancelling executed or cancelled timers has no effect
+  cancel(4);
+  cancel(2);
+  BOOST_CHECK_EQUAL(m_wheel.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(IdleCatchUp)
+{
+  schedule(1, MilliSeconds(5));
+
+  // the wheel is idle after 5ms, timers scheduled later count from the time of scheduling
+  Simulator::Schedule(MicroSeconds(1000500), &TimerWheelFixture::schedule, this,
+                      2, MilliSeconds(2));
+  Simulator::Schedule(MicroSeconds(1000500), &TimerWheelFixture::schedule, this,
+                      3, MilliSeconds(300));
+
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(m_fired[1], MilliSeconds(5));
+  BOOST_CHECK_EQUAL(m_fired[2], MilliSeconds(1003));
+  BOOST_CHECK_EQUAL(m_fired[3], MilliSeconds(1301));
+}
+
+BOOST_AUTO_TEST_CASE(Rearm)
+{
+  // timers scheduled by a callback, as Dead Nonce List does for its marks
+  rearm(1, MicroSeconds(2500), 4);
+  rearm(2, MilliSeconds(200), 3);
+
+  Simulator::Run();
+  std::vector<Time> expected1 = {MilliSeconds(3), MilliSeconds(6), MilliSeconds(9),
+                                 MilliSeconds(12)};
+  BOOST_CHECK_EQUAL_COLLECTIONS(m_firings[1].begin(), m_firings[1].end(),
+                                expected1.begin(), expected1.end());
+  std::vector<Time> expected2 = {MilliSeconds(200), MilliSeconds(400), MilliSeconds(600)};
+  BOOST_CHECK_EQUAL_COLLECTIONS(m_firings[2].begin(), m_firings[2].end(),
+                                expected2.begin(), expected2.end());
+}
+
+BOOST_AUTO_TEST_CASE(Destroyed)
+{
+  nfd::EventId event;
+  {
+    nfd::TimerWheel wheel(time::milliseconds(1));
+    event = wheel.schedule(time::milliseconds(10), std::bind(&TimerWheelFixture::fire, this, 1));
+    BOOST_CHECK_EQUAL(wheel.size(), 1);
+  }
+
+  // pending timers are dropped with the wheel, and can still be cancelled
+  nfd::scheduler::cancel(event);
+  Simulator::Run();
+  BOOST_CHECK(m_fired.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,96 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "NFD/daemon/fw/forwarder.hpp"
+
+#include "ns3/ndnSIM-module.h"
+
+#include "../../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(NfdDaemonFwForwarder, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(PoolOccupancy)
+{
+  nfd::Forwarder forwarder;
+
+  nfd::ForwarderPoolOccupancy before = forwarder.getPoolOccupancy();
+  BOOST_CHECK_EQUAL(before.pitEntries.nInUse, 0);
+  BOOST_CHECK_EQUAL(before.csEntries.nInUse, 0);
+  BOOST_CHECK_EQUAL(before.csEntries.nFree, forwarder.getCs().getLimit());
+
+  std::vector<shared_ptr<Interest>> interests;
+  std::vector<shared_ptr<nfd::pit::Entry>> entries;
+  for (int i = 0; i < 3; ++i) {
+    interests.push_back(make_shared<Interest>(Name("/pool-occupancy").appendNumber(i)));
+    entries.push_back(forwarder.getPit().insert(*interests.back()).first);
+  }
+
+  // one block per PIT entry, and one Name Tree entry and node for every new prefix
+  nfd::ForwarderPoolOccupancy occupancy = forwarder.getPoolOccupancy();
+  BOOST_CHECK_GT(occupancy.pitEntries.blockSize, 0);
+  BOOST_CHECK_EQUAL(occupancy.pitEntries.nInUse, 3);
+  BOOST_CHECK_EQUAL(occupancy.pitEntries.nChunks, 1);
+  BOOST_CHECK_EQUAL(occupancy.nameTreeEntries.nInUse, before.nameTreeEntries.nInUse + 4);
+  BOOST_CHECK_EQUAL(occupancy.nameTreeNodes.nInUse, before.nameTreeNodes.nInUse + 4);
+
+  // erased entries keep their blocks while they are referenced
+  for (const shared_ptr<nfd::pit::Entry>& entry : entries) {
+    forwarder.getPit().erase(entry);
+  }
+  occupancy = forwarder.getPoolOccupancy();
+  BOOST_CHECK_EQUAL(occupancy.pitEntries.nInUse, 3);
+  BOOST_CHECK_EQUAL(occupancy.nameTreeNodes.nInUse, before.nameTreeNodes.nInUse);
+
+  entries.clear();
+  occupancy = forwarder.getPoolOccupancy();
+  BOOST_CHECK_EQUAL(occupancy.pitEntries.nInUse, 0);
+  BOOST_CHECK_GE(occupancy.pitEntries.nFree, 3);
+  BOOST_CHECK_EQUAL(occupancy.nameTreeEntries.nInUse, before.nameTreeEntries.nInUse);
+}
+
+BOOST_AUTO_TEST_CASE(PoolOutlivesForwarder)
+{
+  std::unique_ptr<nfd::Forwarder> forwarder(new nfd::Forwarder());
+
+  shared_ptr<Interest> interest = make_shared<Interest>("/pool-lifetime");
+  shared_ptr<nfd::pit::Entry> entry = forwarder->getPit().insert(*interest).first;
+  forwarder->getPit().erase(entry);
+
+  // the entry's control block holds the pool, so the entry remains usable
+  forwarder.reset();
+  BOOST_CHECK_EQUAL(entry->getName(), Name("/pool-lifetime"));
+  entry.reset();
+}
+
+BOOST_AUTO_TEST_CASE(TimerWheelTick)
+{
+  nfd::Forwarder forwarder(true, time::milliseconds(1));
+
+  // Dead Nonce List arms its timers while the forwarder is being constructed
+  BOOST_CHECK(forwarder.getTimerWheel().isEnabled());
+  BOOST_CHECK_GE(forwarder.getTimerWheel().size(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
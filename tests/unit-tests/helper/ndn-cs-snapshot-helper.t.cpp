@@ -0,0 +1,228 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-cs-snapshot-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "NFD/daemon/fw/forwarder.hpp"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <cstdio>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class CsSnapshotFixture : public CleanupFixture
+{
+public:
+  CsSnapshotFixture()
+    : m_filename("cs-snapshot.t.bin")
+  {
+  }
+
+  ~CsSnapshotFixture()
+  {
+    std::remove(m_filename.c_str());
+  }
+
+  /**
+   * @brief Create consumer and producer nodes and install NDN stack on them
+   */
+  NodeContainer
+  createNodes(const std::string& oldContentStore)
+  {
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    PointToPointHelper p2p;
+    p2p.Install(nodes.Get(0), nodes.Get(1));
+
+    StackHelper ndnHelper;
+    ndnHelper.SetDefaultRoutes(true);
+    if (!oldContentStore.empty()) {
+      ndnHelper.SetOldContentStore(oldContentStore, "MaxSize", "0");
+    }
+    ndnHelper.InstallAll();
+
+    return nodes;
+  }
+
+  /**
+   * @brief Fill content store of the consumer node with 10 Data packets, fresh for 10 seconds
+   */
+  void
+  warmUp(const NodeContainer& nodes)
+  {
+    AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+    consumerHelper.SetPrefix("/prefix");
+    consumerHelper.SetAttribute("Frequency", StringValue("10"));
+    consumerHelper.SetAttribute("MaxSeq", IntegerValue(10));
+    consumerHelper.Install(nodes.Get(0));
+
+    AppHelper producerHelper("ns3::ndn::Producer");
+    producerHelper.SetPrefix("/prefix");
+    producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+    producerHelper.SetAttribute("Freshness", StringValue("10s"));
+    producerHelper.Install(nodes.Get(1));
+
+    Simulator::Stop(Seconds(5.0));
+    Simulator::Run();
+  }
+
+  size_t
+  getCsSize(Ptr<Node> node)
+  {
+    Ptr<ContentStore> cs = node->GetObject<ContentStore>();
+    if (cs != nullptr) {
+      return cs->GetSize();
+    }
+    return node->GetObject<L3Protocol>()->getForwarder()->getCs().size();
+  }
+
+  static Name
+  makeName(uint64_t seqNo)
+  {
+    return Name("/prefix").appendSequenceNumber(seqNo);
+  }
+
+  static bool
+  isCached(Ptr<ContentStore> cs, const Name& name)
+  {
+    return cs->Lookup(make_shared<Interest>(name)) != nullptr;
+  }
+
+  /**
+   * @brief Create Data packet with fake signature, so that it has wire encoding
+   */
+  static shared_ptr<Data>
+  makeData(const Name& name)
+  {
+    auto data = make_shared<Data>(name);
+
+    Signature signature;
+    SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+    signature.setInfo(signatureInfo);
+    signature.setValue(::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+    data->setSignature(signature);
+
+    data->wireEncode();
+    return data;
+  }
+
+protected:
+  std::string m_filename;
+};
+
+BOOST_FIXTURE_TEST_SUITE(HelperNdnCsSnapshotHelper, CsSnapshotFixture)
+
+BOOST_AUTO_TEST_CASE(NfdCsWithPayloads)
+{
+  NodeContainer nodes = createNodes("");
+  warmUp(nodes);
+  size_t nEntries = getCsSize(nodes.Get(0));
+  BOOST_REQUIRE_GT(nEntries, 0);
+
+  CsSnapshotHelper::Save(nodes, m_filename, true);
+  Simulator::Destroy();
+
+  nodes = createNodes("");
+  BOOST_CHECK_EQUAL(getCsSize(nodes.Get(0)), 0);
+
+  BOOST_CHECK_GE(CsSnapshotHelper::Load(m_filename), nEntries);
+  BOOST_CHECK_EQUAL(getCsSize(nodes.Get(0)), nEntries);
+}
+
+BOOST_AUTO_TEST_CASE(OldCsCompact)
+{
+  NodeContainer nodes = createNodes("ns3::ndn::cs::Lru");
+  warmUp(nodes);
+  size_t nEntries = getCsSize(nodes.Get(0));
+  BOOST_REQUIRE_GT(nEntries, 0);
+
+  CsSnapshotHelper::SaveAll(m_filename, Simulator::Now());
+  Simulator::Stop(Seconds(0.1));
+  Simulator::Run();
+  Simulator::Destroy();
+
+  // entries are inserted into whatever content store the node has now
+  nodes = createNodes("");
+  BOOST_CHECK_GE(CsSnapshotHelper::Load(m_filename), nEntries);
+  BOOST_CHECK_EQUAL(getCsSize(nodes.Get(0)), nEntries);
+}
+
+BOOST_AUTO_TEST_CASE(OldCsEvictionOrder)
+{
+  NodeContainer nodes = createNodes("ns3::ndn::cs::Lru");
+  warmUp(nodes);
+  Ptr<ContentStore> cs = nodes.Get(0)->GetObject<ContentStore>();
+  size_t nEntries = cs->GetSize();
+  BOOST_REQUIRE_GT(nEntries, 2);
+
+  // the first chunk becomes the most recently used entry, so the second one is evicted next
+  BOOST_REQUIRE(isCached(cs, makeName(0)));
+
+  CsSnapshotHelper::Save(nodes, m_filename);
+  Simulator::Destroy();
+
+  nodes = createNodes("ns3::ndn::cs::Lru");
+  BOOST_CHECK_GE(CsSnapshotHelper::Load(m_filename), nEntries);
+  cs = nodes.Get(0)->GetObject<ContentStore>();
+  BOOST_REQUIRE_EQUAL(cs->GetSize(), nEntries);
+
+  cs->SetAttribute("MaxSize", UintegerValue(nEntries));
+  BOOST_CHECK(cs->Add(makeData("/other")));
+  BOOST_CHECK_EQUAL(cs->GetSize(), nEntries);
+  BOOST_CHECK(!isCached(cs, makeName(1)));
+  BOOST_CHECK(isCached(cs, makeName(0)));
+  BOOST_CHECK(isCached(cs, makeName(2)));
+}
+
+BOOST_AUTO_TEST_CASE(RemainingFreshness)
+{
+  NodeContainer nodes = createNodes("");
+  warmUp(nodes);
+  size_t nEntries = getCsSize(nodes.Get(0));
+  BOOST_REQUIRE_GT(nEntries, 0);
+
+  CsSnapshotHelper::Save(nodes, m_filename);
+  Simulator::Destroy();
+
+  nodes = createNodes("");
+  BOOST_CHECK_GE(CsSnapshotHelper::Load(m_filename), nEntries);
+
+  // Data was retrieved within the first second and saved at 5s, so 5s to 6s of 10s are left
+  size_t nChecked = 0;
+  nodes.Get(0)->GetObject<L3Protocol>()->getForwarder()->getCs().forEachEntry(
+    [&nChecked] (const nfd::cs::Entry& entry) {
+      BOOST_CHECK_GT(entry.getData().getFreshnessPeriod().count(), 4000);
+      BOOST_CHECK_LE(entry.getData().getFreshnessPeriod().count(), 6000);
+      ++nChecked;
+    });
+  BOOST_CHECK_EQUAL(nChecked, nEntries);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -19,6 +19,8 @@
 
 #include "helper/ndn-fib-helper.hpp"
 #include "model/ndn-net-device-face.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "NFD/daemon/fw/forwarder.hpp"
 
 #include "ns3/node-container.h"
 #include "ns3/point-to-point-net-device.h"
@@ -71,6 +73,45 @@ BOOST_AUTO_TEST_CASE(AddRoute)
  BOOST_CHECK_EQUAL(faceStatus.getNInInterests(), 200);
 }
 
+BOOST_AUTO_TEST_CASE(AddRoutes)
+{
+  NodeContainer nodes;
+  nodes.Create(3);
+
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+  p2p.Install(nodes.Get(0), nodes.Get(2));
+
+  StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  Ptr<L3Protocol> ndn = nodes.Get(0)->GetObject<L3Protocol>();
+  shared_ptr<Face> face1 = ndn->getFaceByNetDevice(nodes.Get(0)->GetDevice(0));
+  shared_ptr<Face> face2 = ndn->getFaceByNetDevice(nodes.Get(0)->GetDevice(1));
+
+  std::vector<FibHelper::Route> routes;
+  routes.push_back(FibHelper::Route("/prefix/1", face1, 1));
+  routes.push_back(FibHelper::Route("/prefix/1", face2, 5));
+  routes.push_back(FibHelper::Route("/prefix/2", face2, 2));
+  routes.push_back(FibHelper::Route("/prefix/2", face2, 3)); // updates cost of existing next hop
+  FibHelper::AddRoutes(nodes.Get(0), routes);
+
+  const nfd::Fib& fib = ndn->getForwarder()->getFib();
+
+  shared_ptr<nfd::fib::Entry> entry1 = fib.findExactMatch("/prefix/1");
+  BOOST_REQUIRE(entry1 != nullptr);
+  BOOST_REQUIRE_EQUAL(entry1->getNextHops().size(), 2);
+  BOOST_CHECK(entry1->getNextHops()[0].getFace() == face1);
+  BOOST_CHECK_EQUAL(entry1->getNextHops()[0].getCost(), 1);
+  BOOST_CHECK(entry1->getNextHops()[1].getFace() == face2);
+  BOOST_CHECK_EQUAL(entry1->getNextHops()[1].getCost(), 5);
+
+  shared_ptr<nfd::fib::Entry> entry2 = fib.findExactMatch("/prefix/2");
+  BOOST_REQUIRE(entry2 != nullptr);
+  BOOST_REQUIRE_EQUAL(entry2->getNextHops().size(), 1);
+  BOOST_CHECK_EQUAL(entry2->getNextHops()[0].getCost(), 3);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -19,6 +19,7 @@
 
 #include "helper/ndn-global-routing-helper.hpp"
 
+#include "helper/ndn-link-control-helper.hpp"
 #include "model/ndn-global-router.hpp"
 #include "model/ndn-l3-protocol.hpp"
 #include "model/ndn-face.hpp"
@@ -35,6 +36,9 @@
 
 #include "../tests-common.hpp"
 
+#include <sys/stat.h>
+#include <iomanip>
+
 namespace ns3 {
 namespace ndn {
 
@@ -134,6 +138,239 @@ BOOST_AUTO_TEST_CASE(CalculateRouteCase2)
   Simulator::Run();
 }
 
+static std::string
+dumpFibs()
+{
+  std::ostringstream os;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    auto ndn = (*node)->GetObject<ndn::L3Protocol>();
+    for (const auto& entry : ndn->getForwarder()->getFib()) {
+      os << (*node)->GetId() << " " << entry.getPrefix();
+      for (const auto& nextHop : entry.getNextHops()) {
+        os << " " << nextHop.getFace()->getId() << ":" << nextHop.getCost();
+      }
+      os << "\n";
+    }
+  }
+  return os.str();
+}
+
+BOOST_AUTO_TEST_CASE(CalculateRoutesParallel)
+{
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(5, 5, p2p);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    ndnGlobalRoutingHelper.AddOrigin("/node" + std::to_string((*node)->GetId()), *node);
+  }
+
+  ndn::GlobalRoutingHelper::SetRouteCalculationThreads(1);
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  std::string sequential = dumpFibs();
+
+  // routes are merged into existing FIB entries, so any difference shows up as extra next hops
+  ndn::GlobalRoutingHelper::SetRouteCalculationThreads(4);
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  BOOST_CHECK_EQUAL(dumpFibs(), sequential);
+
+  // corner to corner of 5x5 grid is 8 hops with the default metric of 1
+  auto ndn = grid.GetNode(0, 0)->GetObject<ndn::L3Protocol>();
+  Name prefix("/node" + std::to_string(grid.GetNode(4, 4)->GetId()));
+  auto entry = ndn->getForwarder()->getFib().findExactMatch(prefix);
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 1);
+  BOOST_CHECK_EQUAL(entry->getNextHops()[0].getCost(), 8);
+
+  ndn::GlobalRoutingHelper::SetRouteCalculationThreads(0);
+}
+
+BOOST_AUTO_TEST_CASE(UpdateRoutesAfterLinkFailure)
+{
+  ofstream file1("/tmp/topo3.txt");
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A3  NA  1 1 1\n"
+        << "B3  NA  80  -40 1\n"
+        << "C3  NA  80  40  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A3      B3  10Mbps    100 1ms 100\n"
+        << "A3      C3  10Mbps    50  1ms 100\n"
+        << "B3      C3  10Mbps    1 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName("/tmp/topo3.txt");
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("C3"));
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  auto ndn = Names::Find<Node>("A3")->GetObject<ndn::L3Protocol>();
+  auto checkNextHop = [&ndn](const std::string& neighbor, uint64_t cost) {
+    auto entry = ndn->getForwarder()->getFib().findExactMatch("/prefix");
+    BOOST_REQUIRE(entry != nullptr);
+    BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 1);
+    auto face = dynamic_pointer_cast<ndn::NetDeviceFace>(entry->getNextHops()[0].getFace());
+    BOOST_REQUIRE(face != nullptr);
+    Ptr<Channel> channel = face->GetNetDevice()->GetChannel();
+    Ptr<NetDevice> otherSide = channel->GetDevice(channel->GetDevice(0) == face->GetNetDevice());
+    BOOST_CHECK_EQUAL(Names::FindName(otherSide->GetNode()), neighbor);
+    BOOST_CHECK_EQUAL(entry->getNextHops()[0].getCost(), cost);
+  };
+
+  checkNextHop("C3", 50);
+
+  ndn::LinkControlHelper::SetUpdateGlobalRoutes(true);
+
+  // stale next hop towards C3 is replaced, not just complemented
+  ndn::LinkControlHelper::FailLinkByName("A3", "C3");
+  checkNextHop("B3", 101);
+
+  ndn::LinkControlHelper::UpLinkByName("A3", "C3");
+  checkNextHop("C3", 50);
+
+  // when origin is cut off, its routes are removed
+  ndn::LinkControlHelper::FailLinkByName("A3", "C3");
+  ndn::LinkControlHelper::FailLinkByName("A3", "B3");
+  BOOST_CHECK(ndn->getForwarder()->getFib().findExactMatch("/prefix") == nullptr);
+
+  ndn::LinkControlHelper::SetUpdateGlobalRoutes(false);
+}
+
+BOOST_AUTO_TEST_CASE(RouteCache)
+{
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(3, 3, p2p);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", grid.GetNode(2, 2));
+
+  std::string directory = "/tmp/ndnsim-route-cache";
+  mkdir(directory.c_str(), 0755);
+
+  // seed the cache with (wrong) empty routes, to see that they are loaded instead of calculated
+  ndn::GlobalRoutingGraph graph;
+  std::vector<ndn::GlobalRoutingGraph::Source> sources;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    sources.push_back(graph.GetVertex((*node)->GetObject<ndn::GlobalRouter>()));
+  }
+  uint64_t fingerprint = graph.GetFingerprint(sources);
+  std::ostringstream fileName;
+  fileName << directory << "/routes-" << std::hex << std::setw(16) << std::setfill('0')
+           << fingerprint << ".bin";
+  BOOST_REQUIRE(graph.SaveRoutes(fileName.str(),
+                                 std::vector<ndn::GlobalRoutingGraph::RouteList>(9)));
+
+  auto& fib = grid.GetNode(0, 0)->GetObject<ndn::L3Protocol>()->getForwarder()->getFib();
+
+  ndn::GlobalRoutingHelper::SetRouteCacheDirectory(directory);
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  BOOST_CHECK(fib.findExactMatch("/prefix") == nullptr);
+
+  ndn::GlobalRoutingHelper::SetRouteCacheDirectory("");
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  BOOST_CHECK(fib.findExactMatch("/prefix") != nullptr);
+
+  // calculated routes are saved, and a changed topology gets a different file
+  std::remove(fileName.str().c_str());
+  ndn::GlobalRoutingHelper::SetRouteCacheDirectory(directory);
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  std::vector<ndn::GlobalRoutingGraph::RouteList> routes;
+  BOOST_REQUIRE(graph.LoadRoutes(fileName.str(), routes));
+  BOOST_REQUIRE_EQUAL(routes.size(), 9);
+  BOOST_CHECK_EQUAL(routes[0].size(), 1);
+  BOOST_CHECK_EQUAL(routes[0][0].distance, 4);
+
+  ndnGlobalRoutingHelper.AddOrigins("/other", grid.GetNode(1, 1));
+  BOOST_CHECK(ndn::GlobalRoutingGraph().GetFingerprint(sources) != fingerprint);
+
+  ndn::GlobalRoutingHelper::SetRouteCacheDirectory("");
+  std::remove(fileName.str().c_str());
+}
+
+static void
+readTriangleTopology(const std::string& suffix)
+{
+  ofstream file1("/tmp/topo4.txt");
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A" << suffix << "  NA  1 1 1\n"
+        << "B" << suffix << "  NA  80  -40 1\n"
+        << "C" << suffix << "  NA  80  40  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A" << suffix << "  B" << suffix << "  10Mbps  100  1ms  100\n"
+        << "A" << suffix << "  C" << suffix << "  10Mbps  50  1ms  100\n"
+        << "B" << suffix << "  C" << suffix << "  10Mbps  1  1ms  100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName("/tmp/topo4.txt");
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("C" + suffix));
+}
+
+BOOST_AUTO_TEST_CASE(CalculateMultipathRoutes)
+{
+  readTriangleTopology("4");
+  ndn::GlobalRoutingHelper::CalculateMultipathRoutes(0);
+
+  // both neighbors of A4 are loop-free alternates towards C4
+  auto ndn = Names::Find<Node>("A4")->GetObject<ndn::L3Protocol>();
+  auto entry = ndn->getForwarder()->getFib().findExactMatch("/prefix");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 2);
+  BOOST_CHECK_EQUAL(entry->getNextHops()[0].getCost(), 50);
+  BOOST_CHECK_EQUAL(entry->getNextHops()[1].getCost(), 101);
+
+  // for B4, path through A4 (150) is also loop-free, as shortest path of A4 goes directly to C4
+  ndn = Names::Find<Node>("B4")->GetObject<ndn::L3Protocol>();
+  entry = ndn->getForwarder()->getFib().findExactMatch("/prefix");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 2);
+  BOOST_CHECK_EQUAL(entry->getNextHops()[0].getCost(), 1);
+  BOOST_CHECK_EQUAL(entry->getNextHops()[1].getCost(), 150);
+}
+
+BOOST_AUTO_TEST_CASE(CalculateMultipathRoutesLimits)
+{
+  readTriangleTopology("5");
+  ndn::GlobalRoutingHelper::CalculateMultipathRoutes(2, 1);
+
+  auto ndn = Names::Find<Node>("A5")->GetObject<ndn::L3Protocol>();
+  auto entry = ndn->getForwarder()->getFib().findExactMatch("/prefix");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 1);
+  BOOST_CHECK_EQUAL(entry->getNextHops()[0].getCost(), 50);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
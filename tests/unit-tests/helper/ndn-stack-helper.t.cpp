@@ -0,0 +1,59 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-stack-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "NFD/daemon/fw/forwarder.hpp"
+
+#include "ns3/node-container.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(HelperNdnStackHelper, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(TimerWheelTick)
+{
+  NodeContainer nodes;
+  nodes.Create(2);
+
+  StackHelper ndnHelper;
+  ndnHelper.Install(nodes.Get(0));
+  ndnHelper.setTimerWheelTick(MilliSeconds(1));
+  ndnHelper.Install(nodes.Get(1));
+
+  shared_ptr<nfd::Forwarder> forwarder0 = nodes.Get(0)->GetObject<L3Protocol>()->getForwarder();
+  BOOST_CHECK(!forwarder0->getTimerWheel().isEnabled());
+  BOOST_CHECK_EQUAL(forwarder0->getTimerWheel().size(), 0);
+
+  // the tick is in effect before the tables schedule their first timers
+  shared_ptr<nfd::Forwarder> forwarder1 = nodes.Get(1)->GetObject<L3Protocol>()->getForwarder();
+  nfd::TimerWheel& wheel = forwarder1->getTimerWheel();
+  BOOST_CHECK_EQUAL(wheel.getTickInterval().count(), MilliSeconds(1).GetNanoSeconds());
+  BOOST_CHECK_GE(wheel.size(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
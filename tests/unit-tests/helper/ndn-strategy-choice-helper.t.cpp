@@ -130,6 +130,59 @@ BOOST_AUTO_TEST_CASE(GridScenario)
   BOOST_CHECK_EQUAL(IntermediateNode2Face2Status.getNInInterests(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(ForwardingOnlyNodes)
+{
+  NodeContainer nodes;
+  nodes.Create(3);
+
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+  p2p.Install(nodes.Get(1), nodes.Get(2));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.setForwardingOnly(true);
+  ndnHelper.InstallAll();
+
+  Ptr<L3Protocol> router = nodes.Get(1)->GetObject<L3Protocol>();
+  BOOST_CHECK(router->isForwardingOnly());
+  BOOST_CHECK(router->getFibManager() == nullptr);
+  BOOST_CHECK(router->getStrategyChoiceManager() == nullptr);
+
+  nfd::StrategyChoice& strategyChoice = router->getForwarder()->getStrategyChoice();
+  BOOST_CHECK(strategyChoice.hasStrategy("/localhost/nfd/strategy/broadcast"));
+  BOOST_CHECK(!strategyChoice.hasStrategy("/localhost/nfd/strategy/ncc"));
+
+  // strategy is created when it is chosen for the first time
+  StrategyChoiceHelper::Install(nodes.Get(1), "/prefix", "/localhost/nfd/strategy/ncc");
+  BOOST_CHECK(strategyChoice.hasStrategy("/localhost/nfd/strategy/ncc"));
+  BOOST_CHECK_EQUAL(strategyChoice.findEffectiveStrategy("/prefix/1").getName(),
+                    Name("/localhost/nfd/strategy/ncc/%FD%01"));
+
+  AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", StringValue("100"));
+  consumerHelper.Install(nodes.Get(0));
+
+  AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.Install(nodes.Get(2));
+
+  // routes are installed directly into FIBs
+  FibHelper::AddRoute(nodes.Get(0), "/prefix", nodes.Get(1), 1);
+  FibHelper::AddRoute(nodes.Get(1), "/prefix", nodes.Get(2), 1);
+  BOOST_CHECK(router->getForwarder()->getFib().findExactMatch("/prefix") != nullptr);
+
+  Simulator::Stop(Seconds(5.0));
+  Simulator::Run();
+
+  shared_ptr<Face> producerFace = nodes.Get(2)->GetObject<L3Protocol>()->getFaceByNetDevice(
+    nodes.Get(2)->GetDevice(0));
+  BOOST_CHECK_EQUAL(producerFace->getFaceStatus().getNInInterests(), 500);
+
+  FibHelper::RemoveRoute(nodes.Get(1), "/prefix", nodes.Get(2));
+  BOOST_CHECK(router->getForwarder()->getFib().findExactMatch("/prefix") == nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
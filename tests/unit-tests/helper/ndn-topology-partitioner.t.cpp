@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-topology-partitioner.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(HelperNdnTopologyPartitioner, CleanupFixture)
+
+// ring of nGroups groups, each a ring of groupSize vertices; groups are linked through vertex 0
+static TopologyPartitioner
+createRingOfRings(uint32_t nGroups, uint32_t groupSize)
+{
+  TopologyPartitioner partitioner;
+  for (uint32_t group = 0; group < nGroups; ++group) {
+    for (uint32_t i = 0; i < groupSize; ++i) {
+      partitioner.AddVertex(1.0, group);
+    }
+  }
+  for (uint32_t group = 0; group < nGroups; ++group) {
+    for (uint32_t i = 0; i < groupSize; ++i) {
+      partitioner.AddEdge(group * groupSize + i, group * groupSize + (i + 1) % groupSize);
+    }
+    partitioner.AddEdge(group * groupSize, ((group + 1) % nGroups) * groupSize);
+  }
+  return partitioner;
+}
+
+BOOST_AUTO_TEST_CASE(SingleSystem)
+{
+  TopologyPartitioner partitioner = createRingOfRings(3, 4);
+
+  std::vector<uint32_t> systems = partitioner.Partition(1);
+  BOOST_CHECK(systems == std::vector<uint32_t>(12, 0));
+  BOOST_CHECK_EQUAL(partitioner.GetCutWeight(systems), 0);
+}
+
+BOOST_AUTO_TEST_CASE(WholeGroups)
+{
+  TopologyPartitioner partitioner = createRingOfRings(4, 5);
+
+  std::vector<uint32_t> systems = partitioner.Partition(2);
+  BOOST_REQUIRE_EQUAL(systems.size(), 20);
+  for (uint32_t group = 0; group < 4; ++group) {
+    for (uint32_t i = 1; i < 5; ++i) {
+      BOOST_CHECK_EQUAL(systems[group * 5 + i], systems[group * 5]);
+    }
+  }
+
+  std::vector<double> loads = partitioner.GetLoads(systems, 2);
+  BOOST_CHECK_EQUAL(loads[0], 10);
+  BOOST_CHECK_EQUAL(loads[1], 10);
+  // two adjacent groups per system
+  BOOST_CHECK_EQUAL(partitioner.GetCutWeight(systems), 2);
+
+  BOOST_CHECK(partitioner.Partition(2) == systems);
+}
+
+BOOST_AUTO_TEST_CASE(HeavyGroup)
+{
+  // path of 24 vertices: group 0 (e.g., AS with many clients) is as heavy as groups 1-3 together
+  TopologyPartitioner partitioner;
+  for (uint32_t i = 0; i < 24; ++i) {
+    partitioner.AddVertex(1.0, i < 12 ? 0 : 1 + (i - 12) / 4);
+  }
+  for (uint32_t i = 0; i + 1 < 24; ++i) {
+    partitioner.AddEdge(i, i + 1);
+  }
+
+  std::vector<uint32_t> systems = partitioner.Partition(2);
+  std::vector<double> loads = partitioner.GetLoads(systems, 2);
+  BOOST_CHECK_EQUAL(loads[0], 12);
+  BOOST_CHECK_EQUAL(loads[1], 12);
+  BOOST_CHECK_EQUAL(partitioner.GetCutWeight(systems), 1);
+
+  // group 0 does not fit on any of 3 systems and is split, other groups are kept whole
+  systems = partitioner.Partition(3);
+  loads = partitioner.GetLoads(systems, 3);
+  for (double load : loads) {
+    BOOST_CHECK_EQUAL(load, 8);
+  }
+  BOOST_CHECK_NE(systems[0], systems[11]);
+  for (uint32_t i = 12; i < 24; ++i) {
+    BOOST_CHECK_EQUAL(systems[i], systems[12 + (i - 12) / 4 * 4]);
+  }
+  BOOST_CHECK_LE(partitioner.GetCutWeight(systems), 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
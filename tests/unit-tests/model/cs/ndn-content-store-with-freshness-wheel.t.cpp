@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/cs/ndn-content-store.hpp"
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class FreshnessWheelFixture : public CleanupFixture
+{
+public:
+  /**
+   * @brief Create content store with a wheel of @p nSlots ticks of @p granularity
+   */
+  void
+  createCs(uint32_t maxSize, const Time& granularity, uint32_t nSlots)
+  {
+    ObjectFactory factory("ns3::ndn::cs::FreshnessWheel::Lru");
+    factory.Set("MaxSize", UintegerValue(maxSize));
+    factory.Set("Granularity", TimeValue(granularity));
+    factory.Set("Slots", UintegerValue(nSlots));
+    m_cs = factory.Create<ContentStore>();
+  }
+
+  /**
+   * @brief Create Data packet with fake signature, so that it has wire encoding
+   */
+  static shared_ptr<Data>
+  makeData(const Name& name, uint32_t freshnessMs)
+  {
+    auto data = make_shared<Data>(name);
+    data->setFreshnessPeriod(time::milliseconds(freshnessMs));
+
+    Signature signature;
+    SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+    signature.setInfo(signatureInfo);
+    signature.setValue(::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+    data->setSignature(signature);
+
+    data->wireEncode();
+    return data;
+  }
+
+  void
+  add(Name name, uint32_t freshnessMs, bool isAdded)
+  {
+    BOOST_CHECK_EQUAL(m_cs->Add(makeData(name, freshnessMs)), isAdded);
+  }
+
+  /**
+   * @brief Check number of cached entries, as left by the periodic sweep
+   */
+  void
+  checkSize(uint32_t size)
+  {
+    BOOST_TEST_MESSAGE("At " << Simulator::Now().GetMilliSeconds() << "ms");
+    BOOST_CHECK_EQUAL(m_cs->GetSize(), size);
+  }
+
+  void
+  checkCached(Name name, bool isCached)
+  {
+    BOOST_TEST_MESSAGE("At " << Simulator::Now().GetMilliSeconds() << "ms");
+    BOOST_CHECK_EQUAL(m_cs->Lookup(make_shared<Interest>(name)) != nullptr, isCached);
+  }
+
+  void
+  run(uint32_t ms)
+  {
+    Simulator::Stop(MilliSeconds(ms));
+    Simulator::Run();
+  }
+
+protected:
+  Ptr<ContentStore> m_cs;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelCsContentStoreWithFreshnessWheel, FreshnessWheelFixture)
+
+BOOST_AUTO_TEST_CASE(WrapAround)
+{
+  // one revolution of the wheel is 40ms
+  createCs(100, MilliSeconds(10), 4);
+
+  add("/short", 15, true);
+  add("/long", 100, true); // placed in the slot of tick 10, visited at ticks 2 and 6 first
+
+  Simulator::Schedule(MilliSeconds(35), &FreshnessWheelFixture::checkSize, this, 1);
+  Simulator::Schedule(MilliSeconds(35), &FreshnessWheelFixture::checkCached, this, Name("/long"),
+                      true);
+  Simulator::Schedule(MilliSeconds(75), &FreshnessWheelFixture::checkSize, this, 1);
+  Simulator::Schedule(MilliSeconds(95), &FreshnessWheelFixture::checkSize, this, 1);
+  Simulator::Schedule(MilliSeconds(115), &FreshnessWheelFixture::checkSize, this, 0);
+  run(200);
+}
+
+BOOST_AUTO_TEST_CASE(Reinsert)
+{
+  createCs(100, MilliSeconds(10), 4);
+
+  add("/A", 30, true);
+  // a duplicate is not added and does not extend freshness of the cached entry
+  Simulator::Schedule(MilliSeconds(20), &FreshnessWheelFixture::add, this, Name("/A"), 30, false);
+  Simulator::Schedule(MilliSeconds(45), &FreshnessWheelFixture::checkSize, this, 0);
+
+  // once expired, the name is added again and expires in the next revolution
+  Simulator::Schedule(MilliSeconds(55), &FreshnessWheelFixture::add, this, Name("/A"), 30, true);
+  Simulator::Schedule(MilliSeconds(80), &FreshnessWheelFixture::checkSize, this, 1);
+  Simulator::Schedule(MilliSeconds(100), &FreshnessWheelFixture::checkSize, this, 0);
+  run(200);
+}
+
+BOOST_AUTO_TEST_CASE(EraseBeforeExpiry)
+{
+  createCs(1, MilliSeconds(10), 4);
+
+  // /A is evicted by LRU before it expires, its slot must no longer reference it
+  add("/A", 30, true);
+  add("/B", 60, true);
+  Simulator::Schedule(MilliSeconds(45), &FreshnessWheelFixture::checkSize, this, 1);
+  Simulator::Schedule(MilliSeconds(45), &FreshnessWheelFixture::checkCached, this, Name("/A"),
+                      false);
+  Simulator::Schedule(MilliSeconds(45), &FreshnessWheelFixture::checkCached, this, Name("/B"),
+                      true);
+  Simulator::Schedule(MilliSeconds(75), &FreshnessWheelFixture::checkSize, this, 0);
+  run(200);
+}
+
+BOOST_AUTO_TEST_CASE(StaleBeforeSweep)
+{
+  createCs(100, MilliSeconds(100), 4);
+
+  // the sweep runs only at 100ms, but a stale entry is never returned
+  add("/A", 10, true);
+  Simulator::Schedule(MilliSeconds(50), &FreshnessWheelFixture::checkSize, this, 1);
+  Simulator::Schedule(MilliSeconds(60), &FreshnessWheelFixture::checkCached, this, Name("/A"),
+                      false);
+  Simulator::Schedule(MilliSeconds(70), &FreshnessWheelFixture::checkSize, this, 0);
+  run(200);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/cs/ndn-content-store.hpp"
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <set>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class SegmentsFixture : public CleanupFixture
+{
+public:
+  static Ptr<ContentStore>
+  createCs(uint32_t maxSize, uint64_t maxBytes = 0)
+  {
+    ObjectFactory factory("ns3::ndn::cs::Segments::Lru");
+    factory.Set("MaxSize", UintegerValue(maxSize));
+    factory.Set("MaxBytes", UintegerValue(maxBytes));
+    return factory.Create<ContentStore>();
+  }
+
+  /**
+   * @brief Create Data packet with fake signature, so that it has wire encoding
+   */
+  static shared_ptr<Data>
+  makeData(const Name& name, size_t payloadSize = 100)
+  {
+    auto data = make_shared<Data>(name);
+    data->setContent(make_shared< ::ndn::Buffer>(payloadSize));
+
+    Signature signature;
+    SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+    signature.setInfo(signatureInfo);
+    signature.setValue(::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+    data->setSignature(signature);
+
+    data->wireEncode();
+    return data;
+  }
+
+  static Name
+  chunkName(const Name& prefix, uint64_t seqNo)
+  {
+    return Name(prefix).appendSequenceNumber(seqNo);
+  }
+
+  /**
+   * @brief Add chunks [0, nChunks) of object @p prefix
+   */
+  static void
+  addObject(Ptr<ContentStore> cs, const Name& prefix, uint64_t nChunks)
+  {
+    for (uint64_t seqNo = 0; seqNo < nChunks; ++seqNo) {
+      BOOST_CHECK(cs->Add(makeData(chunkName(prefix, seqNo))));
+    }
+  }
+
+  static shared_ptr<Data>
+  lookup(Ptr<ContentStore> cs, const Name& name)
+  {
+    return cs->Lookup(make_shared<Interest>(name));
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelCsContentStoreWithSegments, SegmentsFixture)
+
+BOOST_AUTO_TEST_CASE(LookupChunk)
+{
+  Ptr<ContentStore> cs = createCs(100);
+  addObject(cs, "/video/1", 5);
+  BOOST_CHECK(!cs->Add(makeData(chunkName("/video/1", 2)))); // duplicate
+  BOOST_CHECK_EQUAL(cs->GetSize(), 5);
+
+  shared_ptr<Data> data = lookup(cs, chunkName("/video/1", 3));
+  BOOST_REQUIRE(data != nullptr);
+  BOOST_CHECK_EQUAL(data->getName(), chunkName("/video/1", 3));
+  BOOST_CHECK_EQUAL(data->getContent().value_size(), 100);
+
+  BOOST_CHECK(lookup(cs, chunkName("/video/1", 5)) == nullptr);
+  BOOST_CHECK(lookup(cs, chunkName("/video/2", 0)) == nullptr);
+
+  // prefix Interest is satisfied by the lowest chunk
+  data = lookup(cs, "/video/1");
+  BOOST_REQUIRE(data != nullptr);
+  BOOST_CHECK_EQUAL(data->getName(), chunkName("/video/1", 0));
+}
+
+BOOST_AUTO_TEST_CASE(IterateChunks)
+{
+  Ptr<ContentStore> cs = createCs(100);
+  addObject(cs, "/video/1", 3);
+  addObject(cs, "/video/2", 2);
+  BOOST_CHECK(cs->Add(makeData("/video/2")));
+  BOOST_CHECK(cs->Add(makeData("/manifest")));
+  BOOST_CHECK_EQUAL(cs->GetSize(), 7);
+
+  std::set<Name> names;
+  for (Ptr<cs::Entry> entry = cs->Begin(); entry != cs->End(); entry = cs->Next(entry)) {
+    BOOST_CHECK_EQUAL(entry->GetName(), entry->GetData()->getName());
+    names.insert(entry->GetName());
+  }
+
+  std::set<Name> expected = {chunkName("/video/1", 0), chunkName("/video/1", 1),
+                             chunkName("/video/1", 2), chunkName("/video/2", 0),
+                             chunkName("/video/2", 1), "/video/2", "/manifest"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(names.begin(), names.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(EvictWholeObject)
+{
+  Ptr<ContentStore> cs = createCs(5);
+  addObject(cs, "/video/1", 3);
+  addObject(cs, "/video/2", 3);
+
+  // all chunks of the least recently used object are evicted at once
+  BOOST_CHECK_EQUAL(cs->GetSize(), 3);
+  BOOST_CHECK(lookup(cs, chunkName("/video/1", 0)) == nullptr);
+  BOOST_CHECK(lookup(cs, chunkName("/video/2", 0)) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(ByteBudget)
+{
+  Ptr<ContentStore> cs = createCs(0);
+  addObject(cs, "/video/1", 4);
+
+  uint64_t oneObject = cs->GetBytesInUse();
+  BOOST_CHECK_GT(oneObject, 4 * makeData(chunkName("/video/1", 0))->wireEncode().size());
+
+  // budget fits one object, so adding chunks of another one evicts the first object
+  cs = createCs(0, oneObject * 3 / 2);
+  addObject(cs, "/video/1", 4);
+  BOOST_CHECK_EQUAL(cs->GetBytesInUse(), oneObject);
+
+  addObject(cs, "/video/2", 4);
+  BOOST_CHECK_LE(cs->GetBytesInUse(), oneObject * 3 / 2);
+  BOOST_CHECK_EQUAL(cs->GetSize(), 4);
+  BOOST_CHECK(lookup(cs, chunkName("/video/1", 0)) == nullptr);
+  BOOST_CHECK(lookup(cs, chunkName("/video/2", 3)) != nullptr);
+
+  // a packet larger than the budget is not cached
+  BOOST_CHECK(!cs->Add(makeData("/large", oneObject * 2)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/cs/ndn-content-store.hpp"
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class TinyLfuFixture : public CleanupFixture
+{
+public:
+  void
+  createCs(uint32_t maxSize, uint32_t sampleFactor)
+  {
+    ObjectFactory factory("ns3::ndn::cs::TinyLfu::Lru");
+    factory.Set("MaxSize", UintegerValue(maxSize));
+    factory.Set("SampleFactor", UintegerValue(sampleFactor));
+    m_cs = factory.Create<ContentStore>();
+  }
+
+  /**
+   * @brief Create Data packet with fake signature, so that it has wire encoding
+   */
+  static shared_ptr<Data>
+  makeData(const Name& name)
+  {
+    auto data = make_shared<Data>(name);
+    data->setContent(make_shared< ::ndn::Buffer>(100));
+
+    Signature signature;
+    SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+    signature.setInfo(signatureInfo);
+    signature.setValue(::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+    data->setSignature(signature);
+
+    data->wireEncode();
+    return data;
+  }
+
+  bool
+  add(const Name& name)
+  {
+    return m_cs->Add(makeData(name));
+  }
+
+  bool
+  isCached(const Name& name)
+  {
+    // a cache hit is recorded in the sketch as well
+    return m_cs->Lookup(make_shared<Interest>(name)) != nullptr;
+  }
+
+protected:
+  Ptr<ContentStore> m_cs;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelCsContentStoreWithTinyLfu, TinyLfuFixture)
+
+BOOST_AUTO_TEST_CASE(Admission)
+{
+  createCs(2, 10);
+
+  // items are admitted without comparison while the cache is not full
+  BOOST_CHECK(add("/A"));
+  BOOST_CHECK(add("/B"));
+
+  // /C has been requested as often as LRU victim /A, so it is rejected
+  BOOST_CHECK(!add("/C"));
+  BOOST_CHECK_EQUAL(m_cs->GetSize(), 2);
+  BOOST_CHECK(!isCached("/C"));
+
+  // the second request makes /C more popular than /A, which is then evicted
+  BOOST_CHECK(add("/C"));
+  BOOST_CHECK_EQUAL(m_cs->GetSize(), 2);
+  BOOST_CHECK(!isCached("/A"));
+  BOOST_CHECK(isCached("/B"));
+  BOOST_CHECK(isCached("/C"));
+}
+
+BOOST_AUTO_TEST_CASE(Halving)
+{
+  // counters are halved after every 8 recorded accesses
+  createCs(1, 8);
+
+  BOOST_CHECK(add("/A"));
+  for (int i = 0; i < 6; ++i) {
+    BOOST_CHECK(isCached("/A"));
+  }
+
+  // 8th access: /A is counted 7 times and /B once before halving, 3 and 0 after it
+  BOOST_CHECK(!add("/B"));
+
+  // without halving, /B would need 8 attempts to outnumber /A; with another halving at the
+  // 4th retry (/A 3 -> 1, /B 4 -> 2), the 4th retry is admitted
+  BOOST_CHECK(!add("/B"));
+  BOOST_CHECK(!add("/B"));
+  BOOST_CHECK(!add("/B"));
+  BOOST_CHECK(add("/B"));
+
+  BOOST_CHECK(!isCached("/A"));
+  BOOST_CHECK(isCached("/B"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,268 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "NFD/daemon/table/cs.hpp"
+#include "NFD/daemon/table/cs-indexed.hpp"
+
+#include "ns3/ndnSIM-module.h"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class IndexedCsFixture : public CleanupFixture
+{
+public:
+  /**
+   * @brief Create Data packet with fake signature, so that it has wire encoding and full name
+   */
+  static shared_ptr<Data>
+  makeData(const Name& name, uint8_t contentByte = 0,
+           const ::ndn::time::milliseconds& freshnessPeriod = ::ndn::time::seconds(3600))
+  {
+    auto data = make_shared<Data>(name);
+    data->setFreshnessPeriod(freshnessPeriod);
+    data->setContent(&contentByte, 1);
+
+    Signature signature;
+    SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+    signature.setInfo(signatureInfo);
+    signature.setValue(::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+    data->setSignature(signature);
+
+    data->wireEncode();
+    return data;
+  }
+
+  /**
+   * @brief Insert the same Data into both engines
+   */
+  void
+  insert(const Name& name, uint8_t contentByte = 0)
+  {
+    shared_ptr<Data> data = makeData(name, contentByte);
+    m_data.push_back(data);
+    m_skipList.insert(*data);
+    m_indexed.insert(*data);
+  }
+
+  /**
+   * @brief Check that both engines return the same Data for @p interest
+   */
+  void
+  checkSameMatch(const Interest& interest)
+  {
+    const Data* expected = m_skipList.find(interest);
+    const Data* actual = m_indexed.find(interest);
+
+    BOOST_TEST_MESSAGE("Interest " << interest);
+    if (expected == nullptr) {
+      BOOST_CHECK(actual == nullptr);
+    }
+    else {
+      BOOST_REQUIRE(actual != nullptr);
+      BOOST_CHECK_EQUAL(actual->getFullName(), expected->getFullName());
+    }
+  }
+
+  /**
+   * @brief Get names of cached Data, in the order in which @p cs would evict them
+   */
+  static std::vector<Name>
+  getEvictionOrder(const nfd::IndexedCs& cs)
+  {
+    std::vector<Name> names;
+    cs.forEachEntryInEvictionOrder([&names] (const nfd::cs::Entry& entry) {
+        names.push_back(entry.getName());
+      });
+    return names;
+  }
+
+  static void
+  checkEvictionOrder(const nfd::IndexedCs& cs, const std::vector<Name>& expected)
+  {
+    std::vector<Name> actual = getEvictionOrder(cs);
+    BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+  }
+
+protected:
+  std::vector<shared_ptr<Data>> m_data;
+  nfd::SkipListCs m_skipList{100};
+  nfd::IndexedCs m_indexed{100, nfd::IndexedCs::POLICY_LRU};
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelCsIndexedCs, IndexedCsFixture)
+
+BOOST_AUTO_TEST_CASE(SameMatchAsSkipList)
+{
+  // a name component that has the length of an implicit digest
+  uint8_t longValue[32] = {0};
+  Name longChild = Name("/A").append(longValue, sizeof(longValue));
+
+  // /A has an exact-name Data, and children sorting before and after its implicit digest
+  insert("/A", 1);
+  insert("/A", 2);
+  insert("/A/B", 3);
+  insert("/A/B/C", 4);
+  insert("/A/BB", 5);
+  insert(longChild, 6);
+  insert(Name(longChild).append("D"), 7);
+  insert("/Z", 8);
+
+  std::vector<Name> names = {"/", "/A", "/A/B", "/A/B/C", "/A/C", "/Z", longChild,
+                             m_data[0]->getFullName(), m_data[2]->getFullName()};
+
+  for (const Name& name : names) {
+    for (int childSelector = 0; childSelector <= 1; ++childSelector) {
+      for (int maxSuffix = -1; maxSuffix <= 3; ++maxSuffix) {
+        for (int minSuffix = -1; minSuffix <= 2; ++minSuffix) {
+          Interest interest(name);
+          interest.setChildSelector(childSelector);
+          if (maxSuffix >= 0) {
+            interest.setMaxSuffixComponents(maxSuffix);
+          }
+          if (minSuffix >= 0) {
+            interest.setMinSuffixComponents(minSuffix);
+          }
+          checkSameMatch(interest);
+        }
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ExactNameWithChildren)
+{
+  insert("/A", 1);
+  insert("/A/B", 2);
+
+  // /A/B sorts before /A/<implicit digest>, so it is the leftmost match
+  const Data* match = m_indexed.find(Interest("/A"));
+  BOOST_REQUIRE(match != nullptr);
+  BOOST_CHECK_EQUAL(match->getName(), Name("/A/B"));
+
+  // with MaxSuffixComponents=1, only the Data named /A can match
+  Interest exactInterest("/A");
+  exactInterest.setMaxSuffixComponents(1);
+  match = m_indexed.find(exactInterest);
+  BOOST_REQUIRE(match != nullptr);
+  BOOST_CHECK_EQUAL(match->getName(), Name("/A"));
+}
+
+BOOST_AUTO_TEST_CASE(DuplicateWithinByteLimit)
+{
+  insert("/A");
+  insert("/B");
+
+  // both entries fit exactly in the byte limit
+  size_t nBytes = m_skipList.getBytesInUse();
+  BOOST_CHECK_EQUAL(m_indexed.getBytesInUse(), nBytes);
+  m_skipList.setByteLimit(nBytes);
+  m_indexed.setByteLimit(nBytes);
+
+  // re-inserting a cached packet needs no room and must not evict /B
+  insert("/A");
+  BOOST_CHECK_EQUAL(m_skipList.size(), 2);
+  BOOST_CHECK_EQUAL(m_indexed.size(), 2);
+  BOOST_CHECK_EQUAL(m_skipList.getBytesInUse(), nBytes);
+  checkSameMatch(Interest("/B"));
+  BOOST_CHECK(m_skipList.find(Interest("/B")) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(EvictLru)
+{
+  nfd::IndexedCs cs(3, nfd::IndexedCs::POLICY_LRU);
+  cs.insert(*makeData("/A"));
+  cs.insert(*makeData("/B"));
+  cs.insert(*makeData("/C"));
+  checkEvictionOrder(cs, {"/A", "/B", "/C"});
+
+  // a cache hit makes the entry most recently used
+  BOOST_CHECK(cs.find(Interest("/A")) != nullptr);
+  checkEvictionOrder(cs, {"/B", "/C", "/A"});
+
+  cs.insert(*makeData("/D"));
+  checkEvictionOrder(cs, {"/C", "/A", "/D"});
+
+  // so does inserting the same packet again
+  cs.insert(*makeData("/C"));
+  checkEvictionOrder(cs, {"/A", "/D", "/C"});
+
+  cs.insert(*makeData("/E"));
+  checkEvictionOrder(cs, {"/D", "/C", "/E"});
+  BOOST_CHECK(cs.find(Interest("/A")) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(EvictFifo)
+{
+  nfd::IndexedCs cs(3, nfd::IndexedCs::POLICY_FIFO);
+  cs.insert(*makeData("/A"));
+  cs.insert(*makeData("/B"));
+  cs.insert(*makeData("/C"));
+
+  // neither cache hits nor duplicate insertions change the order
+  BOOST_CHECK(cs.find(Interest("/A")) != nullptr);
+  checkEvictionOrder(cs, {"/A", "/B", "/C"});
+
+  cs.insert(*makeData("/D"));
+  checkEvictionOrder(cs, {"/B", "/C", "/D"});
+
+  cs.insert(*makeData("/B"));
+  checkEvictionOrder(cs, {"/B", "/C", "/D"});
+
+  cs.insert(*makeData("/E"));
+  checkEvictionOrder(cs, {"/C", "/D", "/E"});
+  BOOST_CHECK(cs.find(Interest("/B")) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(EvictPriorityFifo)
+{
+  // staleness is measured on ndn-cxx clocks, which StackHelper ties to simulation time
+  StackHelper stackHelper;
+
+  nfd::IndexedCs cs(3, nfd::IndexedCs::POLICY_PRIORITY_FIFO);
+  cs.insert(*makeData("/A"));
+  cs.insert(*makeData("/S", 0, ::ndn::time::seconds(1)));
+  cs.insert(*makeData("/U"), true);
+  checkEvictionOrder(cs, {"/U", "/A", "/S"});
+
+  // unsolicited Data goes first
+  cs.insert(*makeData("/B"));
+  checkEvictionOrder(cs, {"/A", "/S", "/B"});
+  BOOST_CHECK(cs.find(Interest("/U")) == nullptr);
+
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+
+  // stale Data goes before the earliest inserted entry
+  cs.insert(*makeData("/C"));
+  checkEvictionOrder(cs, {"/A", "/B", "/C"});
+  BOOST_CHECK(cs.find(Interest("/S")) == nullptr);
+
+  // then entries in insertion order; cache hits do not change it
+  BOOST_CHECK(cs.find(Interest("/A")) != nullptr);
+  cs.insert(*makeData("/D"));
+  checkEvictionOrder(cs, {"/B", "/C", "/D"});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/cs/ndn-cache-placement.hpp"
+#include "helper/ndn-stack-helper.hpp"
+
+#include "ns3/uinteger.h"
+#include "ns3/integer.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include <ndn-cxx/data.hpp>
+#include <ndn-cxx/name.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnCachePlacement, CleanupFixture)
+
+static shared_ptr<Data>
+makeData(const Name& name)
+{
+  auto data = make_shared<Data>(name);
+  StackHelper::getKeyChain().sign(*data);
+  return data;
+}
+
+BOOST_AUTO_TEST_CASE(LeaveCopyDown)
+{
+  Ptr<CachePlacement> placement = CreateObject<cs::placement::HopCount>();
+  auto data = makeData("/video/seg=0");
+
+  BOOST_CHECK_EQUAL(placement->ShouldCache(*data, 0), false);
+  BOOST_CHECK_EQUAL(placement->ShouldCache(*data, 1), true);
+  BOOST_CHECK_EQUAL(placement->ShouldCache(*data, 2), false);
+
+  placement->SetAttribute("MinHops", UintegerValue(2));
+  placement->SetAttribute("MaxHops", UintegerValue(3));
+  BOOST_CHECK_EQUAL(placement->ShouldCache(*data, 1), false);
+  BOOST_CHECK_EQUAL(placement->ShouldCache(*data, 2), true);
+  BOOST_CHECK_EQUAL(placement->ShouldCache(*data, 3), true);
+  BOOST_CHECK_EQUAL(placement->ShouldCache(*data, 4), false);
+}
+
+BOOST_AUTO_TEST_CASE(NameHashPartitions)
+{
+  const uint32_t nPartitions = 3;
+  std::vector<Ptr<CachePlacement>> placements;
+  for (uint32_t i = 0; i < nPartitions; ++i) {
+    Ptr<CachePlacement> placement = CreateObject<cs::placement::NameHash>();
+    placement->SetAttribute("Partitions", UintegerValue(nPartitions));
+    placement->SetAttribute("Index", IntegerValue(i));
+    placements.push_back(placement);
+  }
+
+  std::vector<size_t> nCached(nPartitions, 0);
+  for (uint64_t segment = 0; segment < 300; ++segment) {
+    auto data = makeData(Name("/video").appendSegment(segment));
+
+    size_t nCaching = 0;
+    for (uint32_t i = 0; i < nPartitions; ++i) {
+      if (placements[i]->ShouldCache(*data, 1)) {
+        ++nCaching;
+        ++nCached[i];
+      }
+    }
+    // every segment is cached by exactly one router of the neighborhood
+    BOOST_CHECK_EQUAL(nCaching, 1);
+  }
+
+  for (uint32_t i = 0; i < nPartitions; ++i) {
+    BOOST_CHECK_GT(nCached[i], 50);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(NameHashTopologyIndex)
+{
+  // star around node 2, where node ID modulo 2 gives the center the partition of node 0
+  NodeContainer nodes;
+  nodes.Create(4);
+
+  PointToPointHelper p2p;
+  std::vector<std::pair<uint32_t, uint32_t>> links = {{2, 0}, {2, 1}, {2, 3}};
+  for (const auto& link : links) {
+    p2p.Install(nodes.Get(link.first), nodes.Get(link.second));
+  }
+
+  std::vector<Ptr<CachePlacement>> placements;
+  for (uint32_t i = 0; i < nodes.GetN(); ++i) {
+    Ptr<CachePlacement> placement = CreateObject<cs::placement::NameHash>();
+    placement->SetAttribute("Partitions", UintegerValue(2));
+    nodes.Get(i)->AggregateObject(placement);
+    placements.push_back(placement);
+  }
+
+  for (uint64_t segment = 0; segment < 100; ++segment) {
+    auto data = makeData(Name("/video").appendSegment(segment));
+
+    // neighbors cache different partitions
+    for (const auto& link : links) {
+      BOOST_CHECK_NE(placements[link.first]->ShouldCache(*data, 1),
+                     placements[link.second]->ShouldCache(*data, 1));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/topology/annotated-topology-reader.hpp"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include "../../tests-common.hpp"
+
+#include <fstream>
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTopologyAnnotatedTopologyReader, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(BinaryTopology)
+{
+  std::ofstream file("/tmp/topo-binary.txt");
+  file << "router\n\n"
+       << "#node city  y x mpi-partition\n"
+       << "A  NA  10 10 0\n"
+       << "B  NA  20 10 0\n"
+       << "C  NA  10 20 0\n\n"
+       << "link\n\n"
+       << "# from  to  capacity  metric  delay queue\n"
+       << "A       B   10Mbps    100     1ms   50\n"
+       << "B       C   1Mbps     200     10ms  ns3::DropTailQueue,MaxPackets=20\n"
+       << "C       A   10Mbps    300\n";
+  file.close();
+
+  struct LinkInfo {
+    std::string from;
+    std::string to;
+    std::map<std::string, std::string> attributes;
+  };
+
+  std::vector<LinkInfo> links;
+  std::vector<Vector> positions;
+  {
+    AnnotatedTopologyReader reader;
+    reader.SetFileName("/tmp/topo-binary.txt");
+    reader.Read();
+
+    for (const auto& link : reader.GetLinks()) {
+      LinkInfo info{link.GetFromNodeName(), link.GetToNodeName(), {}};
+      info.attributes.insert(link.AttributesBegin(), link.AttributesEnd());
+      links.push_back(info);
+    }
+    for (NodeContainer::Iterator node = reader.GetNodes().Begin();
+         node != reader.GetNodes().End(); ++node) {
+      positions.push_back((*node)->GetObject<MobilityModel>()->GetPosition());
+    }
+
+    reader.SaveBinaryTopology("/tmp/topo-binary.bin");
+  }
+
+  Simulator::Destroy();
+  Names::Clear();
+
+  AnnotatedTopologyReader reader;
+  reader.SetFileName("/tmp/topo-binary.bin");
+  NodeContainer nodes = reader.Read();
+
+  BOOST_REQUIRE_EQUAL(nodes.GetN(), 3);
+  BOOST_CHECK_EQUAL(Names::FindName(nodes.Get(0)), "A");
+  BOOST_CHECK_EQUAL(Names::FindName(nodes.Get(2)), "C");
+  for (uint32_t i = 0; i < nodes.GetN(); ++i) {
+    Vector position = nodes.Get(i)->GetObject<MobilityModel>()->GetPosition();
+    BOOST_CHECK_EQUAL(position.x, positions[i].x);
+    BOOST_CHECK_EQUAL(position.y, positions[i].y);
+  }
+
+  BOOST_REQUIRE_EQUAL(reader.GetLinks().size(), links.size());
+  auto expected = links.begin();
+  for (const auto& link : reader.GetLinks()) {
+    BOOST_CHECK_EQUAL(link.GetFromNodeName(), expected->from);
+    BOOST_CHECK_EQUAL(link.GetToNodeName(), expected->to);
+    BOOST_CHECK_EQUAL(link.GetAttribute("OSPF"), expected->attributes["OSPF"]);
+    BOOST_CHECK_EQUAL(DataRate(link.GetAttribute("DataRate")),
+                      DataRate(expected->attributes["DataRate"]));
+
+    std::string value;
+    BOOST_CHECK_EQUAL(link.GetAttributeFailSafe("Delay", value),
+                      expected->attributes.count("Delay") > 0);
+    if (expected->attributes.count("Delay") > 0) {
+      BOOST_CHECK_EQUAL(Time(value), Time(expected->attributes["Delay"]));
+      BOOST_CHECK_EQUAL(link.GetAttribute("MaxPackets"), expected->attributes["MaxPackets"]);
+    }
+    ++expected;
+  }
+
+  // devices are configured as by the text reader
+  auto link = reader.GetLinks().begin();
+  ++link;
+  DataRateValue dataRate;
+  link->GetFromNetDevice()->GetAttribute("DataRate", dataRate);
+  BOOST_CHECK_EQUAL(dataRate.Get(), DataRate("1Mbps"));
+
+  PointerValue queue;
+  link->GetFromNetDevice()->GetAttribute("TxQueue", queue);
+  UintegerValue maxPackets;
+  queue.Get<Queue>()->GetAttribute("MaxPackets", maxPackets);
+  BOOST_CHECK_EQUAL(maxPackets.Get(), 20);
+
+  // unspecified delay keeps the value of the previous link
+  ++link;
+  TimeValue delay;
+  link->GetFromNetDevice()->GetChannel()->GetAttribute("Delay", delay);
+  BOOST_CHECK_EQUAL(delay.Get(), MilliSeconds(10));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
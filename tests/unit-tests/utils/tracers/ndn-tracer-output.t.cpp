@@ -0,0 +1,79 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-tracer-output.hpp"
+
+#include "../../tests-common.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersTracerOutput, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(MergeFiles)
+{
+  std::string file = "/tmp/ndnsim-tracer-output.txt";
+  {
+    std::ofstream os(file + ".0");
+    os << "Time\tNode\tValue\n"
+       << "0.5\t0\ta\n"
+       << "1\t0\tb\n"
+       << "2\t0\tc\n";
+  }
+  {
+    std::ofstream os(file + ".1");
+    os << "Time\tNode\tValue\n"
+       << "0.5\t1\ta\n"
+       << "1.5\t1\tb\n"
+       << "2\t1\tc\n";
+  }
+  {
+    // process without traced nodes
+    std::ofstream os(file + ".2");
+  }
+
+  BOOST_REQUIRE(MergeTracerFiles(file, 3));
+
+  std::ifstream is(file);
+  std::ostringstream merged;
+  merged << is.rdbuf();
+  BOOST_CHECK_EQUAL(merged.str(),
+                    "Time\tNode\tValue\n"
+                    "0.5\t0\ta\n"
+                    "0.5\t1\ta\n"
+                    "1\t0\tb\n"
+                    "1.5\t1\tb\n"
+                    "2\t0\tc\n"
+                    "2\t1\tc\n");
+
+  // files of processes are removed
+  BOOST_CHECK(!std::ifstream(file + ".0").is_open());
+  BOOST_CHECK(!MergeTracerFiles(file, 3));
+
+  std::remove(file.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,191 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/trie/trie-with-policy.hpp"
+#include "utils/trie/lfu-policy.hpp"
+#include "utils/trie/bucket-lfu-policy.hpp"
+
+#include "ns3/simple-ref-count.h"
+
+#include "../../tests-common.hpp"
+
+#include <random>
+
+namespace ns3 {
+namespace ndn {
+
+class BucketLfuFixture : public CleanupFixture
+{
+public:
+  struct Payload : public SimpleRefCount<Payload> {
+    explicit Payload(int id)
+      : id(id)
+    {
+    }
+
+    int id;
+  };
+
+  typedef ndnSIM::trie_with_policy<Name, ndnSIM::smart_pointer_payload_traits<Payload>,
+                                   ndnSIM::lfu_policy_traits> LfuTrie;
+  typedef ndnSIM::trie_with_policy<Name, ndnSIM::smart_pointer_payload_traits<Payload>,
+                                   ndnSIM::bucket_lfu_policy_traits> BucketLfuTrie;
+
+  void
+  setMaxSize(size_t maxSize)
+  {
+    m_lfu.getPolicy().set_max_size(maxSize);
+    m_bucketLfu.getPolicy().set_max_size(maxSize);
+  }
+
+  /**
+   * @brief Insert payload with @p id under name /<id> into both tries
+   */
+  void
+  insert(int id)
+  {
+    Name name = Name("/").appendNumber(id);
+    BOOST_CHECK_EQUAL(m_lfu.insert(name, Create<Payload>(id)).second,
+                      m_bucketLfu.insert(name, Create<Payload>(id)).second);
+  }
+
+  /**
+   * @brief Look up /<id> in both tries, which counts as an access to a cached item
+   */
+  void
+  lookup(int id)
+  {
+    Name name = Name("/").appendNumber(id);
+    BOOST_CHECK_EQUAL(m_lfu.deepest_prefix_match(name) != m_lfu.end(),
+                      m_bucketLfu.deepest_prefix_match(name) != m_bucketLfu.end());
+  }
+
+  /**
+   * @brief Modify payload of /<id> in both tries, which counts as an access as well
+   */
+  void
+  update(int id)
+  {
+    Name name = Name("/").appendNumber(id);
+    auto noop = [] (Payload&) {};
+    BOOST_CHECK_EQUAL(m_lfu.modify(m_lfu.find_exact(name), noop),
+                      m_bucketLfu.modify(m_bucketLfu.find_exact(name), noop));
+  }
+
+  void
+  erase(int id)
+  {
+    Name name = Name("/").appendNumber(id);
+    m_lfu.erase(name);
+    m_bucketLfu.erase(name);
+  }
+
+  /**
+   * @brief Get ids of cached payloads, the eviction victim first
+   */
+  template<class Trie>
+  static std::vector<int>
+  getEvictionOrder(const Trie& trie)
+  {
+    std::vector<int> ids;
+    for (const auto& item : trie.getPolicy()) {
+      ids.push_back(item.payload()->id);
+    }
+    return ids;
+  }
+
+  void
+  checkEvictionOrder(const std::vector<int>& expected)
+  {
+    std::vector<int> lfuOrder = getEvictionOrder(m_lfu);
+    std::vector<int> bucketOrder = getEvictionOrder(m_bucketLfu);
+    BOOST_CHECK_EQUAL_COLLECTIONS(lfuOrder.begin(), lfuOrder.end(),
+                                  expected.begin(), expected.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(bucketOrder.begin(), bucketOrder.end(),
+                                  expected.begin(), expected.end());
+  }
+
+protected:
+  LfuTrie m_lfu;
+  BucketLfuTrie m_bucketLfu;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTrieBucketLfuPolicy, BucketLfuFixture)
+
+BOOST_AUTO_TEST_CASE(TieOrder)
+{
+  setMaxSize(3);
+  insert(1);
+  insert(2);
+  insert(3);
+
+  // 2 reaches frequency 1 before 1 does, so it is evicted before 1
+  lookup(2);
+  lookup(1);
+  checkEvictionOrder({3, 2, 1});
+
+  // 3 is the only item with frequency 0
+  insert(4);
+  lookup(4);
+  checkEvictionOrder({2, 1, 4});
+
+  // all items reach frequency 2, 4 first, so 4 is evicted
+  lookup(4);
+  update(1);
+  lookup(2);
+  checkEvictionOrder({4, 1, 2});
+  insert(5);
+  checkEvictionOrder({5, 1, 2});
+}
+
+BOOST_AUTO_TEST_CASE(SameVictim)
+{
+  setMaxSize(10);
+
+  std::mt19937 generator(1);
+  std::uniform_int_distribution<int> opDistribution(0, 9);
+  std::uniform_int_distribution<int> idDistribution(0, 39);
+
+  for (int i = 0; i < 20000; ++i) {
+    int op = opDistribution(generator);
+    int id = idDistribution(generator);
+    if (op < 4) {
+      insert(id);
+    }
+    else if (op < 7) {
+      lookup(id);
+    }
+    else if (op < 9) {
+      update(id);
+    }
+    else {
+      erase(id);
+    }
+
+    std::vector<int> lfuOrder = getEvictionOrder(m_lfu);
+    std::vector<int> bucketOrder = getEvictionOrder(m_bucketLfu);
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(bucketOrder.begin(), bucketOrder.end(),
+                                    lfuOrder.begin(), lfuOrder.end());
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
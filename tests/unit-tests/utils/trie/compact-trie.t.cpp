@@ -0,0 +1,264 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/trie/trie-with-policy.hpp"
+#include "utils/trie/lru-policy.hpp"
+
+#include "ns3/simple-ref-count.h"
+
+#include "../../tests-common.hpp"
+
+#include <random>
+#include <set>
+
+namespace ns3 {
+namespace ndn {
+
+class CompactTrieFixture : public CleanupFixture
+{
+public:
+  struct Payload : public SimpleRefCount<Payload> {
+    explicit Payload(const Name& name)
+      : name(name)
+    {
+    }
+
+    Name name;
+  };
+
+  typedef ndnSIM::trie_with_policy<Name, ndnSIM::smart_pointer_payload_traits<Payload>,
+                                   ndnSIM::lru_policy_traits, ndnSIM::trie> OriginalTrie;
+  typedef ndnSIM::trie_with_policy<Name, ndnSIM::smart_pointer_payload_traits<Payload>,
+                                   ndnSIM::lru_policy_traits, ndnSIM::compact_trie> CompactTrie;
+
+  CompactTrieFixture()
+  {
+    // lookups may touch different entries of the two tries (see deepest_prefix_match below),
+    // so nothing is evicted to keep their contents identical
+    m_original.getPolicy().set_max_size(0);
+    m_compact.getPolicy().set_max_size(0);
+  }
+
+  void
+  insert(const Name& name)
+  {
+    auto original = m_original.insert(name, Create<Payload>(name));
+    auto compact = m_compact.insert(name, Create<Payload>(name));
+    BOOST_CHECK_EQUAL(original.second, compact.second);
+    BOOST_REQUIRE(original.first != m_original.end());
+    BOOST_REQUIRE(compact.first != m_compact.end());
+    BOOST_CHECK_EQUAL(compact.first->payload()->name, name);
+  }
+
+  void
+  erase(const Name& name)
+  {
+    m_original.erase(name);
+    m_compact.erase(name);
+  }
+
+  void
+  checkFindExact(const Name& name)
+  {
+    OriginalTrie::iterator original = m_original.find_exact(name);
+    CompactTrie::iterator compact = m_compact.find_exact(name);
+    BOOST_REQUIRE_EQUAL(original != m_original.end(), compact != m_compact.end());
+    if (compact != m_compact.end()) {
+      BOOST_CHECK_EQUAL(compact->payload()->name, name);
+    }
+  }
+
+  void
+  checkLongestPrefixMatch(const Name& name)
+  {
+    auto isShort = [] (Ptr<const Payload> payload) { return payload->name.size() < 3; };
+
+    OriginalTrie::iterator original = m_original.longest_prefix_match(name);
+    CompactTrie::iterator compact = m_compact.longest_prefix_match(name);
+    BOOST_REQUIRE_EQUAL(original != m_original.end(), compact != m_compact.end());
+    if (compact != m_compact.end()) {
+      BOOST_CHECK_EQUAL(compact->payload()->name, original->payload()->name);
+    }
+
+    original = m_original.longest_prefix_match_if(name, isShort);
+    compact = m_compact.longest_prefix_match_if(name, isShort);
+    BOOST_REQUIRE_EQUAL(original != m_original.end(), compact != m_compact.end());
+    if (compact != m_compact.end()) {
+      BOOST_CHECK_EQUAL(compact->payload()->name, original->payload()->name);
+    }
+  }
+
+  /**
+   * @brief Check deepest prefix matches
+   *
+   * deepest_prefix_match returns the longest prefix match if it is not shorter than @p name,
+   * and any payload under @p name otherwise, so that results may differ between the tries.
+   */
+  void
+  checkDeepestPrefixMatch(const Name& name)
+  {
+    auto isLong = [] (Ptr<const Payload> payload) { return payload->name.size() == 3; };
+    auto isNotA = [] (const name::Component& component) { return component != "a"; };
+
+    OriginalTrie::iterator original = m_original.deepest_prefix_match(name);
+    CompactTrie::iterator compact = m_compact.deepest_prefix_match(name);
+    BOOST_REQUIRE_EQUAL(original != m_original.end(), compact != m_compact.end());
+    if (compact != m_compact.end()) {
+      const Name& found = compact->payload()->name;
+      if (found.isPrefixOf(name)) {
+        BOOST_CHECK_EQUAL(found, original->payload()->name);
+      }
+      else {
+        BOOST_CHECK(name.isPrefixOf(found));
+      }
+    }
+
+    original = m_original.deepest_prefix_match_if(name, isLong);
+    compact = m_compact.deepest_prefix_match_if(name, isLong);
+    BOOST_REQUIRE_EQUAL(original != m_original.end(), compact != m_compact.end());
+    if (compact != m_compact.end()) {
+      BOOST_CHECK(name.isPrefixOf(compact->payload()->name));
+      BOOST_CHECK(isLong(compact->payload()));
+    }
+
+    original = m_original.deepest_prefix_match_if_next_level(name, isNotA);
+    compact = m_compact.deepest_prefix_match_if_next_level(name, isNotA);
+    BOOST_REQUIRE_EQUAL(original != m_original.end(), compact != m_compact.end());
+    if (compact != m_compact.end()) {
+      const Name& found = compact->payload()->name;
+      BOOST_CHECK(name.isPrefixOf(found));
+      BOOST_REQUIRE_GT(found.size(), name.size());
+      BOOST_CHECK(isNotA(found.get(name.size())));
+    }
+  }
+
+  /**
+   * @brief Get names of all payloads, by iterating over all nodes of @p trie
+   */
+  template<class Trie>
+  static std::set<Name>
+  getNames(Trie& trie)
+  {
+    std::set<Name> names;
+    typename Trie::parent_trie::recursive_iterator item(trie.getTrie()), end(0);
+    for (; item != end; item++) {
+      if (item->payload() != Trie::parent_trie::payload_traits::empty_payload) {
+        BOOST_CHECK(names.insert(item->payload()->name).second);
+      }
+    }
+    return names;
+  }
+
+  void
+  checkSameNames()
+  {
+    std::set<Name> original = getNames(m_original);
+    std::set<Name> compact = getNames(m_compact);
+    BOOST_CHECK_EQUAL_COLLECTIONS(compact.begin(), compact.end(), original.begin(), original.end());
+    BOOST_CHECK_EQUAL(m_compact.getPolicy().size(), compact.size());
+  }
+
+protected:
+  OriginalTrie m_original;
+  CompactTrie m_compact;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTrieCompactTrie, CompactTrieFixture)
+
+BOOST_AUTO_TEST_CASE(Basic)
+{
+  insert("/a/b");
+  insert("/a/b/c");
+  insert("/a/d");
+  insert("/a/b"); // duplicate
+
+  checkFindExact("/a");
+  checkFindExact("/a/b");
+  checkFindExact("/a/b/c/d");
+  checkLongestPrefixMatch("/a/b/c/d");
+  checkLongestPrefixMatch("/x");
+  checkDeepestPrefixMatch("/a");
+  checkDeepestPrefixMatch("/a/d/e");
+  checkSameNames();
+
+  // erasing a payload prunes nodes that have neither payload nor children
+  erase("/a/b/c");
+  erase("/a/d");
+  erase("/a/x");
+  checkSameNames();
+  BOOST_CHECK(m_compact.deepest_prefix_match("/a/d") == m_compact.end());
+
+  erase("/a/b");
+  checkSameNames();
+  BOOST_CHECK(m_compact.deepest_prefix_match("/a") == m_compact.end());
+}
+
+BOOST_AUTO_TEST_CASE(SameAsTrie)
+{
+  std::mt19937 generator(1);
+  std::uniform_int_distribution<int> opDistribution(0, 9);
+  // the first level has more children than compact_trie keeps inline or scans linearly
+  std::uniform_int_distribution<int> firstDistribution(0, 19);
+  std::uniform_int_distribution<int> secondDistribution(0, 2);
+  std::uniform_int_distribution<int> thirdDistribution(0, 11);
+  std::uniform_int_distribution<int> lengthDistribution(1, 3);
+
+  for (int i = 0; i < 20000; ++i) {
+    Name name;
+    int length = lengthDistribution(generator);
+    name.append(std::string(1, 'a' + firstDistribution(generator)));
+    if (length > 1) {
+      name.append(std::string(1, 'a' + secondDistribution(generator)));
+    }
+    if (length > 2) {
+      name.append(std::string(1, 'a' + thirdDistribution(generator)));
+    }
+
+    int op = opDistribution(generator);
+    if (op < 3) {
+      insert(name);
+    }
+    else if (op < 5) {
+      erase(name);
+    }
+    else if (op < 6) {
+      checkFindExact(name);
+    }
+    else if (op < 8) {
+      checkLongestPrefixMatch(name);
+    }
+    else {
+      checkDeepestPrefixMatch(name);
+    }
+
+    if (i % 1000 == 0) {
+      checkSameNames();
+    }
+  }
+  checkSameNames();
+
+  m_original.clear();
+  m_compact.clear();
+  checkSameNames();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,47 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_LOCAL_NODE_HPP
+#define NDNSIM_UTILS_LOCAL_NODE_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+
+namespace ns3 {
+
+class Node;
+
+namespace ndn {
+
+/**
+ * @brief Check whether packets of the node are processed by this process
+ *
+ * In MPI simulations the whole topology is created by every process, but packets of a node are
+ * processed only by the process of its partition.  Per-node work that does not affect other
+ * nodes, such as tracing or calculating FIB routes, is done only for such nodes, so that every
+ * node is handled by exactly one process.  Without MPI, every node is local.
+ */
+bool
+IsLocalNode(Ptr<Node> node);
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_LOCAL_NODE_HPP
@@ -41,6 +41,7 @@
 #include "ns3/random-variable.h"
 #include "ns3/error-model.h"
 #include "ns3/constant-position-mobility-model.h"
+#include "ns3/data-rate.h"
 
 #include "model/ndn-l3-protocol.hpp"
 #include "model/ndn-net-device-face.hpp"
@@ -52,7 +53,12 @@
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/graphviz.hpp>
 
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <limits>
 #include <set>
+#include <unordered_map>
 
 #ifdef NS3_MPI
 #include <ns3/mpi-interface.h>
@@ -64,6 +70,100 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE("AnnotatedTopologyReader");
 
+static const char BINARY_TOPOLOGY_MAGIC[8] = {'N', 'D', 'N', 'T', 'O', 'P', 'O', '\0'};
+static const uint32_t BINARY_TOPOLOGY_VERSION = 1;
+static const uint32_t BINARY_TOPOLOGY_NONE = std::numeric_limits<uint32_t>::max();
+
+static void
+CheckPartitions(uint32_t requiredPartitions)
+{
+#ifdef NS3_MPI
+  if (MpiInterface::IsEnabled() && MpiInterface::GetSize() != requiredPartitions) {
+    std::cerr << "MPI interface is enabled, but number of partitions (" << MpiInterface::GetSize()
+              << ") is not equal to number of partitions in the topology (" << requiredPartitions
+              << ")";
+    exit(-1);
+  }
+#endif
+}
+
+/**
+ * \brief Set queue of the link from MaxPackets attribute: either the number of packets of
+ *        DropTailQueue, or comma-separated queue class and its attributes
+ */
+static void
+SetQueue(PointToPointHelper& p2p, const std::string& value)
+{
+  try {
+    uint32_t maxPackets = boost::lexical_cast<uint32_t>(value);
+
+    // compatibility mode. Only DropTailQueue is supported
+    p2p.SetQueue("ns3::DropTailQueue", "MaxPackets", UintegerValue(maxPackets));
+  }
+  catch (...) {
+    typedef boost::tokenizer<boost::escaped_list_separator<char>> tokenizer;
+    tokenizer tok(value);
+
+    tokenizer::iterator token = tok.begin();
+    p2p.SetQueue(*token);
+
+    for (token++; token != tok.end(); token++) {
+      boost::escaped_list_separator<char> separator('\\', '=', '\"');
+      tokenizer attributeTok(*token, separator);
+
+      tokenizer::iterator attributeToken = attributeTok.begin();
+
+      string attribute = *attributeToken;
+      attributeToken++;
+
+      if (attributeToken == attributeTok.end()) {
+        NS_LOG_ERROR("Queue attribute [" << *token << "] should be in form <Attribute>=<Value>");
+        continue;
+      }
+
+      string value = *attributeToken;
+
+      p2p.SetQueueAttribute(attribute, StringValue(value));
+    }
+  }
+}
+
+/**
+ * \brief Get factory of error models from LossRate attribute: comma-separated ErrorModel class
+ *        and its attributes
+ */
+static ObjectFactory
+GetErrorModelFactory(const std::string& value)
+{
+  typedef boost::tokenizer<boost::escaped_list_separator<char>> tokenizer;
+  tokenizer tok(value);
+
+  tokenizer::iterator token = tok.begin();
+  ObjectFactory factory(*token);
+
+  for (token++; token != tok.end(); token++) {
+    boost::escaped_list_separator<char> separator('\\', '=', '\"');
+    tokenizer attributeTok(*token, separator);
+
+    tokenizer::iterator attributeToken = attributeTok.begin();
+
+    string attribute = *attributeToken;
+    attributeToken++;
+
+    if (attributeToken == attributeTok.end()) {
+      NS_LOG_ERROR("ErrorModel attribute [" << *token
+                                            << "] should be in form <Attribute>=<Value>");
+      continue;
+    }
+
+    string value = *attributeToken;
+
+    factory.Set(attribute, StringValue(value));
+  }
+
+  return factory;
+}
+
 AnnotatedTopologyReader::AnnotatedTopologyReader(const std::string& path, double scale /*=1.0*/)
   : m_path(path)
   , m_randX(0, 100.0)
@@ -145,6 +245,16 @@ AnnotatedTopologyReader::GetLinks() const
 NodeContainer
 AnnotatedTopologyReader::Read(void)
 {
+  {
+    ifstream probe(GetFileName().c_str(), ios::binary);
+    char magic[sizeof(BINARY_TOPOLOGY_MAGIC)];
+    if (probe.read(magic, sizeof(magic))
+        && std::equal(magic, magic + sizeof(magic), BINARY_TOPOLOGY_MAGIC)) {
+      ReadBinaryTopology();
+      return m_nodes;
+    }
+  }
+
   ifstream topgen;
   topgen.open(GetFileName().c_str());
 
@@ -257,6 +367,171 @@ AnnotatedTopologyReader::Read(void)
   return m_nodes;
 }
 
+void
+AnnotatedTopologyReader::ReadBinaryTopology()
+{
+  ifstream file(GetFileName().c_str(), ios::binary);
+  std::vector<char> buffer((std::istreambuf_iterator<char>(file)),
+                           std::istreambuf_iterator<char>());
+  size_t offset = sizeof(BINARY_TOPOLOGY_MAGIC);
+
+  // little-endian, see SaveBinaryTopology
+  auto read = [this, &buffer, &offset](size_t size) -> uint64_t {
+    if (buffer.size() - offset < size) {
+      NS_FATAL_ERROR("Binary topology file " << GetFileName() << " is truncated");
+    }
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; ++i) {
+      value |= static_cast<uint64_t>(static_cast<uint8_t>(buffer[offset + i])) << (8 * i);
+    }
+    offset += size;
+    return value;
+  };
+  // counts are bounded by the file size, so damaged counts cannot cause huge allocations
+  auto readCount = [this, &read](uint64_t limit) -> uint32_t {
+    uint64_t count = read(4);
+    if (count > limit) {
+      NS_FATAL_ERROR("Binary topology file " << GetFileName() << " is damaged");
+    }
+    return count;
+  };
+  auto readIndex = [this, &read](uint64_t limit, bool isOptional) -> uint32_t {
+    uint64_t index = read(4);
+    if (index >= limit && !(isOptional && index == BINARY_TOPOLOGY_NONE)) {
+      NS_FATAL_ERROR("Binary topology file " << GetFileName() << " is damaged");
+    }
+    return index;
+  };
+  auto readDouble = [&read]() {
+    uint64_t bits = read(8);
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  };
+
+  if (read(4) != BINARY_TOPOLOGY_VERSION) {
+    NS_FATAL_ERROR("Binary topology file " << GetFileName() << " has unsupported version");
+  }
+
+  std::vector<std::string> strings(readCount(buffer.size()));
+  for (std::string& value : strings) {
+    uint32_t length = read(4);
+    if (length > buffer.size() - offset) {
+      NS_FATAL_ERROR("Binary topology file " << GetFileName() << " is truncated");
+    }
+    value.assign(buffer.data() + offset, length);
+    offset += length;
+  }
+
+  uint32_t nNodes = readCount(buffer.size());
+  std::vector<uint32_t> names(nNodes);
+  std::vector<uint32_t> systemIds(nNodes);
+  std::vector<double> posX(nNodes);
+  std::vector<double> posY(nNodes);
+  for (uint32_t& name : names)
+    name = readIndex(strings.size(), false);
+  for (uint32_t& systemId : systemIds)
+    systemId = read(4);
+  for (double& x : posX)
+    x = readDouble();
+  for (double& y : posY)
+    y = readDouble();
+
+  uint32_t nLinks = readCount(buffer.size());
+  std::vector<uint32_t> from(nLinks);
+  std::vector<uint32_t> to(nLinks);
+  std::vector<uint64_t> dataRates(nLinks);
+  std::vector<int64_t> delays(nLinks);
+  std::vector<uint16_t> metrics(nLinks);
+  std::vector<uint32_t> queues(nLinks);
+  std::vector<uint32_t> lossRates(nLinks);
+  for (uint32_t& node : from)
+    node = readIndex(nNodes, false);
+  for (uint32_t& node : to)
+    node = readIndex(nNodes, false);
+  for (uint64_t& dataRate : dataRates)
+    dataRate = read(8);
+  for (int64_t& delay : delays)
+    delay = static_cast<int64_t>(read(8));
+  for (uint16_t& metric : metrics)
+    metric = read(2);
+  for (uint32_t& queue : queues)
+    queue = readIndex(strings.size(), true);
+  for (uint32_t& lossRate : lossRates)
+    lossRate = readIndex(strings.size(), true);
+
+  std::vector<Ptr<Node>> nodes(nNodes);
+  for (uint32_t i = 0; i < nNodes; ++i) {
+    if (std::isnan(posX[i]))
+      nodes[i] = CreateNode(strings[names[i]], systemIds[i]);
+    else
+      nodes[i] = CreateNode(strings[names[i]], posX[i], posY[i], systemIds[i]);
+  }
+
+  CheckPartitions(m_requiredPartitions);
+
+  // Devices are configured only when attributes differ from the previous link, and unspecified
+  // attributes keep values of the previous link, as in ApplySettings
+  PointToPointHelper p2p;
+  uint64_t dataRate = 0;
+  int64_t delay = -1;
+  uint32_t queue = BINARY_TOPOLOGY_NONE;
+  std::unordered_map<uint32_t, ObjectFactory> errorModels;
+
+  for (uint32_t i = 0; i < nLinks; ++i) {
+    Link link(nodes[from[i]], strings[names[from[i]]], nodes[to[i]], strings[names[to[i]]]);
+
+    if (dataRates[i] != 0) {
+      link.SetAttribute("DataRate", boost::lexical_cast<string>(DataRate(dataRates[i])));
+      if (dataRates[i] != dataRate) {
+        dataRate = dataRates[i];
+        p2p.SetDeviceAttribute("DataRate", DataRateValue(DataRate(dataRate)));
+      }
+    }
+
+    link.SetAttribute("OSPF", boost::lexical_cast<string>(metrics[i]));
+
+    if (delays[i] >= 0) {
+      link.SetAttribute("Delay", boost::lexical_cast<string>(delays[i]) + "ns");
+      if (delays[i] != delay) {
+        delay = delays[i];
+        p2p.SetChannelAttribute("Delay", TimeValue(NanoSeconds(delay)));
+      }
+    }
+
+    if (queues[i] != BINARY_TOPOLOGY_NONE) {
+      link.SetAttribute("MaxPackets", strings[queues[i]]);
+      if (queues[i] != queue) {
+        queue = queues[i];
+        SetQueue(p2p, strings[queue]);
+      }
+    }
+
+    NetDeviceContainer nd = p2p.Install(link.GetFromNode(), link.GetToNode());
+    link.SetNetDevices(nd.Get(0), nd.Get(1));
+
+    if (lossRates[i] != BINARY_TOPOLOGY_NONE) {
+      link.SetAttribute("LossRate", strings[lossRates[i]]);
+
+      auto errorModel = errorModels.find(lossRates[i]);
+      if (errorModel == errorModels.end()) {
+        errorModel = errorModels.insert(std::make_pair(lossRates[i],
+                                                       GetErrorModelFactory(strings[lossRates[i]])))
+                       .first;
+      }
+      nd.Get(0)->SetAttribute("ReceiveErrorModel",
+                              PointerValue(errorModel->second.Create<ErrorModel>()));
+      nd.Get(1)->SetAttribute("ReceiveErrorModel",
+                              PointerValue(errorModel->second.Create<ErrorModel>()));
+    }
+
+    AddLink(link);
+  }
+
+  NS_LOG_INFO("Binary topology loaded with " << m_nodes.GetN() << " nodes and " << LinksSize()
+                                             << " links");
+}
+
 void
 AnnotatedTopologyReader::AssignIpv4Addresses(Ipv4Address base)
 {
@@ -318,14 +593,7 @@ AnnotatedTopologyReader::ApplyOspfMetric()
 void
 AnnotatedTopologyReader::ApplySettings()
 {
-#ifdef NS3_MPI
-  if (MpiInterface::IsEnabled() && MpiInterface::GetSize() != m_requiredPartitions) {
-    std::cerr << "MPI interface is enabled, but number of partitions (" << MpiInterface::GetSize()
-              << ") is not equal to number of partitions in the topology (" << m_requiredPartitions
-              << ")";
-    exit(-1);
-  }
-#endif
+  CheckPartitions(m_requiredPartitions);
 
   PointToPointHelper p2p;
 
@@ -336,41 +604,7 @@ AnnotatedTopologyReader::ApplySettings()
     ////////////////////////////////////////////////
     if (link.GetAttributeFailSafe("MaxPackets", tmp)) {
       NS_LOG_INFO("MaxPackets = " + link.GetAttribute("MaxPackets"));
-
-      try {
-        uint32_t maxPackets = boost::lexical_cast<uint32_t>(link.GetAttribute("MaxPackets"));
-
-        // compatibility mode. Only DropTailQueue is supported
-        p2p.SetQueue("ns3::DropTailQueue", "MaxPackets", UintegerValue(maxPackets));
-      }
-      catch (...) {
-        typedef boost::tokenizer<boost::escaped_list_separator<char>> tokenizer;
-        std::string value = link.GetAttribute("MaxPackets");
-        tokenizer tok(value);
-
-        tokenizer::iterator token = tok.begin();
-        p2p.SetQueue(*token);
-
-        for (token++; token != tok.end(); token++) {
-          boost::escaped_list_separator<char> separator('\\', '=', '\"');
-          tokenizer attributeTok(*token, separator);
-
-          tokenizer::iterator attributeToken = attributeTok.begin();
-
-          string attribute = *attributeToken;
-          attributeToken++;
-
-          if (attributeToken == attributeTok.end()) {
-            NS_LOG_ERROR("Queue attribute [" << *token
-                                             << "] should be in form <Attribute>=<Value>");
-            continue;
-          }
-
-          string value = *attributeToken;
-
-          p2p.SetQueueAttribute(attribute, StringValue(value));
-        }
-      }
+      SetQueue(p2p, link.GetAttribute("MaxPackets"));
     }
 
     if (link.GetAttributeFailSafe("DataRate", tmp)) {
@@ -390,33 +624,7 @@ AnnotatedTopologyReader::ApplySettings()
     if (link.GetAttributeFailSafe("LossRate", tmp)) {
       NS_LOG_INFO("LinkError = " + link.GetAttribute("LossRate"));
 
-      typedef boost::tokenizer<boost::escaped_list_separator<char>> tokenizer;
-      std::string value = link.GetAttribute("LossRate");
-      tokenizer tok(value);
-
-      tokenizer::iterator token = tok.begin();
-      ObjectFactory factory(*token);
-
-      for (token++; token != tok.end(); token++) {
-        boost::escaped_list_separator<char> separator('\\', '=', '\"');
-        tokenizer attributeTok(*token, separator);
-
-        tokenizer::iterator attributeToken = attributeTok.begin();
-
-        string attribute = *attributeToken;
-        attributeToken++;
-
-        if (attributeToken == attributeTok.end()) {
-          NS_LOG_ERROR("ErrorModel attribute [" << *token
-                                                << "] should be in form <Attribute>=<Value>");
-          continue;
-        }
-
-        string value = *attributeToken;
-
-        factory.Set(attribute, StringValue(value));
-      }
-
+      ObjectFactory factory = GetErrorModelFactory(link.GetAttribute("LossRate"));
       nd.Get(0)->SetAttribute("ReceiveErrorModel", PointerValue(factory.Create<ErrorModel>()));
       nd.Get(1)->SetAttribute("ReceiveErrorModel", PointerValue(factory.Create<ErrorModel>()));
     }
@@ -495,6 +703,130 @@ AnnotatedTopologyReader::SaveTopology(const std::string& file)
   }
 }
 
+void
+AnnotatedTopologyReader::SaveBinaryTopology(const std::string& file)
+{
+  std::vector<std::string> strings;
+  std::unordered_map<std::string, uint32_t> stringIds;
+  auto intern = [&strings, &stringIds](const std::string& value) -> uint32_t {
+    auto entry = stringIds.insert(std::make_pair(value, strings.size()));
+    if (entry.second)
+      strings.push_back(value);
+    return entry.first->second;
+  };
+
+  std::unordered_map<uint32_t, uint32_t> nodeIndexes; // by node ID
+  std::vector<uint32_t> names;
+  std::vector<uint32_t> systemIds;
+  std::vector<double> posX;
+  std::vector<double> posY;
+  for (NodeContainer::Iterator node = m_nodes.Begin(); node != m_nodes.End(); node++) {
+    std::string name = Names::FindName(*node);
+    if (name.empty())
+      NS_FATAL_ERROR("Node " << (*node)->GetId() << " does not have a name");
+
+    nodeIndexes[(*node)->GetId()] = names.size();
+    names.push_back(intern(name));
+    systemIds.push_back((*node)->GetSystemId());
+
+    Ptr<MobilityModel> mobility = (*node)->GetObject<MobilityModel>();
+    if (mobility != 0) {
+      posX.push_back(mobility->GetPosition().x);
+      posY.push_back(mobility->GetPosition().y);
+    }
+    else {
+      posX.push_back(std::numeric_limits<double>::quiet_NaN());
+      posY.push_back(std::numeric_limits<double>::quiet_NaN());
+    }
+  }
+
+  auto getNodeIndex = [&nodeIndexes](Ptr<Node> node) -> uint32_t {
+    auto index = nodeIndexes.find(node->GetId());
+    if (index == nodeIndexes.end())
+      NS_FATAL_ERROR("Link to node " << node->GetId() << " that was not created by the reader");
+    return index->second;
+  };
+
+  std::vector<uint32_t> from;
+  std::vector<uint32_t> to;
+  std::vector<uint64_t> dataRates;
+  std::vector<int64_t> delays;
+  std::vector<uint16_t> metrics;
+  std::vector<uint32_t> queues;
+  std::vector<uint32_t> lossRates;
+  for (const Link& link : m_linksList) {
+    from.push_back(getNodeIndex(link.GetFromNode()));
+    to.push_back(getNodeIndex(link.GetToNode()));
+
+    string value;
+    dataRates.push_back(link.GetAttributeFailSafe("DataRate", value) ? DataRate(value).GetBitRate()
+                                                                     : 0);
+    delays.push_back(link.GetAttributeFailSafe("Delay", value) ? Time(value).GetNanoSeconds()
+                                                               : -1);
+    metrics.push_back(link.GetAttributeFailSafe("OSPF", value)
+                        ? boost::lexical_cast<uint16_t>(value) : 1);
+    queues.push_back(link.GetAttributeFailSafe("MaxPackets", value) ? intern(value)
+                                                                    : BINARY_TOPOLOGY_NONE);
+    lossRates.push_back(link.GetAttributeFailSafe("LossRate", value) ? intern(value)
+                                                                     : BINARY_TOPOLOGY_NONE);
+  }
+
+  std::string buffer(BINARY_TOPOLOGY_MAGIC, sizeof(BINARY_TOPOLOGY_MAGIC));
+
+  // little-endian, so that files can be shared between platforms
+  auto write = [&buffer](uint64_t value, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+      buffer.push_back(static_cast<char>(value >> (8 * i)));
+    }
+  };
+  auto writeDouble = [&write](double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    write(bits, 8);
+  };
+
+  write(BINARY_TOPOLOGY_VERSION, 4);
+
+  write(strings.size(), 4);
+  for (const std::string& value : strings) {
+    write(value.size(), 4);
+    buffer.append(value);
+  }
+
+  write(names.size(), 4);
+  for (uint32_t name : names)
+    write(name, 4);
+  for (uint32_t systemId : systemIds)
+    write(systemId, 4);
+  for (double x : posX)
+    writeDouble(x);
+  for (double y : posY)
+    writeDouble(y);
+
+  write(from.size(), 4);
+  for (uint32_t node : from)
+    write(node, 4);
+  for (uint32_t node : to)
+    write(node, 4);
+  for (uint64_t dataRate : dataRates)
+    write(dataRate, 8);
+  for (int64_t delay : delays)
+    write(static_cast<uint64_t>(delay), 8);
+  for (uint16_t metric : metrics)
+    write(metric, 2);
+  for (uint32_t queue : queues)
+    write(queue, 4);
+  for (uint32_t lossRate : lossRates)
+    write(lossRate, 4);
+
+  ofstream os(file.c_str(), ios::binary | ios::trunc);
+  os.write(buffer.data(), buffer.size());
+  os.close();
+  if (!os) {
+    NS_FATAL_ERROR("Cannot write binary topology to " << file);
+  }
+}
+
 /// @cond include_hidden
 
 template<class Names>
@@ -49,7 +49,8 @@ public:
   /**
    * \brief Main annotated topology reading function.
    *
-   * This method opens an input stream and reads topology file with annotations.
+   * This method opens an input stream and reads topology file with annotations.  Files in the
+   * binary format written by SaveBinaryTopology are recognized and loaded directly.
    *
    * \return the container of the nodes created (or empty container if there was an error)
    */
@@ -115,6 +116,20 @@ public:
   virtual void
   SaveGraphviz(const std::string& file);
 
+  /**
+   * \brief Save nodes and links in compact binary format, which Read loads much faster
+   *
+   * Node names and attribute strings are interned, node positions are stored as they are
+   * (already scaled, including randomly placed nodes), and link attributes are stored in
+   * per-attribute arrays, with data rates and delays in parsed form.  Links are created from
+   * the file without name lookups or per-link parsing.  Any reader can be converted, e.g.,
+   * RocketfuelMapReader after Read(params), which freezes randomly assigned link parameters.
+   *
+   * Node roles of RocketfuelMapReader (backbone, gateway, customer) are not stored.
+   */
+  virtual void
+  SaveBinaryTopology(const std::string& file);
+
 protected:
   Ptr<Node>
   CreateNode(const std::string name, uint32_t systemId);
@@ -140,6 +155,12 @@ private:
   AnnotatedTopologyReader&
   operator=(const AnnotatedTopologyReader&);
 
+  /**
+   * \brief Create nodes and links from the file written by SaveBinaryTopology
+   */
+  void
+  ReadBinaryTopology();
+
   UniformVariable m_randX;
   UniformVariable m_randY;
 
@@ -18,6 +18,8 @@
  **/
 
 #include "l2-rate-tracer.hpp"
+#include "ndn-tracer-output.hpp"
+#include "utils/ndn-local-node.hpp"
 
 #include "ns3/node.h"
 #include "ns3/packet.h"
@@ -48,23 +50,16 @@ void
 L2RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
 {
   std::list<Ptr<L2RateTracer>> tracers;
-  std::shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    std::shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = std::shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  std::shared_ptr<std::ostream> outputStream = OpenTracerOutput(file);
+  if (outputStream == nullptr) {
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    if (!IsLocalNode(*node)) {
+      continue;
+    }
+
     NS_LOG_DEBUG("Node: " << boost::lexical_cast<std::string>((*node)->GetId()));
 
     Ptr<L2RateTracer> trace = Create<L2RateTracer>(outputStream, *node);
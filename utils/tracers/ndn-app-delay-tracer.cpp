@@ -18,6 +18,8 @@
  **/
 
 #include "ndn-app-delay-tracer.hpp"
+#include "ndn-tracer-output.hpp"
+#include "utils/ndn-local-node.hpp"
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/config.h"
@@ -55,23 +57,16 @@ AppDelayTracer::InstallAll(const std::string& file)
   using namespace std;
 
   std::list<Ptr<AppDelayTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<std::ostream> outputStream = OpenTracerOutput(file);
+  if (outputStream == nullptr) {
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    if (!IsLocalNode(*node)) {
+      continue;
+    }
+
     Ptr<AppDelayTracer> trace = Install(*node, outputStream);
     tracers.push_back(trace);
   }
@@ -92,23 +87,16 @@ AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
   using namespace std;
 
   std::list<Ptr<AppDelayTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<std::ostream> outputStream = OpenTracerOutput(file);
+  if (outputStream == nullptr) {
+    return;
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    if (!IsLocalNode(*node)) {
+      continue;
+    }
+
     Ptr<AppDelayTracer> trace = Install(*node, outputStream);
     tracers.push_back(trace);
   }
@@ -125,36 +113,7 @@ AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
 void
 AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
 {
-  using namespace boost;
-  using namespace std;
-
-  std::list<Ptr<AppDelayTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
-  }
-
-  Ptr<AppDelayTracer> trace = Install(node, outputStream);
-  tracers.push_back(trace);
-
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
-
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  Install(NodeContainer(node), file);
 }
 
 Ptr<AppDelayTracer>
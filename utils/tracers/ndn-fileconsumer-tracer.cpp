@@ -19,6 +19,8 @@
  **/
 
 #include "ndn-fileconsumer-tracer.hpp"
+#include "ndn-tracer-output.hpp"
+#include "utils/ndn-local-node.hpp"
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/config.h"
@@ -56,23 +58,16 @@ FileConsumerTracer::InstallAll(const std::string& file)
   using namespace std;
 
   std::list<Ptr<FileConsumerTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<std::ostream> outputStream = OpenTracerOutput(file);
+  if (outputStream == nullptr) {
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    if (!IsLocalNode(*node)) {
+      continue;
+    }
+
     Ptr<FileConsumerTracer> trace = Install(*node, outputStream);
     tracers.push_back(trace);
   }
@@ -93,23 +88,16 @@ FileConsumerTracer::Install(const NodeContainer& nodes, const std::string& file)
   using namespace std;
 
   std::list<Ptr<FileConsumerTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<std::ostream> outputStream = OpenTracerOutput(file);
+  if (outputStream == nullptr) {
+    return;
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    if (!IsLocalNode(*node)) {
+      continue;
+    }
+
     Ptr<FileConsumerTracer> trace = Install(*node, outputStream);
     tracers.push_back(trace);
   }
@@ -126,36 +114,7 @@ FileConsumerTracer::Install(const NodeContainer& nodes, const std::string& file)
 void
 FileConsumerTracer::Install(Ptr<Node> node, const std::string& file)
 {
-  using namespace boost;
-  using namespace std;
-
-  std::list<Ptr<FileConsumerTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
-  }
-
-  Ptr<FileConsumerTracer> trace = Install(node, outputStream);
-  tracers.push_back(trace);
-
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
-
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  Install(NodeContainer(node), file);
 }
 
 Ptr<FileConsumerTracer>
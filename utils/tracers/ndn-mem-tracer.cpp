@@ -0,0 +1,196 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-mem-tracer.hpp"
+#include "ndn-tracer-output.hpp"
+#include "utils/ndn-local-node.hpp"
+#include "ns3/node.h"
+#include "ns3/names.h"
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/log.h"
+
+#include "apps/ndn-app.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "model/cs/ndn-content-store.hpp"
+#include "NFD/daemon/fw/forwarder.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <fstream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.MemTracer");
+
+namespace ns3 {
+namespace ndn {
+
+static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<MemTracer>>>> g_tracers;
+
+void
+MemTracer::Destroy()
+{
+  g_tracers.clear();
+}
+
+void
+MemTracer::InstallAll(const std::string& file, Time period /* = Seconds (1.0)*/)
+{
+  Install(NodeContainer::GetGlobal(), file, period);
+}
+
+void
+MemTracer::Install(const NodeContainer& nodes, const std::string& file,
+                   Time period /* = Seconds (1.0)*/)
+{
+  shared_ptr<std::ostream> outputStream = OpenTracerOutput(file);
+  if (outputStream == nullptr) {
+    return;
+  }
+
+  std::list<Ptr<MemTracer>> tracers;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    if (!IsLocalNode(*node)) {
+      continue;
+    }
+
+    tracers.push_back(Install(*node, outputStream, period));
+  }
+
+  if (tracers.size() > 0) {
+    tracers.front()->PrintHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+void
+MemTracer::Install(Ptr<Node> node, const std::string& file, Time period /* = Seconds (1.0)*/)
+{
+  Install(NodeContainer(node), file, period);
+}
+
+Ptr<MemTracer>
+MemTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
+                   Time period /* = Seconds (1.0)*/)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<MemTracer> trace = Create<MemTracer>(outputStream, node);
+  trace->SetPeriod(period);
+
+  return trace;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+MemTracer::MemTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+  : m_nodePtr(node)
+  , m_os(os)
+{
+  m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
+
+  std::string name = Names::FindName(node);
+  if (!name.empty()) {
+    m_node = name;
+  }
+}
+
+void
+MemTracer::SetPeriod(const Time& period)
+{
+  m_period = period;
+  m_printEvent.Cancel();
+  m_printEvent = Simulator::Schedule(m_period, &MemTracer::PeriodicPrinter, this);
+}
+
+void
+MemTracer::PeriodicPrinter()
+{
+  Print(*m_os);
+
+  m_printEvent = Simulator::Schedule(m_period, &MemTracer::PeriodicPrinter, this);
+}
+
+void
+MemTracer::PrintHeader(std::ostream& os) const
+{
+  os << "Time"
+     << "\t"
+
+     << "Node"
+     << "\t"
+
+     << "Table"
+     << "\t"
+     << "Entries"
+     << "\t"
+     << "Bytes";
+}
+
+#define PRINTER(printName, usage)                                                                  \
+  os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << printName << "\t"                      \
+     << usage.nEntries << "\t" << usage.nBytes << "\n";
+
+void
+MemTracer::Print(std::ostream& os) const
+{
+  Time time = Simulator::Now();
+
+  Ptr<L3Protocol> ndn = m_nodePtr->GetObject<L3Protocol>();
+  if (ndn == nullptr) {
+    return;
+  }
+
+  nfd::ForwarderMemoryUsage tables = ndn->getForwarder()->getMemoryUsage();
+  nfd::MemoryUsage total = tables.getTotal();
+
+  PRINTER("NameTree", tables.nameTree);
+  PRINTER("Fib", tables.fib);
+  PRINTER("Pit", tables.pit);
+  PRINTER("Cs", tables.cs);
+  PRINTER("Measurements", tables.measurements);
+  PRINTER("StrategyChoice", tables.strategyChoice);
+  PRINTER("DeadNonceList", tables.deadNonceList);
+
+  Ptr<ContentStore> oldCs = m_nodePtr->GetObject<ContentStore>();
+  if (oldCs != nullptr) {
+    nfd::MemoryUsage usage(oldCs->GetSize(), oldCs->GetBytesInUse());
+    PRINTER("OldCs", usage);
+    total += usage;
+  }
+
+  nfd::MemoryUsage apps;
+  for (uint32_t i = 0; i < m_nodePtr->GetNApplications(); ++i) {
+    Ptr<App> app = DynamicCast<App>(m_nodePtr->GetApplication(i));
+    if (app != nullptr) {
+      apps.nEntries++;
+      apps.nBytes += app->GetBufferedBytes();
+    }
+  }
+  PRINTER("Apps", apps);
+  total += apps;
+
+  PRINTER("Total", total);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,221 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-tracer-output.hpp"
+
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#ifdef NS3_MPI
+#include "ns3/mpi-interface.h"
+#include <mpi.h>
+#endif
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <queue>
+#include <set>
+#include <tuple>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TracerOutput");
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Tracer files of this process, merged with files of other processes at the end
+ */
+static std::list<std::tuple<std::string, std::weak_ptr<std::ostream>>> g_outputs;
+
+static std::string
+GetPartFileName(const std::string& file, uint32_t index)
+{
+  return file + "." + std::to_string(index);
+}
+
+#ifdef NS3_MPI
+static void
+MergeOutputs()
+{
+  std::set<std::string> files;
+  for (const auto& output : g_outputs) {
+    shared_ptr<std::ostream> os = std::get<1>(output).lock();
+    if (os != nullptr) {
+      os->flush();
+    }
+    files.insert(std::get<0>(output));
+  }
+  g_outputs.clear();
+
+  // files of all processes must be complete before they are merged
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  if (MpiInterface::GetSystemId() == 0) {
+    for (const std::string& file : files) {
+      if (!MergeTracerFiles(file, MpiInterface::GetSize())) {
+        NS_LOG_ERROR("Tracer files of " << file << " cannot be merged");
+      }
+    }
+  }
+}
+#endif
+
+shared_ptr<std::ostream>
+OpenTracerOutput(const std::string& file)
+{
+  if (file == "-") {
+    return shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  std::string fileName = file;
+#ifdef NS3_MPI
+  bool isMerged = MpiInterface::IsEnabled() && MpiInterface::GetSize() > 1;
+  if (isMerged) {
+    fileName = GetPartFileName(file, MpiInterface::GetSystemId());
+  }
+#endif
+
+  shared_ptr<std::ofstream> os(new std::ofstream());
+  os->open(fileName.c_str(), std::ios_base::out | std::ios_base::trunc);
+
+  if (!os->is_open()) {
+    NS_LOG_ERROR("File " << fileName << " cannot be opened for writing. Tracing disabled");
+    return nullptr;
+  }
+
+#ifdef NS3_MPI
+  if (isMerged) {
+    if (g_outputs.empty()) {
+      Simulator::ScheduleDestroy(&MergeOutputs);
+    }
+    g_outputs.push_back(std::make_tuple(file, std::weak_ptr<std::ostream>(os)));
+  }
+#endif
+
+  return os;
+}
+
+namespace {
+
+struct TraceLine {
+  double time;
+  uint32_t index;
+  std::string text;
+};
+
+struct IsLaterLine {
+  bool
+  operator()(const TraceLine& a, const TraceLine& b) const
+  {
+    return a.time > b.time || (a.time == b.time && a.index > b.index);
+  }
+};
+
+} // namespace
+
+bool
+MergeTracerFiles(const std::string& file, uint32_t nFiles)
+{
+  std::vector<std::unique_ptr<std::ifstream>> inputs;
+  for (uint32_t i = 0; i < nFiles; ++i) {
+    inputs.push_back(std::unique_ptr<std::ifstream>(new std::ifstream(GetPartFileName(file, i))));
+    if (!inputs.back()->is_open()) {
+      NS_LOG_ERROR("File " << GetPartFileName(file, i) << " cannot be opened for reading");
+      return false;
+    }
+  }
+
+  std::ofstream os(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+  if (!os.is_open()) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing");
+    return false;
+  }
+
+  // the next line of every file; lines that do not start with time (the header, which is the
+  // first line of a file) are kept with the previous line of the file
+  std::priority_queue<TraceLine, std::vector<TraceLine>, IsLaterLine> queue;
+  std::vector<double> lastTimes(nFiles, 0);
+  std::vector<bool> isFirstLine(nFiles, true);
+  bool hasHeader = false;
+
+  auto readLine = [&] (uint32_t index) {
+    std::string text;
+    while (std::getline(*inputs[index], text)) {
+      if (text.empty()) {
+        continue;
+      }
+
+      const char* begin = text.c_str();
+      char* end = nullptr;
+      double time = std::strtod(begin, &end);
+      bool isFirst = isFirstLine[index];
+      isFirstLine[index] = false;
+
+      if (end == begin) {
+        if (!isFirst) {
+          time = lastTimes[index];
+        }
+        else if (hasHeader) {
+          continue;
+        }
+        else {
+          os << text << "\n";
+          hasHeader = true;
+          continue;
+        }
+      }
+
+      lastTimes[index] = time;
+      queue.push(TraceLine{time, index, std::move(text)});
+      return;
+    }
+  };
+
+  for (uint32_t i = 0; i < nFiles; ++i) {
+    readLine(i);
+  }
+  while (!queue.empty()) {
+    uint32_t index = queue.top().index;
+    os << queue.top().text << "\n";
+    queue.pop();
+    readLine(index);
+  }
+
+  os.close();
+  if (!os) {
+    NS_LOG_ERROR("Cannot write merged traces to " << file);
+    return false;
+  }
+
+  for (uint32_t i = 0; i < nFiles; ++i) {
+    inputs[i]->close();
+    std::remove(GetPartFileName(file, i).c_str());
+  }
+  return true;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,58 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_TRACER_OUTPUT_H
+#define NDN_TRACER_OUTPUT_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <ostream>
+#include <string>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Open output stream of a tracer
+ * @param file name of the file, or "-" for standard output
+ * @return the stream, or nullptr if the file cannot be opened
+ *
+ * In MPI simulations every process writes to its own file, `<file>.<system ID>`.  When the
+ * simulator is destroyed, the files of all processes are merged into \p file in time order
+ * (see MergeTracerFiles), so all processes must install the same tracers.
+ */
+shared_ptr<std::ostream>
+OpenTracerOutput(const std::string& file);
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Merge tracer files `<file>.0` ... `<file>.<nFiles - 1>` into \p file and remove them
+ * @return false if any of the files cannot be read or \p file cannot be written
+ *
+ * Lines of each file must be sorted by time, the first column.  Lines with equal time are
+ * taken from files with lower numbers first, and the header line is written only once.
+ */
+bool
+MergeTracerFiles(const std::string& file, uint32_t nFiles);
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_TRACER_OUTPUT_H
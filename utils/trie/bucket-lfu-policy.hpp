@@ -0,0 +1,294 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef BUCKET_LFU_POLICY_H_
+#define BUCKET_LFU_POLICY_H_
+
+/// @cond include_hidden
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for LFU replacement policy with constant-time updates
+ *
+ * Entries are kept in a single list ordered by access frequency, split into runs of equal
+ * frequency.  Each run is described by a bucket that knows its frequency, its first entry and
+ * its size, so a hit moves the entry to the end of the next run instead of re-inserting it into
+ * an ordered tree as lfu_policy_traits does.  Entries with the same frequency are evicted in the
+ * order they reached that frequency, which is the same order lfu_policy_traits uses.
+ */
+struct bucket_lfu_policy_traits {
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string
+  GetName()
+  {
+    return "BucketLfu";
+  }
+
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> {
+    void* bucket;
+  };
+
+  template<class Container>
+  struct container_hook {
+    typedef boost::intrusive::member_hook<Container, policy_hook_type, &Container::policy_hook_>
+      type;
+  };
+
+  template<class Base, class Container, class Hook>
+  struct policy {
+    typedef typename boost::intrusive::list<Container, Hook> policy_container;
+
+    struct bucket : public boost::intrusive::list_base_hook<> {
+      uint64_t frequency;
+      size_t count;
+      typename policy_container::iterator head;
+    };
+
+    typedef boost::intrusive::list<bucket> bucket_container;
+
+    static bucket*
+    get_bucket(typename Container::iterator item)
+    {
+      return static_cast<bucket*>(
+        static_cast<policy_hook_type*>(policy_container::value_traits::to_node_ptr(*item))->bucket);
+    }
+
+    static const bucket*
+    get_bucket(typename Container::const_iterator item)
+    {
+      return static_cast<const bucket*>(
+        static_cast<const policy_hook_type*>(policy_container::value_traits::to_node_ptr(*item))
+          ->bucket);
+    }
+
+    static void
+    set_bucket(typename Container::iterator item, bucket* b)
+    {
+      static_cast<policy_hook_type*>(policy_container::value_traits::to_node_ptr(*item))
+        ->bucket = b;
+    }
+
+    static uint64_t
+    get_frequency(typename Container::const_iterator item)
+    {
+      return get_bucket(item)->frequency;
+    }
+
+    class type : public policy_container {
+    public:
+      typedef policy policy_base; // to get access to get_frequency from outside
+      typedef Container parent_trie;
+
+      type(Base& base)
+        : base_(base)
+        , max_size_(100)
+      {
+      }
+
+      ~type()
+      {
+        buckets_.clear_and_dispose(bucket_disposer());
+        spare_.clear_and_dispose(bucket_disposer());
+      }
+
+      inline void
+      update(typename parent_trie::iterator item)
+      {
+        increment(item);
+      }
+
+      inline bool
+      insert(typename parent_trie::iterator item)
+      {
+        if (max_size_ != 0 && policy_container::size() >= max_size_) {
+          // this erases the "least frequently used item" from cache
+          base_.erase(&(*policy_container::begin()));
+        }
+
+        if (!buckets_.empty() && buckets_.front().frequency == 0) {
+          bucket& first = buckets_.front();
+          policy_container::insert(end_of(first), *item);
+          ++first.count;
+          set_bucket(item, &first);
+        }
+        else {
+          typename policy_container::iterator position =
+            policy_container::insert(buckets_.empty() ? policy_container::end()
+                                                      : buckets_.front().head,
+                                     *item);
+          bucket* first = allocate(0, position);
+          buckets_.push_front(*first);
+          set_bucket(item, first);
+        }
+        return true;
+      }
+
+      inline void
+      lookup(typename parent_trie::iterator item)
+      {
+        increment(item);
+      }
+
+      inline void
+      erase(typename parent_trie::iterator item)
+      {
+        detach(item);
+        policy_container::erase(policy_container::s_iterator_to(*item));
+      }
+
+      inline void
+      clear()
+      {
+        policy_container::clear();
+        while (!buckets_.empty()) {
+          bucket& b = buckets_.front();
+          buckets_.pop_front();
+          spare_.push_front(b);
+        }
+      }
+
+      inline void
+      set_max_size(size_t max_size)
+      {
+        max_size_ = max_size;
+      }
+
+      inline size_t
+      get_max_size() const
+      {
+        return max_size_;
+      }
+
+    private:
+      type()
+        : base_(*((Base*)0)){};
+
+      struct bucket_disposer {
+        void
+        operator()(bucket* b) const
+        {
+          delete b;
+        }
+      };
+
+      /**
+       * @brief Move item to the end of the run with the next higher frequency
+       */
+      void
+      increment(typename parent_trie::iterator item)
+      {
+        bucket* current = get_bucket(item);
+        uint64_t frequency = current->frequency + 1;
+
+        typename bucket_container::iterator next = buckets_.iterator_to(*current);
+        ++next;
+
+        if (next == buckets_.end() || next->frequency != frequency) {
+          if (current->count == 1) {
+            // the run consists of this item only and no run with the next frequency exists
+            current->frequency = frequency;
+            return;
+          }
+
+          // item becomes the only member of a new run placed right after the current one
+          typename policy_container::iterator position = end_of(*current);
+          detach(item);
+          policy_container::splice(position, *this, policy_container::s_iterator_to(*item));
+
+          bucket* created = allocate(frequency, policy_container::s_iterator_to(*item));
+          buckets_.insert(next, *created);
+          set_bucket(item, created);
+        }
+        else {
+          detach(item);
+          policy_container::splice(end_of(*next), *this, policy_container::s_iterator_to(*item));
+          ++next->count;
+          set_bucket(item, &*next);
+        }
+      }
+
+      /**
+       * @brief Remove item from its run, releasing the bucket if the run becomes empty
+       *
+       * The item itself stays linked in the policy container.
+       */
+      void
+      detach(typename parent_trie::iterator item)
+      {
+        bucket* b = get_bucket(item);
+        if (--b->count == 0) {
+          buckets_.erase(buckets_.iterator_to(*b));
+          spare_.push_front(*b);
+        }
+        else if (&*b->head == &*item) {
+          ++b->head;
+        }
+      }
+
+      /**
+       * @brief Position right after the last item of the run
+       */
+      typename policy_container::iterator
+      end_of(bucket& b)
+      {
+        typename bucket_container::iterator next = buckets_.iterator_to(b);
+        ++next;
+        return next == buckets_.end() ? policy_container::end() : next->head;
+      }
+
+      bucket*
+      allocate(uint64_t frequency, typename policy_container::iterator head)
+      {
+        bucket* b;
+        if (!spare_.empty()) {
+          b = &spare_.front();
+          spare_.pop_front();
+        }
+        else {
+          b = new bucket;
+        }
+        b->frequency = frequency;
+        b->count = 1;
+        b->head = head;
+        return b;
+      }
+
+    private:
+      Base& base_;
+      size_t max_size_;
+
+      bucket_container buckets_;
+      bucket_container spare_; ///< @brief released buckets kept for reuse
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // BUCKET_LFU_POLICY_H
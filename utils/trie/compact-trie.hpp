@@ -0,0 +1,1048 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef COMPACT_TRIE_H_
+#define COMPACT_TRIE_H_
+
+/// @cond include_hidden
+
+#include "trie.hpp"
+
+#include <boost/functional/hash.hpp>
+#include <boost/mpl/if.hpp>
+
+#include <cstring>
+#include <algorithm>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+template<class T, class NonConstT>
+class compact_trie_iterator;
+
+template<class T>
+class compact_trie_point_iterator;
+
+/**
+ * @brief Memory-compact drop-in replacement for trie
+ *
+ * Differences from trie:
+ * - nodes are carved from fixed-size chunks owned by the root node and recycled through a free
+ *   list, instead of being allocated one by one with new;
+ * - every distinct name component is stored once and referenced by all nodes that use it,
+ *   instead of each node keeping its own name::Component copy (which also kept the whole wire
+ *   of the packet the component was taken from alive); wire encodings of the components share
+ *   pages owned by the root node;
+ * - up to INLINE_CHILDREN children are stored in the node itself; larger child tables are
+ *   plain arrays, which get an open addressing hash index only when there are more than
+ *   INDEXED_CHILDREN children.
+ *
+ * The root node (the one created with the constructor) owns all storage of the trie.  bucketSize
+ * and bucketIncrement constructor parameters are accepted for compatibility with trie and
+ * ignored.  Enumeration order of children is not defined (as in trie), and it changes when a
+ * sibling is removed.
+ *
+ * trie_with_policy uses trie unless compact_trie is given explicitly as its Trie parameter, as
+ * ns3::ndn::cs::Compact::* content stores do; tests/other/ndn-trie-benchmark.cpp compares the two.
+ */
+template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+class compact_trie {
+public:
+  typedef typename FullKey::value_type Key;
+
+  typedef compact_trie* iterator;
+  typedef const compact_trie* const_iterator;
+
+  typedef compact_trie_iterator<compact_trie, compact_trie> recursive_iterator;
+  typedef compact_trie_iterator<const compact_trie, compact_trie> const_recursive_iterator;
+
+  typedef compact_trie_point_iterator<compact_trie> point_iterator;
+  typedef compact_trie_point_iterator<const compact_trie> const_point_iterator;
+
+  typedef PayloadTraits payload_traits;
+
+  static const uint32_t INLINE_CHILDREN = 4;
+  static const uint32_t INDEXED_CHILDREN = 8;
+
+  inline compact_trie(const Key& key, size_t bucketSize = 1, size_t bucketIncrement = 1)
+    : arena_(new arena)
+    , key_(nullptr)
+    , nChildren_(0)
+    , capacity_(INLINE_CHILDREN)
+    , position_(0)
+    , indexMask_(0)
+    , index_(nullptr)
+    , payload_(PayloadTraits::empty_payload)
+    , parent_(nullptr)
+  {
+  }
+
+  inline ~compact_trie()
+  {
+    payload_ = PayloadTraits::empty_payload; // necessary for smart pointers...
+    clear();
+
+    if (key_ != nullptr) {
+      arena_->release(key_);
+    }
+
+    if (parent_ == nullptr) {
+      delete arena_;
+    }
+  }
+
+  compact_trie(const compact_trie&) = delete;
+
+  compact_trie&
+  operator=(const compact_trie&) = delete;
+
+  void
+  clear()
+  {
+    for (uint32_t i = 0; i < nChildren_; ++i) {
+      destroy(children()[i]);
+    }
+    nChildren_ = 0;
+
+    if (capacity_ > INLINE_CHILDREN) {
+      delete[] heap_;
+      capacity_ = INLINE_CHILDREN;
+    }
+    delete[] index_;
+    index_ = nullptr;
+    indexMask_ = 0;
+  }
+
+  template<class Predicate>
+  void
+  clear_if(Predicate cond)
+  {
+    recursive_iterator trieNode(this);
+    recursive_iterator end(0);
+
+    while (trieNode != end) {
+      if (cond(*trieNode)) {
+        trieNode = recursive_iterator(trieNode->erase());
+      }
+      trieNode++;
+    }
+  }
+
+  inline std::pair<iterator, bool>
+  insert(const FullKey& key, typename PayloadTraits::insert_type payload)
+  {
+    compact_trie* trieNode = this;
+
+    BOOST_FOREACH (const Key& subkey, key) {
+      const Block& wire = subkey.wireEncode();
+      std::size_t hash = boost::hash_range(wire.wire(), wire.wire() + wire.size());
+
+      compact_trie* child = trieNode->find_child(hash, wire.wire(), wire.size());
+      if (child == nullptr) {
+        child = new (arena_->nodes.allocate()) compact_trie(trieNode, arena_->intern(hash, wire));
+        trieNode->add_child(child);
+      }
+      trieNode = child;
+    }
+
+    if (trieNode->payload_ == PayloadTraits::empty_payload) {
+      trieNode->payload_ = payload;
+      return std::make_pair(trieNode, true);
+    }
+    else
+      return std::make_pair(trieNode, false);
+  }
+
+  /**
+   * @brief Removes payload (if it exists) and if there are no children, prunes parents trie
+   */
+  inline iterator
+  erase()
+  {
+    payload_ = PayloadTraits::empty_payload;
+    return prune();
+  }
+
+  /**
+   * @brief Do exactly as erase, but without erasing the payload
+   */
+  inline iterator
+  prune()
+  {
+    compact_trie* trieNode = this;
+    while (trieNode->payload_ == PayloadTraits::empty_payload && trieNode->nChildren_ == 0
+           && trieNode->parent_ != nullptr) {
+      compact_trie* parent = trieNode->parent_;
+      parent->remove_child(trieNode);
+      destroy(trieNode);
+      trieNode = parent;
+    }
+    return trieNode;
+  }
+
+  /**
+   * @brief Perform prune of the node, but without attempting to parent of the node
+   */
+  inline void
+  prune_node()
+  {
+    if (payload_ == PayloadTraits::empty_payload && nChildren_ == 0 && parent_ != nullptr) {
+      parent_->remove_child(this);
+      destroy(this);
+    }
+  }
+
+  /**
+   * @brief Perform the longest prefix match
+   * @param key the key for which to perform the longest prefix match
+   *
+   * @return ->second is true if prefix in ->first is longer than key
+   */
+  inline std::tuple<iterator, bool, iterator>
+  find(const FullKey& key)
+  {
+    return find_if(key, [] (typename PayloadTraits::const_return_type) { return true; });
+  }
+
+  /**
+   * @brief Perform the longest prefix match satisfying preficate
+   * @param key the key for which to perform the longest prefix match
+   *
+   * @return ->second is true if prefix in ->first is longer than key
+   */
+  template<class Predicate>
+  inline std::tuple<iterator, bool, iterator>
+  find_if(const FullKey& key, Predicate pred)
+  {
+    compact_trie* trieNode = this;
+    iterator foundNode = (payload_ != PayloadTraits::empty_payload) ? this : 0;
+    bool reachLast = true;
+
+    BOOST_FOREACH (const Key& subkey, key) {
+      const Block& wire = subkey.wireEncode();
+      std::size_t hash = boost::hash_range(wire.wire(), wire.wire() + wire.size());
+
+      compact_trie* child = trieNode->find_child(hash, wire.wire(), wire.size());
+      if (child == nullptr) {
+        reachLast = false;
+        break;
+      }
+
+      trieNode = child;
+      if (trieNode->payload_ != PayloadTraits::empty_payload && pred(trieNode->payload_)) {
+        foundNode = trieNode;
+      }
+    }
+
+    return std::make_tuple(foundNode, reachLast, trieNode);
+  }
+
+  /**
+   * @brief Find next payload of the sub-trie
+   * @returns end() or a valid iterator pointing to the trie leaf (order is not defined)
+   */
+  inline iterator
+  find()
+  {
+    if (payload_ != PayloadTraits::empty_payload)
+      return this;
+
+    for (uint32_t i = 0; i < nChildren_; ++i) {
+      iterator value = children()[i]->find();
+      if (value != 0)
+        return value;
+    }
+
+    return 0;
+  }
+
+  /**
+   * @brief Find next payload of the sub-trie satisfying the predicate
+   * @param pred predicate
+   * @returns end() or a valid iterator pointing to the trie leaf (order is not defined)
+   */
+  template<class Predicate>
+  inline const iterator
+  find_if(Predicate pred)
+  {
+    if (payload_ != PayloadTraits::empty_payload && pred(payload_))
+      return this;
+
+    for (uint32_t i = 0; i < nChildren_; ++i) {
+      iterator value = children()[i]->find_if(pred);
+      if (value != 0)
+        return value;
+    }
+
+    return 0;
+  }
+
+  /**
+   * @brief Find next payload of the sub-trie satisfying the predicate
+   * @param pred predicate
+   *
+   * This version check predicate only for the next level children
+   *
+   * @returns end() or a valid iterator pointing to the trie leaf (order is not defined)
+   */
+  template<class Predicate>
+  inline const iterator
+  find_if_next_level(Predicate pred)
+  {
+    for (uint32_t i = 0; i < nChildren_; ++i) {
+      if (pred(children()[i]->key())) {
+        return children()[i]->find();
+      }
+    }
+
+    return 0;
+  }
+
+  iterator
+  end()
+  {
+    return 0;
+  }
+
+  const_iterator
+  end() const
+  {
+    return 0;
+  }
+
+  typename PayloadTraits::const_return_type
+  payload() const
+  {
+    return payload_;
+  }
+
+  typename PayloadTraits::return_type
+  payload()
+  {
+    return payload_;
+  }
+
+  void
+  set_payload(typename PayloadTraits::insert_type payload)
+  {
+    payload_ = payload;
+  }
+
+  /**
+   * @brief Name component of the node (the interned copy, root has an empty key)
+   */
+  const Key&
+  key() const
+  {
+    static const Key rootKey;
+    return key_ != nullptr ? key_->component : rootKey;
+  }
+
+  inline void
+  PrintStat(std::ostream& os) const;
+
+  template<class F, class P, class H>
+  friend std::ostream&
+  operator<<(std::ostream& os, const compact_trie<F, P, H>& trie_node);
+
+public:
+  PolicyHook policy_hook_;
+
+private:
+  /**
+   * @brief Distinct name component used by nodes of the trie
+   *
+   * The component is kept decoded, so that key() and predicates of find_if_next_level can use
+   * it without copying.  Its wire encoding normally lives in a page shared with other
+   * components of the same trie.
+   */
+  struct interned_key {
+    interned_key(const Key& component, std::size_t hash, uint32_t page)
+      : component(component)
+      , hash(hash)
+      , refs(1)
+      , page(page)
+    {
+    }
+
+    bool
+    matches(std::size_t hash, const uint8_t* wire, size_t size) const
+    {
+      const Block& block = component.wireEncode();
+      return this->hash == hash && block.size() == size
+             && std::memcmp(block.wire(), wire, size) == 0;
+    }
+
+    Key component;
+    std::size_t hash;
+    uint32_t refs; ///< @brief number of nodes using the component
+    uint32_t page; ///< @brief page holding the wire encoding, NO_PAGE if it has its own buffer
+  };
+
+  /**
+   * @brief Fixed-size objects carved from chunks and recycled through a free list
+   */
+  class chunk_pool {
+  public:
+    explicit chunk_pool(size_t objectSize)
+      : objectSize_(std::max(objectSize, sizeof(free_object)))
+      , free_(nullptr)
+    {
+    }
+
+    ~chunk_pool()
+    {
+      for (char* chunk : chunks_) {
+        ::operator delete(chunk);
+      }
+    }
+
+    void*
+    allocate()
+    {
+      if (free_ == nullptr) {
+        char* chunk = static_cast<char*>(::operator new(CHUNK_SIZE * objectSize_));
+        chunks_.push_back(chunk);
+        for (size_t i = CHUNK_SIZE; i > 0; --i) {
+          deallocate(chunk + (i - 1) * objectSize_);
+        }
+      }
+
+      free_object* object = free_;
+      free_ = object->next;
+      return object;
+    }
+
+    void
+    deallocate(void* object)
+    {
+      free_object* freed = static_cast<free_object*>(object);
+      freed->next = free_;
+      free_ = freed;
+    }
+
+  private:
+    struct free_object {
+      free_object* next;
+    };
+
+    static const size_t CHUNK_SIZE = 256; ///< @brief number of objects allocated at once
+
+    size_t objectSize_;
+    free_object* free_;
+    std::vector<char*> chunks_;
+  };
+
+  /**
+   * @brief Node storage and component table shared by all nodes of one trie
+   *
+   * Components are indexed by an open addressing hash table.  Their wire encodings are
+   * appended to pages of KEY_PAGE_SIZE bytes; a page is released once none of its components is
+   * used (Key copies handed out by key() keep it alive until they are destroyed).
+   */
+  class arena {
+  public:
+    arena()
+      : nodes(sizeof(compact_trie))
+      , keys_(sizeof(interned_key))
+      , index_(MIN_INDEX_SIZE, nullptr)
+      , nKeys_(0)
+      , current_(NO_PAGE)
+    {
+    }
+
+    /**
+     * @brief Get the interned copy of the component, adding a reference to it
+     */
+    interned_key*
+    intern(std::size_t hash, const Block& wire)
+    {
+      size_t mask = index_.size() - 1;
+      size_t slot = hash & mask;
+      for (; index_[slot] != nullptr; slot = (slot + 1) & mask) {
+        if (index_[slot]->matches(hash, wire.wire(), wire.size())) {
+          ++index_[slot]->refs;
+          return index_[slot];
+        }
+      }
+
+      uint32_t page = NO_PAGE;
+      Key component = copy(wire, page);
+      interned_key* key = new (keys_.allocate()) interned_key(component, hash, page);
+      index_[slot] = key;
+
+      if (++nKeys_ * 2 > index_.size()) {
+        rehash(index_.size() * 2);
+      }
+      return key;
+    }
+
+    /**
+     * @brief Remove a reference to the interned component, destroying it with the last one
+     */
+    void
+    release(interned_key* key)
+    {
+      if (--key->refs > 0)
+        return;
+
+      size_t mask = index_.size() - 1;
+      size_t slot = key->hash & mask;
+      while (index_[slot] != key) {
+        slot = (slot + 1) & mask;
+      }
+      erase_slot(slot);
+      --nKeys_;
+
+      uint32_t page = key->page;
+      key->~interned_key();
+      keys_.deallocate(key);
+
+      if (page != NO_PAGE && --pages_[page].nKeys == 0 && page != current_) {
+        pages_[page].buffer.reset();
+        freePages_.push_back(page);
+      }
+    }
+
+  public:
+    chunk_pool nodes;
+
+  private:
+    struct page_info {
+      shared_ptr< ::ndn::Buffer> buffer;
+      size_t nKeys;
+    };
+
+    Key
+    copy(const Block& wire, uint32_t& page)
+    {
+      if (wire.size() > KEY_PAGE_SIZE / 4) {
+        return Key(Block(wire.wire(), wire.size()));
+      }
+
+      if (current_ == NO_PAGE
+          || pages_[current_].buffer->capacity() - pages_[current_].buffer->size() < wire.size()) {
+        open_page();
+      }
+
+      ::ndn::Buffer& buffer = *pages_[current_].buffer;
+      size_t offset = buffer.size();
+      // capacity is reserved, so the page is never reallocated under existing components
+      buffer.insert(buffer.end(), wire.wire(), wire.wire() + wire.size());
+      ++pages_[current_].nKeys;
+      page = current_;
+
+      ::ndn::Buffer::const_iterator begin = buffer.begin() + offset;
+      return Key(Block(pages_[current_].buffer, begin, begin + wire.size()));
+    }
+
+    void
+    open_page()
+    {
+      if (current_ != NO_PAGE && pages_[current_].nKeys == 0) {
+        pages_[current_].buffer.reset();
+        freePages_.push_back(current_);
+      }
+
+      if (freePages_.empty()) {
+        freePages_.push_back(pages_.size());
+        pages_.push_back(page_info());
+      }
+      current_ = freePages_.back();
+      freePages_.pop_back();
+
+      pages_[current_].buffer = make_shared< ::ndn::Buffer>();
+      pages_[current_].buffer->reserve(KEY_PAGE_SIZE);
+      pages_[current_].nKeys = 0;
+    }
+
+    void
+    rehash(size_t nSlots)
+    {
+      std::vector<interned_key*> old(nSlots, nullptr);
+      old.swap(index_);
+
+      size_t mask = nSlots - 1;
+      for (interned_key* key : old) {
+        if (key == nullptr)
+          continue;
+        size_t slot = key->hash & mask;
+        while (index_[slot] != nullptr) {
+          slot = (slot + 1) & mask;
+        }
+        index_[slot] = key;
+      }
+    }
+
+    /**
+     * @brief Remove slot from the index, shifting back later entries of the probe sequence
+     */
+    void
+    erase_slot(size_t slot)
+    {
+      size_t mask = index_.size() - 1;
+      index_[slot] = nullptr;
+      for (size_t next = (slot + 1) & mask; index_[next] != nullptr; next = (next + 1) & mask) {
+        size_t home = index_[next]->hash & mask;
+        bool stays = slot <= next ? (slot < home && home <= next) : (slot < home || home <= next);
+        if (!stays) {
+          index_[slot] = index_[next];
+          index_[next] = nullptr;
+          slot = next;
+        }
+      }
+    }
+
+  private:
+    static const size_t KEY_PAGE_SIZE = 4096;
+    static const size_t MIN_INDEX_SIZE = 64;
+
+    chunk_pool keys_;
+    std::vector<interned_key*> index_;
+    size_t nKeys_;
+
+    std::vector<page_info> pages_;
+    std::vector<uint32_t> freePages_;
+    uint32_t current_; ///< @brief page new components are appended to
+  };
+
+  compact_trie(compact_trie* parent, interned_key* key)
+    : arena_(parent->arena_)
+    , key_(key)
+    , nChildren_(0)
+    , capacity_(INLINE_CHILDREN)
+    , position_(0)
+    , indexMask_(0)
+    , index_(nullptr)
+    , payload_(PayloadTraits::empty_payload)
+    , parent_(parent)
+  {
+  }
+
+  static void
+  destroy(compact_trie* node)
+  {
+    arena* storage = node->arena_;
+    node->~compact_trie();
+    storage->nodes.deallocate(node);
+  }
+
+  bool
+  matches(std::size_t hash, const uint8_t* wire, size_t size) const
+  {
+    return key_->matches(hash, wire, size);
+  }
+
+  compact_trie**
+  children()
+  {
+    return capacity_ > INLINE_CHILDREN ? heap_ : inline_;
+  }
+
+  compact_trie* const*
+  children() const
+  {
+    return capacity_ > INLINE_CHILDREN ? heap_ : inline_;
+  }
+
+  compact_trie*
+  find_child(std::size_t hash, const uint8_t* wire, size_t size)
+  {
+    compact_trie** table = children();
+    if (index_ == nullptr) {
+      for (uint32_t i = 0; i < nChildren_; ++i) {
+        if (table[i]->matches(hash, wire, size))
+          return table[i];
+      }
+      return nullptr;
+    }
+
+    for (uint32_t slot = hash & indexMask_; index_[slot] != NO_CHILD;
+         slot = (slot + 1) & indexMask_) {
+      if (table[index_[slot]]->matches(hash, wire, size))
+        return table[index_[slot]];
+    }
+    return nullptr;
+  }
+
+  void
+  add_child(compact_trie* child)
+  {
+    if (nChildren_ == capacity_) {
+      compact_trie** grown = new compact_trie*[capacity_ * 2];
+      std::copy(children(), children() + nChildren_, grown);
+      if (capacity_ > INLINE_CHILDREN) {
+        delete[] heap_;
+      }
+      heap_ = grown;
+      capacity_ *= 2;
+    }
+
+    child->position_ = nChildren_;
+    children()[nChildren_++] = child;
+
+    if (index_ != nullptr || nChildren_ > INDEXED_CHILDREN) {
+      if (index_ == nullptr || nChildren_ * 2 > indexMask_ + 1) {
+        rebuild_index();
+      }
+      else {
+        index_insert(child->position_);
+      }
+    }
+  }
+
+  void
+  remove_child(compact_trie* child)
+  {
+    compact_trie** table = children();
+    uint32_t position = child->position_;
+    uint32_t last = nChildren_ - 1;
+
+    if (index_ != nullptr) {
+      index_erase(index_find(position));
+      if (position != last) {
+        index_[index_find(last)] = position;
+      }
+    }
+
+    if (position != last) {
+      table[position] = table[last];
+      table[position]->position_ = position;
+    }
+    --nChildren_;
+
+    if (index_ != nullptr && nChildren_ <= INDEXED_CHILDREN / 2) {
+      delete[] index_;
+      index_ = nullptr;
+      indexMask_ = 0;
+    }
+
+    if (capacity_ > INLINE_CHILDREN && nChildren_ <= INLINE_CHILDREN) {
+      compact_trie** heap = heap_;
+      std::copy(heap, heap + nChildren_, inline_);
+      delete[] heap;
+      capacity_ = INLINE_CHILDREN;
+    }
+  }
+
+  void
+  rebuild_index()
+  {
+    uint32_t nSlots = 1;
+    while (nSlots < nChildren_ * 4) {
+      nSlots *= 2;
+    }
+
+    delete[] index_;
+    index_ = new uint32_t[nSlots];
+    indexMask_ = nSlots - 1;
+    std::fill(index_, index_ + nSlots, static_cast<uint32_t>(NO_CHILD));
+
+    for (uint32_t i = 0; i < nChildren_; ++i) {
+      index_insert(i);
+    }
+  }
+
+  void
+  index_insert(uint32_t position)
+  {
+    uint32_t slot = children()[position]->key_->hash & indexMask_;
+    while (index_[slot] != NO_CHILD) {
+      slot = (slot + 1) & indexMask_;
+    }
+    index_[slot] = position;
+  }
+
+  uint32_t
+  index_find(uint32_t position) const
+  {
+    uint32_t slot = children()[position]->key_->hash & indexMask_;
+    while (index_[slot] != position) {
+      slot = (slot + 1) & indexMask_;
+    }
+    return slot;
+  }
+
+  /**
+   * @brief Remove slot from the index, shifting back later entries of the probe sequence
+   */
+  void
+  index_erase(uint32_t slot)
+  {
+    index_[slot] = NO_CHILD;
+    for (uint32_t next = (slot + 1) & indexMask_; index_[next] != NO_CHILD;
+         next = (next + 1) & indexMask_) {
+      uint32_t home = children()[index_[next]]->key_->hash & indexMask_;
+      bool stays = slot <= next ? (slot < home && home <= next) : (slot < home || home <= next);
+      if (!stays) {
+        index_[slot] = index_[next];
+        index_[next] = NO_CHILD;
+        slot = next;
+      }
+    }
+  }
+
+private:
+  static const uint32_t NO_CHILD = ~0U;
+  static const uint32_t NO_PAGE = ~0U;
+
+  template<class T, class NonConstT>
+  friend class compact_trie_iterator;
+
+  template<class T>
+  friend class compact_trie_point_iterator;
+
+  ////////////////////////////////////////////////
+  // Actual data
+  ////////////////////////////////////////////////
+
+  arena* arena_; ///< @brief owned by the root node
+  interned_key* key_; ///< @brief name component, nullptr for the root node
+
+  uint32_t nChildren_;
+  uint32_t capacity_;
+  uint32_t position_; ///< @brief position of the node in the parent's children table
+  uint32_t indexMask_;
+  uint32_t* index_; ///< @brief hash index of children, only for nodes with many children
+  union {
+    compact_trie* inline_[INLINE_CHILDREN];
+    compact_trie** heap_;
+  };
+
+  typename PayloadTraits::storage_type payload_;
+  compact_trie* parent_; // to make cleaning effective
+};
+
+template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+inline std::ostream&
+operator<<(std::ostream& os, const compact_trie<FullKey, PayloadTraits, PolicyHook>& trie_node)
+{
+  os << "# " << trie_node.key() << ((trie_node.payload_ != PayloadTraits::empty_payload) ? "*" : "")
+     << std::endl;
+
+  for (uint32_t i = 0; i < trie_node.nChildren_; ++i) {
+    const compact_trie<FullKey, PayloadTraits, PolicyHook>& subnode = *trie_node.children()[i];
+
+    os << "\"" << &trie_node << "\""
+       << " [label=\"" << trie_node.key()
+       << ((trie_node.payload_ != PayloadTraits::empty_payload) ? "*" : "") << "\"]\n";
+    os << "\"" << &subnode << "\""
+       << " [label=\"" << subnode.key()
+       << ((subnode.payload_ != PayloadTraits::empty_payload) ? "*" : "") << "\"]\n";
+
+    os << "\"" << &trie_node << "\""
+       << " -> "
+       << "\"" << &subnode << "\""
+       << "\n";
+    os << subnode;
+  }
+
+  return os;
+}
+
+template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+inline void
+compact_trie<FullKey, PayloadTraits, PolicyHook>::PrintStat(std::ostream& os) const
+{
+  os << "# " << key() << ((payload_ != PayloadTraits::empty_payload) ? "*" : "") << ": "
+     << nChildren_ << " children";
+  if (index_ != nullptr) {
+    os << ", " << (indexMask_ + 1) << " index slots";
+  }
+  os << std::endl;
+
+  for (uint32_t i = 0; i < nChildren_; ++i) {
+    children()[i]->PrintStat(os);
+  }
+}
+
+template<class Trie, class NonConstTrie>
+class compact_trie_iterator {
+public:
+  compact_trie_iterator()
+    : trie_(0)
+  {
+  }
+  compact_trie_iterator(typename Trie::iterator item)
+    : trie_(item)
+  {
+  }
+  compact_trie_iterator(Trie& item)
+    : trie_(&item)
+  {
+  }
+
+  Trie& operator*()
+  {
+    return *trie_;
+  }
+  const Trie& operator*() const
+  {
+    return *trie_;
+  }
+  Trie* operator->()
+  {
+    return trie_;
+  }
+  const Trie* operator->() const
+  {
+    return trie_;
+  }
+  bool
+  operator==(compact_trie_iterator<const Trie, NonConstTrie>& other) const
+  {
+    return (trie_ == other.trie_);
+  }
+  bool
+  operator==(compact_trie_iterator<Trie, NonConstTrie>& other)
+  {
+    return (trie_ == other.trie_);
+  }
+  bool
+  operator!=(compact_trie_iterator<const Trie, NonConstTrie>& other) const
+  {
+    return !(*this == other);
+  }
+  bool
+  operator!=(compact_trie_iterator<Trie, NonConstTrie>& other)
+  {
+    return !(*this == other);
+  }
+
+  compact_trie_iterator<Trie, NonConstTrie>&
+  operator++(int)
+  {
+    if (trie_->nChildren_ > 0)
+      trie_ = trie_->children()[0];
+    else
+      trie_ = goUp();
+    return *this;
+  }
+
+  compact_trie_iterator<Trie, NonConstTrie>&
+  operator++()
+  {
+    (*this)++;
+    return *this;
+  }
+
+private:
+  Trie*
+  goUp()
+  {
+    while (trie_->parent_ != 0) {
+      uint32_t next = trie_->position_ + 1;
+      if (next < trie_->parent_->nChildren_) {
+        return trie_->parent_->children()[next];
+      }
+      trie_ = trie_->parent_;
+    }
+    return 0;
+  }
+
+private:
+  Trie* trie_;
+};
+
+template<class Trie>
+class compact_trie_point_iterator {
+public:
+  compact_trie_point_iterator()
+    : trie_(0)
+  {
+  }
+  compact_trie_point_iterator(typename Trie::iterator item)
+    : trie_(item)
+  {
+  }
+  compact_trie_point_iterator(Trie& item)
+  {
+    if (item.nChildren_ != 0)
+      trie_ = item.children()[0];
+    else
+      trie_ = 0;
+  }
+
+  Trie& operator*()
+  {
+    return *trie_;
+  }
+  const Trie& operator*() const
+  {
+    return *trie_;
+  }
+  Trie* operator->()
+  {
+    return trie_;
+  }
+  const Trie* operator->() const
+  {
+    return trie_;
+  }
+  bool
+  operator==(compact_trie_point_iterator<const Trie>& other) const
+  {
+    return (trie_ == other.trie_);
+  }
+  bool
+  operator==(compact_trie_point_iterator<Trie>& other)
+  {
+    return (trie_ == other.trie_);
+  }
+  bool
+  operator!=(compact_trie_point_iterator<const Trie>& other) const
+  {
+    return !(*this == other);
+  }
+  bool
+  operator!=(compact_trie_point_iterator<Trie>& other)
+  {
+    return !(*this == other);
+  }
+
+  compact_trie_point_iterator<Trie>&
+  operator++(int)
+  {
+    if (trie_->parent_ != 0 && trie_->position_ + 1 < trie_->parent_->nChildren_)
+      trie_ = trie_->parent_->children()[trie_->position_ + 1];
+    else
+      trie_ = 0;
+    return *this;
+  }
+
+  compact_trie_point_iterator<Trie>&
+  operator++()
+  {
+    (*this)++;
+    return *this;
+  }
+
+private:
+  Trie* trie_;
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // COMPACT_TRIE_H_
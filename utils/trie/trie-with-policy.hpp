@@ -23,21 +23,28 @@
 /// @cond include_hidden
 
 #include "trie.hpp"
+#include "compact-trie.hpp"
 
 namespace ns3 {
 namespace ndn {
 namespace ndnSIM {
 
-template<typename FullKey, typename PayloadTraits, typename PolicyTraits>
+/**
+ * @brief Trie combined with a replacement policy
+ *
+ * Trie selects the node implementation: the original trie (default) or compact_trie.
+ */
+template<typename FullKey, typename PayloadTraits, typename PolicyTraits,
+         template<typename, typename, typename> class Trie = trie>
 class trie_with_policy {
 public:
-  typedef trie<FullKey, PayloadTraits, typename PolicyTraits::policy_hook_type> parent_trie;
+  typedef Trie<FullKey, PayloadTraits, typename PolicyTraits::policy_hook_type> parent_trie;
 
   typedef typename parent_trie::iterator iterator;
   typedef typename parent_trie::const_iterator const_iterator;
 
   typedef typename PolicyTraits::
-    template policy<trie_with_policy<FullKey, PayloadTraits, PolicyTraits>, parent_trie,
+    template policy<trie_with_policy<FullKey, PayloadTraits, PolicyTraits, Trie>, parent_trie,
                     typename PolicyTraits::template container_hook<parent_trie>::type>::type
       policy_container;
 